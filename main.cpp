@@ -7,6 +7,7 @@
 #include "queue.h"
 #include "semphr.h"
 #include "hardware/gpio.h"
+#include "hardware/irq.h"
 #include "isr_handlers.h"
 #include "services/ui_view_service.h"
 #include "services/electronics_cooling_service.h"
@@ -16,6 +17,10 @@
 #include "services/interaction_service.h"
 #include "services/calibration_service.h"
 #include "services/buzzer_service.h"
+#include "services/reflow_engine.h"
+#include "services/diagnostics_service.h"
+#include "services/telemetry_service.h"
+#include "services/run_recorder_service.h"
 #include "controllers/main_menu_controller.h"
 #include "controllers/reflow_controller.h"
 #include "controllers/calibration_controller.h"
@@ -41,10 +46,6 @@ TaskHandle_t watchdogTaskHandle = NULL;
 
 extern "C"
 {
-    extern "C" void vApplicationIdleHook(void) {
-        printf("Free heap: %u bytes\n", xPortGetFreeHeapSize());
-    }
-
     void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
     {
         printf("Stack Overflow in Task: %s\n", pcTaskName);
@@ -79,10 +80,16 @@ void uiTask(void* params) {
     printf("UI Task started on core %d\n", get_core_num());
     gpio_set_irq_callback(&sharedISR);
     irq_set_enabled(IO_IRQ_BANK0, true);
+
+    // DMA completion IRQs for UI-side peripherals are serviced on this core
+    irq_add_shared_handler(DMA_IRQ_1, &sharedDma1ISR, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
     // Initialize UI-related services
     UIViewService::getInstance().init();
     InteractionService::getInstance().init();
     BuzzerService::getInstance().init();
+    DiagnosticsService::getInstance().init();
+    TelemetryService::getInstance().init();
     
     // UI services are initialized and running in their own tasks
     // No need to do anything else in this task
@@ -94,6 +101,10 @@ void uiTask(void* params) {
 // Control task - will run on core 1
 void controlTask(void* params) {
     printf("Control Task started on core %d\n", get_core_num());
+
+    // DMA completion IRQs for control-side peripherals are serviced on this core
+    irq_add_shared_handler(DMA_IRQ_0, &sharedDma0ISR, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
     
     // Initialize hardware control services
     DoorService::getInstance().init();
@@ -101,6 +112,8 @@ void controlTask(void* params) {
     CalibrationService::getInstance().init();
     ElectronicsCoolingService::getInstance().init();
     TemperatureControlService::getInstance().init();
+    ReflowEngine::getInstance().init();
+    RunRecorderService::getInstance().init();
     
     // Main control loop
     while (true) {
@@ -0,0 +1,180 @@
+// Replays every built-in reflow curve through the firmware control code on
+// each plant preset, with and without model feed-forward, and reports
+// tracking error, overshoot, time above liquidus and total cycle time.
+// Runs on simulated time, so the whole matrix takes a fraction of a second.
+//
+//   oven_benchmark [--gate] [--plant=<preset>] [--max-rms=<°C>] [--max-overshoot=<°C>]
+//                  [--calibration-gain=<g>] [--control-jitter-ms=<ms>]
+//
+// --gate holds every feed-forward run to its curve's entry in CURVE_LIMITS
+// (tracking, peak, time above liquidus and cycle time) and exits non-zero on
+// any miss, so it can gate control or scheduling changes. The limits are what
+// an oven able to follow the curve should reach; the slower presets cannot, so
+// the gate is run with --plant=benchtop-toaster and the rest are for comparison.
+// --max-rms and --max-overshoot add flat limits on top. --control-jitter-ms
+// delays each control tick by up to that much, as a busy scheduler would; the
+// resulting tick timing is reported from the firmware's loop tracer.
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "oven_simulation.h"
+#include "profile_metrics.h"
+#include "library/reflow_curve_library.h"
+#include "library/profile_table.h"
+
+static const uint32_t COOLDOWN_TAIL_MS = 600000;  // Up to 10 minutes to get back down
+
+// Acceptance window for one built-in curve. Peaks are a little under the curve's
+// own peak because its reflow spike turns straight into cool-down.
+struct CurveLimits {
+    const char* curveName;
+    float maxRms;       // °C
+    float minPeak;      // °C
+    float maxPeak;      // °C
+    float minTalS;      // Time above liquidus
+    float maxTalS;
+    float maxCycleS;    // Start until cooled, see ProfileMetrics::cycleTimeS
+};
+
+static const CurveLimits CURVE_LIMITS[] = {
+    // curve                rms   peak           TAL          cycle
+    {"Lead-Free (SAC305)",  7.0f, 232.0f, 250.0f, 12.0f, 45.0f, 330.0f},
+    {"Leaded (Sn63Pb37)",   7.0f, 207.0f, 222.0f, 18.0f, 60.0f, 330.0f},
+    {"Custom Profile",     13.0f, 222.0f, 238.0f, 12.0f, 45.0f, 270.0f},
+};
+
+static const CurveLimits* findLimits(const char* curveName) {
+    for (const CurveLimits& limits : CURVE_LIMITS) {
+        if (strcmp(limits.curveName, curveName) == 0) return &limits;
+    }
+    return nullptr;
+}
+
+// Appends the name of each limit 'm' misses to 'reasons'; returns true if any
+static bool checkLimits(const CurveLimits& limits, const ProfileMetrics& m, char* reasons, size_t size) {
+    size_t used = strlen(reasons);
+    bool failed = false;
+    auto miss = [&](const char* what) {
+        used += snprintf(reasons + used, used < size ? size - used : 0, " %s", what);
+        if (used > size) used = size;
+        failed = true;
+    };
+    if (m.rmsError > limits.maxRms) miss("rms");
+    if (m.peakTemp < limits.minPeak || m.peakTemp > limits.maxPeak) miss("peak");
+    if (m.timeAboveLiquidusS < limits.minTalS || m.timeAboveLiquidusS > limits.maxTalS) miss("TAL");
+    if (!m.cycleComplete || m.cycleTimeS > limits.maxCycleS) miss("cycle");
+    return failed;
+}
+
+int main(int argc, char** argv) {
+    bool gate = false;
+    const PlantParameters* onlyPlant = nullptr;
+    float maxRms = 0.0f;
+    float maxOvershoot = 0.0f;
+    float calibrationGain = 1.0f;
+    uint32_t controlJitterMs = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--gate") == 0) {
+            gate = true;
+        } else if (strncmp(argv[i], "--plant=", 8) == 0) {
+            onlyPlant = PlantParameters::findPreset(argv[i] + 8);
+            if (!onlyPlant) {
+                fprintf(stderr, "unknown plant preset '%s'\n", argv[i] + 8);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--max-rms=", 10) == 0) {
+            maxRms = strtof(argv[i] + 10, nullptr);
+        } else if (strncmp(argv[i], "--max-overshoot=", 16) == 0) {
+            maxOvershoot = strtof(argv[i] + 16, nullptr);
+        } else if (strncmp(argv[i], "--calibration-gain=", 19) == 0) {
+            calibrationGain = strtof(argv[i] + 19, nullptr);
+        } else if (strncmp(argv[i], "--control-jitter-ms=", 20) == 0) {
+            controlJitterMs = static_cast<uint32_t>(strtoul(argv[i] + 20, nullptr, 10));
+        } else {
+            fprintf(stderr, "usage: oven_benchmark [--gate] [--plant=<preset>] [--max-rms=<C>] [--max-overshoot=<C>]"
+                            " [--calibration-gain=<g>] [--control-jitter-ms=<ms>]\n");
+            return 1;
+        }
+    }
+
+    printf("%-20s %-18s %-4s %8s %8s %9s %7s %9s %9s\n", "curve", "plant", "ff", "rms[C]", "max[C]",
+           "over[C]", "peak", "TAL[s]", "cycle[s]");
+
+    int failures = 0;
+    double simulatedSeconds = 0.0;
+    LoopTrace worstTrace = {};
+    auto wallStart = std::chrono::steady_clock::now();
+
+    for (const ReflowCurve& curve : ReflowCurveLibrary::getBuiltInCurves()) {
+        const CurveLimits* limits = findLimits(curve.name);
+        ProfileTable table;
+        table.build(curve, 0.0f);
+
+        for (size_t p = 0; p < PlantParameters::presetCount(); ++p) {
+            const PlantParameters& plant = PlantParameters::presets()[p];
+            if (onlyPlant && onlyPlant != &plant) continue;
+
+            for (int feedForward = 1; feedForward >= 0; --feedForward) {
+                SimulationConfig config = SimulationConfig::defaults(plant);
+                config.feedForward = feedForward != 0;
+                config.calibrationGain = calibrationGain;
+                config.controlJitterMs = controlJitterMs;
+
+                ProfileMetricsCollector collector(curve, table.getTotalDurationMs(), config.controlPeriodMs);
+                OvenSimulation simulation(config);
+                simulation.run(curve, [&collector](const SimulationSample& s) { collector.add(s); },
+                               COOLDOWN_TAIL_MS);
+                simulatedSeconds += (table.getTotalDurationMs() + COOLDOWN_TAIL_MS) / 1000.0;
+
+                const LoopTrace& trace = simulation.getControlTrace();
+                if (trace.lateness.maxUs >= worstTrace.lateness.maxUs) worstTrace = trace;
+
+                ProfileMetrics m = collector.result();
+                char reasons[48] = "";
+                bool failed = false;
+                if (feedForward) {
+                    if (maxRms > 0.0f && m.rmsError > maxRms) {
+                        strcat(reasons, " rms");
+                        failed = true;
+                    }
+                    if (maxOvershoot > 0.0f && m.overshoot > maxOvershoot) {
+                        strcat(reasons, " overshoot");
+                        failed = true;
+                    }
+                    if (gate && !limits) {
+                        strcat(reasons, " no-limits");
+                        failed = true;
+                    } else if (gate && checkLimits(*limits, m, reasons, sizeof(reasons))) {
+                        failed = true;
+                    }
+                }
+                failures += failed ? 1 : 0;
+
+                char cycle[16];
+                if (m.cycleComplete) {
+                    snprintf(cycle, sizeof(cycle), "%9.1f", m.cycleTimeS);
+                } else {
+                    snprintf(cycle, sizeof(cycle), "%9s", "-");
+                }
+                printf("%-20.20s %-18s %-4s %8.2f %8.2f %9.2f %7.1f %9.1f %s%s%s\n", curve.name, plant.name,
+                       feedForward ? "on" : "off", m.rmsError, m.maxError, m.overshoot, m.peakTemp,
+                       m.timeAboveLiquidusS, cycle, failed ? "  FAIL:" : "", reasons);
+            }
+        }
+    }
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    printf("\ncontrol ticks (worst run): late p99 <= %.1f ms, max %.1f ms, period %.1f..%.1f ms, %u deadline misses\n",
+           worstTrace.lateness.percentileUs(99.0f) / 1000.0, worstTrace.lateness.maxUs / 1000.0,
+           worstTrace.periodMinUs / 1000.0, worstTrace.periodMaxUs / 1000.0, worstTrace.deadlineMisses);
+    printf("%.0f s simulated in %.3f s (%.0fx real time)\n", simulatedSeconds, wallSeconds,
+           wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0);
+
+    if (failures) {
+        printf("%d run(s) over limits\n", failures);
+        return 1;
+    }
+    return 0;
+}
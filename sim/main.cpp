@@ -0,0 +1,69 @@
+// Host-side oven simulator. Replays a built-in reflow curve through the
+// firmware control code against a simulated plant and prints one CSV row per
+// control tick.
+//
+//   oven_sim [curve-index] [plant-preset] [--no-feedforward] [--calibration-gain=<g>]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "oven_simulation.h"
+#include "library/reflow_curve_library.h"
+
+static void usage() {
+    fprintf(stderr, "usage: oven_sim [curve-index] [plant-preset] [--no-feedforward] [--calibration-gain=<g>]\n");
+    fprintf(stderr, "curves:\n");
+    const auto& curves = ReflowCurveLibrary::getBuiltInCurves();
+    for (size_t i = 0; i < curves.size(); ++i) {
+        fprintf(stderr, "  %zu  %s\n", i, curves[i].name);
+    }
+    fprintf(stderr, "plants:\n");
+    for (size_t i = 0; i < PlantParameters::presetCount(); ++i) {
+        fprintf(stderr, "  %s\n", PlantParameters::presets()[i].name);
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto& curves = ReflowCurveLibrary::getBuiltInCurves();
+    size_t curveIndex = 0;
+    const PlantParameters* plant = &PlantParameters::presets()[0];
+    bool feedForward = true;
+    float calibrationGain = 1.0f;
+
+    int positional = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--no-feedforward") == 0) {
+            feedForward = false;
+        } else if (strncmp(argv[i], "--calibration-gain=", 19) == 0) {
+            calibrationGain = strtof(argv[i] + 19, nullptr);
+        } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            usage();
+            return 0;
+        } else if (positional == 0) {
+            curveIndex = strtoul(argv[i], nullptr, 10);
+            positional++;
+        } else if (positional == 1) {
+            plant = PlantParameters::findPreset(argv[i]);
+            positional++;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (curveIndex >= curves.size() || !plant) {
+        usage();
+        return 1;
+    }
+
+    SimulationConfig config = SimulationConfig::defaults(*plant);
+    config.feedForward = feedForward;
+    config.calibrationGain = calibrationGain;
+
+    printf("time_s,step,setpoint,oven,measured,heater,door\n");
+    OvenSimulation simulation(config);
+    bool ok = simulation.run(curves[curveIndex], [](const SimulationSample& s) {
+        printf("%.2f,%u,%.2f,%.2f,%.2f,%.0f,%.0f\n", s.timeMs / 1000.0f, s.stepIndex, s.setpoint, s.chamberTemp,
+               s.measuredTemp, s.heaterPower, s.doorPercent);
+    });
+    return ok ? 0 : 1;
+}
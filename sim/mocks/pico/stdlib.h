@@ -0,0 +1,27 @@
+#ifndef SIM_PICO_STDLIB_H
+#define SIM_PICO_STDLIB_H
+
+// Host stand-in for the parts of pico/stdlib.h the control code touches.
+// Time comes from the simulation clock, not the wall clock, so runs can go
+// as fast as the host allows.
+
+#include <cstdint>
+#include <cstddef>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+absolute_time_t get_absolute_time();
+uint32_t to_ms_since_boot(absolute_time_t t);
+uint32_t time_us_32();
+uint64_t time_us_64();
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+
+namespace sim {
+// Simulated microseconds since boot
+void setTimeUs(uint64_t us);
+void advanceTimeUs(uint64_t us);
+}
+
+#endif // SIM_PICO_STDLIB_H
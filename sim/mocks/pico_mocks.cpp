@@ -0,0 +1,37 @@
+#include "pico/stdlib.h"
+
+static uint64_t simTimeUs = 0;
+
+absolute_time_t get_absolute_time() {
+    return simTimeUs;
+}
+
+uint32_t to_ms_since_boot(absolute_time_t t) {
+    return static_cast<uint32_t>(t / 1000);
+}
+
+uint32_t time_us_32() {
+    return static_cast<uint32_t>(simTimeUs);
+}
+
+uint64_t time_us_64() {
+    return simTimeUs;
+}
+
+void sleep_ms(uint32_t ms) {
+    simTimeUs += static_cast<uint64_t>(ms) * 1000;
+}
+
+void sleep_us(uint64_t us) {
+    simTimeUs += us;
+}
+
+namespace sim {
+void setTimeUs(uint64_t us) {
+    simTimeUs = us;
+}
+
+void advanceTimeUs(uint64_t us) {
+    simTimeUs += us;
+}
+}
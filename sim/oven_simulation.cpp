@@ -0,0 +1,153 @@
+#include "oven_simulation.h"
+#include "pico/stdlib.h"
+#include "constants.h"
+#include <math.h>
+#include <memory>
+
+SimulationConfig SimulationConfig::defaults(const PlantParameters& plant) {
+    SimulationConfig config;
+    config.plant = plant;
+    config.startTemp = plant.ambientTemp;
+    config.feedForward = true;
+    config.calibrationGain = 1.0f;
+    config.controlPeriodMs = HEATER_CONTROL_PERIOD_MS;
+    config.controlJitterMs = 0;
+    config.ssrWindowMs = HEATER_SSR_WINDOW_MS;
+    config.ssrResolution = HEATER_SSR_RESOLUTION;
+    config.sensorRateHz = THERMOCOUPLE_SAMPLE_RATE_HZ;
+    config.plantStepMs = 5;
+    return config;
+}
+
+OvenSimulation::OvenSimulation(const SimulationConfig& config) : config(config), controlTrace{} {}
+
+// Small LCG so jittered runs are identical from one benchmark to the next
+static uint32_t nextJitterMs(uint32_t& seed, uint32_t maxMs) {
+    if (maxMs == 0) return 0;
+    seed = seed * 1664525u + 1013904223u;
+    return (seed >> 8) % (maxMs + 1);
+}
+
+namespace {
+
+// What the firmware's services do around the shared control code: the HAL
+// latches the commanded outputs for the SSR and servo models, and stopHeating()
+// clears the target as TemperatureControlService::stopHeating() does.
+struct SimulatedOven {
+    OvenControlLoop* loop;
+    uint32_t nowMs;
+    float targetTemp;
+    float targetRampRate;
+    float commandedPower;
+    float commandedDoor;
+
+    static void setHeaterPower(uint8_t percent, void* context) {
+        static_cast<SimulatedOven*>(context)->commandedPower = percent;
+    }
+
+    static void setDoorPosition(uint8_t percent, void* context) {
+        static_cast<SimulatedOven*>(context)->commandedDoor = percent;
+    }
+
+    static void setTarget(float temp, float rampRate, void* context) {
+        SimulatedOven* oven = static_cast<SimulatedOven*>(context);
+        oven->targetTemp = temp;
+        oven->targetRampRate = rampRate;
+    }
+
+    static void stopHeating(void* context) {
+        SimulatedOven* oven = static_cast<SimulatedOven*>(context);
+        oven->targetTemp = 0.0f;
+        oven->loop->stopHeating(oven->nowMs);
+    }
+};
+
+}
+
+bool OvenSimulation::run(const ReflowCurve& curve, const SampleCallback& onSample, uint32_t tailMs) {
+    ThermalPlant plant(config.plant, config.startTemp);
+    SimulatedOven oven = {nullptr, 0, 0.0f, 0.0f, 0.0f, 0.0f};
+    // The loop and the sequencer are what TemperatureControlService and ReflowEngine run
+    OvenControlLoop loop({SimulatedOven::setHeaterPower, SimulatedOven::setDoorPosition, &oven});
+    std::unique_ptr<ReflowSequencer> sequencer(
+        new ReflowSequencer({SimulatedOven::setTarget, SimulatedOven::stopHeating, &oven}));
+    oven.loop = &loop;
+    // TempHistory is large; keep it off the stack
+    std::unique_ptr<TempHistory> history(new TempHistory());
+
+    sim::setTimeUs(0);
+    if (config.feedForward) {
+        loop.getController().setCalibration(plant.synthesizeCalibration(config.calibrationGain));
+    }
+    if (!sequencer->start(curve, plant.readThermocouple(), 0)) return false;
+
+    const uint32_t sensorPeriodMs = 1000 / config.sensorRateHz;
+    const uint32_t endMs = sequencer->getTable().getTotalDurationMs() + tailMs;
+    const float stepSeconds = config.plantStepMs / 1000.0f;
+
+    uint32_t nextControlMs = 0;   // Release of the next control tick
+    uint32_t controlDueMs = 0;    // Release plus this tick's scheduling delay
+    uint32_t jitterSeed = 1;
+    LoopTracer tracer(config.controlPeriodMs * 1000);
+    uint32_t nextSensorMs = 0;
+    uint32_t windowStartMs = 0;
+    uint32_t windowOnSteps = 0;
+    float measured = plant.readThermocouple();
+    ReflowProgress progress = sequencer->makeProgress(ReflowRunState::RUNNING, 0);
+
+    for (uint32_t now = 0; now <= endMs; now += config.plantStepMs) {
+        sim::setTimeUs(static_cast<uint64_t>(now) * 1000);
+        oven.nowMs = now;
+
+        if (now >= nextSensorMs) {
+            measured = plant.readThermocouple();
+            history->push({measured, now});
+            nextSensorMs += sensorPeriodMs;
+        }
+
+        if (now >= controlDueMs) {
+            tracer.begin(static_cast<uint64_t>(now) * 1000);
+
+            // ReflowEngine tick
+            if (sequencer->isRunning()) {
+                progress = sequencer->update(now);
+            }
+
+            // TemperatureControlService tick
+            TempWindowStats derivative;
+            history->getStats(TempWindow::DERIVATIVE, derivative);
+            OvenControlLoop::Measurement measurement;
+            measurement.temperature = measured;
+            measurement.temperatureRate = derivative.slope;
+            measurement.hasRate = derivative.count > 1;
+            measurement.sensorFault = false;
+            loop.update(now, oven.targetTemp, oven.targetRampRate, measurement);
+
+            SimulationSample sample;
+            sample.timeMs = now;
+            sample.stepIndex = progress.stepIndex;
+            sample.setpoint = progress.setpoint;
+            sample.chamberTemp = plant.getChamberTemp();
+            sample.measuredTemp = measured;
+            sample.heaterPower = oven.commandedPower;
+            sample.doorPercent = plant.getDoorPercent();
+            onSample(sample);
+
+            tracer.end(static_cast<uint64_t>(now) * 1000);
+            nextControlMs += config.controlPeriodMs;
+            controlDueMs = nextControlMs + nextJitterMs(jitterSeed, config.controlJitterMs);
+        }
+
+        // SSR: power latched at the window boundary, on for the last N steps of the window
+        if (now >= windowStartMs + config.ssrWindowMs || now == 0) {
+            windowStartMs = now;
+            windowOnSteps = static_cast<uint32_t>(lroundf(oven.commandedPower * config.ssrResolution / 100.0f));
+        }
+        uint32_t stepInWindow = (now - windowStartMs) * config.ssrResolution / config.ssrWindowMs;
+        bool heaterOn = stepInWindow >= config.ssrResolution - windowOnSteps;
+
+        plant.step(stepSeconds, heaterOn, oven.commandedDoor);
+    }
+    controlTrace = tracer.getTrace();
+    return true;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <functional>
+#include <stdint.h>
+#include "thermal_plant.h"
+#include "library/oven_control_loop.h"
+#include "library/reflow_sequencer.h"
+#include "library/temp_history.h"
+#include "library/loop_tracer.h"
+#include "models/reflow_model.h"
+
+struct SimulationConfig {
+    PlantParameters plant;
+    float startTemp;
+    bool feedForward;          // Give the controller calibration tables synthesised from the plant
+    float calibrationGain;     // Scale on those tables, 1.0 = perfect model
+    uint32_t controlPeriodMs;  // Heater control / reflow engine tick
+    uint32_t controlJitterMs;  // Each tick starts up to this much after its release (pseudo-random, repeatable)
+    uint32_t ssrWindowMs;
+    uint32_t ssrResolution;
+    uint32_t sensorRateHz;
+    uint32_t plantStepMs;
+
+    static SimulationConfig defaults(const PlantParameters& plant);
+};
+
+// One record per control tick
+struct SimulationSample {
+    uint32_t timeMs;
+    uint8_t stepIndex;
+    float setpoint;
+    float chamberTemp;   // True oven temperature
+    float measuredTemp;  // What the controller saw
+    float heaterPower;
+    float doorPercent;   // Actual door position after servo slew
+};
+
+// Runs a reflow curve against a ThermalPlant on simulated time, through the
+// same ReflowSequencer and OvenControlLoop that ReflowEngine and
+// TemperatureControlService run, with a small HAL standing in for the SSR and
+// the door servo. Mirrors the firmware timing: both tick every
+// controlPeriodMs, the SSR latches power per window and switches on for the
+// last N steps of it, and the thermocouple is sampled at sensorRateHz.
+// Control ticks are traced with the firmware's LoopTracer, so scheduling
+// jitter injected through controlJitterMs shows up in the same figures.
+class OvenSimulation {
+public:
+    typedef std::function<void(const SimulationSample&)> SampleCallback;
+
+    explicit OvenSimulation(const SimulationConfig& config);
+
+    // Runs the curve to completion plus 'tailMs' of cool-down; returns false if it would not build
+    bool run(const ReflowCurve& curve, const SampleCallback& onSample, uint32_t tailMs = 0);
+
+    // Control tick timing of the last run
+    const LoopTrace& getControlTrace() const { return controlTrace; }
+
+private:
+    SimulationConfig config;
+    LoopTrace controlTrace;
+};
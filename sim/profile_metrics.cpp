@@ -0,0 +1,51 @@
+#include "profile_metrics.h"
+#include <math.h>
+
+ProfileMetricsCollector::ProfileMetricsCollector(const ReflowCurve& curve, uint32_t profileDurationMs,
+                                                 uint32_t controlPeriodMs)
+    : peakSetpoint(0.0f),
+      finalSetpoint(curve.getSteps().empty() ? 0.0f : curve.getSteps().back().targetTempC),
+      liquidus(curve.liquidusTempC),
+      profileDurationMs(profileDurationMs),
+      controlPeriodMs(controlPeriodMs),
+      count(0),
+      sumSquaredError(0.0),
+      maxError(0.0f),
+      peakTemp(-1000.0f),
+      aboveLiquidusMs(0),
+      cycleEndMs(0),
+      cooled(false) {
+    for (const ReflowStep& step : curve.getSteps()) {
+        peakSetpoint = fmaxf(peakSetpoint, step.targetTempC);
+    }
+}
+
+void ProfileMetricsCollector::add(const SimulationSample& sample) {
+    peakTemp = fmaxf(peakTemp, sample.chamberTemp);
+    if (sample.chamberTemp >= liquidus) {
+        aboveLiquidusMs += controlPeriodMs;
+    }
+
+    if (sample.timeMs < profileDurationMs) {
+        float error = sample.chamberTemp - sample.setpoint;
+        sumSquaredError += static_cast<double>(error) * error;
+        maxError = fmaxf(maxError, fabsf(error));
+        count++;
+    } else if (!cooled && sample.chamberTemp <= finalSetpoint + COOL_MARGIN) {
+        cooled = true;
+        cycleEndMs = sample.timeMs;
+    }
+}
+
+ProfileMetrics ProfileMetricsCollector::result() const {
+    ProfileMetrics metrics = {};
+    metrics.samples = count;
+    metrics.rmsError = count ? static_cast<float>(sqrt(sumSquaredError / count)) : 0.0f;
+    metrics.maxError = maxError;
+    metrics.peakTemp = peakTemp;
+    metrics.overshoot = fmaxf(peakTemp - peakSetpoint, 0.0f);
+    metrics.timeAboveLiquidusS = aboveLiquidusMs / 1000.0f;
+    metrics.cycleComplete = cooled;
+    metrics.cycleTimeS = cycleEndMs / 1000.0f;
+    return metrics;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdint.h>
+#include "oven_simulation.h"
+
+// Control-quality figures for one simulated reflow run, accumulated sample by sample
+struct ProfileMetrics {
+    uint32_t samples;
+    float rmsError;            // °C, true oven temperature vs setpoint while the profile runs
+    float maxError;            // °C, largest absolute deviation
+    float overshoot;           // °C the oven peaked above the profile's peak setpoint
+    float peakTemp;            // °C
+    float timeAboveLiquidusS;
+    float cycleTimeS;          // Start until the oven is back within COOL_MARGIN of the final setpoint
+    bool cycleComplete;        // False if the oven never cooled down inside the simulated tail
+};
+
+class ProfileMetricsCollector {
+public:
+    static constexpr float COOL_MARGIN = 5.0f;
+
+    ProfileMetricsCollector(const ReflowCurve& curve, uint32_t profileDurationMs, uint32_t controlPeriodMs);
+
+    void add(const SimulationSample& sample);
+    ProfileMetrics result() const;
+
+private:
+    float peakSetpoint;
+    float finalSetpoint;
+    float liquidus;
+    uint32_t profileDurationMs;
+    uint32_t controlPeriodMs;
+
+    uint32_t count;
+    double sumSquaredError;
+    float maxError;
+    float peakTemp;
+    uint32_t aboveLiquidusMs;
+    uint32_t cycleEndMs;
+    bool cooled;
+};
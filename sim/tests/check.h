@@ -0,0 +1,36 @@
+#pragma once
+
+// Minimal assertions for the host unit tests. A failed check prints where it
+// failed and is counted; main() returns checkFailures() so CTest sees it.
+
+#include <math.h>
+#include <stdio.h>
+
+inline int& checkFailureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+inline int checkFailures() {
+    if (checkFailureCount() == 0) printf("all checks passed\n");
+    return checkFailureCount() == 0 ? 0 : 1;
+}
+
+#define CHECK(condition)                                                          \
+    do {                                                                          \
+        if (!(condition)) {                                                       \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);  \
+            checkFailureCount()++;                                                \
+        }                                                                         \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                                   \
+    do {                                                                          \
+        double checkActual = (actual);                                            \
+        double checkExpected = (expected);                                        \
+        if (!(fabs(checkActual - checkExpected) <= (tolerance))) {                \
+            printf("%s:%d: %s = %g, expected %g +/- %g\n", __FILE__, __LINE__,    \
+                   #actual, checkActual, checkExpected, static_cast<double>(tolerance)); \
+            checkFailureCount()++;                                                \
+        }                                                                         \
+    } while (0)
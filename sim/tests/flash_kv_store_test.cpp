@@ -0,0 +1,219 @@
+// FlashKvStore: values survive remounts and sector rotation, and a power cut
+// in the middle of any erase or program leaves every key at its last
+// committed value (or at the value being written) after the next mount.
+
+#include "check.h"
+#include "library/flash_kv_store.h"
+#include <string.h>
+#include <vector>
+
+static const uint32_t REGION_OFFSET = 0x100000;
+static const size_t SECTORS = 4;
+static const uint32_t MAGIC = 0x54534554;  // "TEST"
+static const uint16_t KEYS = 5;
+
+// NOR flash in RAM. Program can only clear bits. Each erase or program in a
+// batch counts as one operation. From 'failAt' on, every
+// operation fails; the one at 'failAt' is torn after 'tearBytes' bytes.
+struct SimulatedFlash {
+    std::vector<uint8_t> bytes;
+    uint32_t operations;
+    uint32_t batches;
+    uint32_t failAt;
+    size_t tearBytes;
+
+    SimulatedFlash() : bytes(SECTORS * FlashKvStore::SECTOR_SIZE, 0xFF), operations(0), batches(0), failAt(0), tearBytes(0) {}
+
+    // How many bytes of this operation reach the flash
+    size_t admit(size_t length) {
+        uint32_t operation = ++operations;
+        if (failAt == 0 || operation < failAt) return length;
+        if (operation > failAt) return 0;
+        return tearBytes < length ? tearBytes : length;
+    }
+
+    bool powered() const { return failAt == 0 || operations < failAt; }
+
+    static bool execute(const FlashKvStore::FlashOp* batch, size_t count, void* context) {
+        auto* flash = static_cast<SimulatedFlash*>(context);
+        flash->batches++;
+        for (size_t i = 0; i < count; ++i) {
+            const FlashKvStore::FlashOp& op = batch[i];
+            uint8_t* target = &flash->bytes[op.offset - REGION_OFFSET];
+            size_t done = flash->admit(op.length);
+            if (op.erase) {
+                memset(target, 0xFF, done);
+            } else {
+                for (size_t j = 0; j < done; ++j) target[j] &= op.data[j];
+            }
+            if (done != op.length || !flash->powered()) return false;
+        }
+        return true;
+    }
+
+    FlashKvStore::FlashOps ops() { return {execute, this}; }
+};
+
+// Values of a few hundred bytes, so records span pages and rotations come often
+struct Value {
+    uint32_t version;
+    uint8_t fill[300];
+};
+
+static Value makeValue(uint16_t key, uint32_t version) {
+    Value value;
+    value.version = version;
+    memset(value.fill, static_cast<uint8_t>(key * 31 + version), sizeof(value.fill));
+    return value;
+}
+
+static bool readVersion(const FlashKvStore& store, uint16_t key, uint32_t* version) {
+    Value value;
+    if (!store.read(key, &value, sizeof(value))) return false;
+    Value expected = makeValue(key, value.version);
+    if (memcmp(&value, &expected, sizeof(value)) != 0) return false;
+    *version = value.version;
+    return true;
+}
+
+static void testRoundTripAndRotation() {
+    SimulatedFlash flash;
+    FlashKvStore store(flash.bytes.data(), REGION_OFFSET, SECTORS, MAGIC, flash.ops());
+    store.mount();
+
+    uint32_t version;
+    CHECK(!readVersion(store, 1, &version));
+
+    // Enough updates to go round the ring several times. A plain save is one
+    // batch; one that rotates takes a second for the reclaimed sector's erase.
+    for (uint32_t round = 1; round <= 40; ++round) {
+        for (uint16_t key = 0; key < KEYS; ++key) {
+            Value value = makeValue(key, round);
+            uint32_t batches = flash.batches;
+            CHECK(store.write(key, &value, sizeof(value)));
+            CHECK(flash.batches - batches <= 2);
+        }
+    }
+    CHECK(store.getEraseCount() > 2 * SECTORS);
+
+    FlashKvStore remounted(flash.bytes.data(), REGION_OFFSET, SECTORS, MAGIC, flash.ops());
+    remounted.mount();
+    for (uint16_t key = 0; key < KEYS; ++key) {
+        CHECK(readVersion(remounted, key, &version) && version == 40);
+    }
+
+    // Another store's magic sees nothing
+    FlashKvStore other(flash.bytes.data(), REGION_OFFSET, SECTORS, MAGIC + 1, flash.ops());
+    other.mount();
+    CHECK(!readVersion(other, 0, &version));
+}
+
+static void testSizeLimits() {
+    SimulatedFlash flash;
+    FlashKvStore store(flash.bytes.data(), REGION_OFFSET, SECTORS, MAGIC, flash.ops());
+    store.mount();
+
+    static uint8_t large[FlashKvStore::MAX_VALUE_SIZE + 1];
+    CHECK(!store.write(1, large, sizeof(large)));
+    CHECK(store.write(1, large, FlashKvStore::MAX_VALUE_SIZE));
+
+    uint8_t small = 7;
+    uint8_t wrongSize[2];
+    CHECK(store.write(2, &small, 1));
+    CHECK(!store.read(2, wrongSize, sizeof(wrongSize)));
+}
+
+static void testFirstWriteLeavesSectorZero() {
+    // Whatever an older layout left at the start of the region outlives the first record
+    SimulatedFlash flash;
+    memset(flash.bytes.data(), 0x5A, 64);
+    FlashKvStore store(flash.bytes.data(), REGION_OFFSET, SECTORS, MAGIC, flash.ops());
+    store.mount();
+
+    Value value = makeValue(1, 1);
+    CHECK(store.write(1, &value, sizeof(value)));
+    CHECK(flash.bytes[0] == 0x5A && flash.bytes[63] == 0x5A);
+
+    FlashKvStore remounted(flash.bytes.data(), REGION_OFFSET, SECTORS, MAGIC, flash.ops());
+    remounted.mount();
+    uint32_t version;
+    CHECK(readVersion(remounted, 1, &version) && version == 1);
+}
+
+// Runs the same update sequence, cutting the power at operation 'failAt'
+// torn after 'tearBytes', then remounts and checks what survived
+static void runPowerCut(uint32_t failAt, size_t tearBytes, bool* reachedEnd) {
+    SimulatedFlash flash;
+    flash.failAt = failAt;
+    flash.tearBytes = tearBytes;
+
+    uint32_t committed[KEYS] = {};
+    uint16_t pendingKey = 0;
+    uint32_t pendingVersion = 0;
+    {
+        FlashKvStore store(flash.bytes.data(), REGION_OFFSET, SECTORS, MAGIC, flash.ops());
+        store.mount();
+        *reachedEnd = true;
+        for (uint32_t round = 1; round <= 12 && *reachedEnd; ++round) {
+            for (uint16_t key = 0; key < KEYS; ++key) {
+                // Key 0 is only written once, so rotations have to copy it forward
+                if (key == 0 && round > 1) continue;
+                Value value = makeValue(key, round);
+                if (!store.write(key, &value, sizeof(value))) {
+                    pendingKey = key;
+                    pendingVersion = round;
+                    *reachedEnd = false;
+                    break;
+                }
+                committed[key] = round;
+            }
+        }
+    }
+
+    // Power back: mount on the same flash
+    flash.failAt = 0;
+    FlashKvStore store(flash.bytes.data(), REGION_OFFSET, SECTORS, MAGIC, flash.ops());
+    store.mount();
+    for (uint16_t key = 0; key < KEYS; ++key) {
+        uint32_t version = 0;
+        bool found = readVersion(store, key, &version);
+        bool ok = found ? (version == committed[key] || (key == pendingKey && version == pendingVersion))
+                        : committed[key] == 0;
+        if (!ok) {
+            printf("power cut at op %u (+%zu bytes): key %u read %s v%u, committed v%u\n", failAt, tearBytes,
+                   key, found ? "back" : "nothing", version, committed[key]);
+        }
+        CHECK(ok);
+    }
+
+    // And the store carries on from there
+    for (uint16_t key = 0; key < KEYS; ++key) {
+        Value value = makeValue(key, 100);
+        CHECK(store.write(key, &value, sizeof(value)));
+    }
+    FlashKvStore again(flash.bytes.data(), REGION_OFFSET, SECTORS, MAGIC, flash.ops());
+    again.mount();
+    for (uint16_t key = 0; key < KEYS; ++key) {
+        uint32_t version = 0;
+        CHECK(readVersion(again, key, &version) && version == 100);
+    }
+}
+
+static void testPowerCuts() {
+    // Tear inside the sector or record header, inside the payload, and just short of the end
+    const size_t tears[] = {0, 6, 20, 300, FlashKvStore::PAGE_SIZE + 40, FlashKvStore::SECTOR_SIZE - 1};
+    for (size_t tearBytes : tears) {
+        bool reachedEnd = false;
+        for (uint32_t failAt = 1; !reachedEnd; ++failAt) {
+            runPowerCut(failAt, tearBytes, &reachedEnd);
+        }
+    }
+}
+
+int main() {
+    testRoundTripAndRotation();
+    testSizeLimits();
+    testFirstWriteLeavesSectorZero();
+    testPowerCuts();
+    return checkFailures();
+}
@@ -0,0 +1,133 @@
+// FrameEncoder / FrameDecoder: frames round-trip through COBS and the CRC,
+// whatever their payload, and the decoder drops corrupt or truncated frames
+// and stdio text on the same UART without losing the frames around them.
+
+#include "check.h"
+#include "library/frame_encoder.h"
+#include <string.h>
+#include <vector>
+
+static const size_t MAX_PAYLOAD = 600;
+
+static std::vector<uint8_t> encode(uint8_t type, uint16_t sequence, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> frame(FrameEncoder::maxEncodedSize(payload.size()));
+    size_t length = FrameEncoder::encode(type, sequence, payload.data(), payload.size(), frame.data(), frame.size());
+    CHECK(length > 0 && length <= frame.size());
+    frame.resize(length);
+    return frame;
+}
+
+struct Receiver {
+    uint8_t buffer[MAX_PAYLOAD + FrameEncoder::HEADER_SIZE + FrameEncoder::CRC_SIZE];
+    FrameDecoder decoder;
+    std::vector<std::vector<uint8_t>> payloads;
+    std::vector<uint16_t> sequences;
+
+    Receiver() : decoder(buffer, sizeof(buffer)) {}
+
+    void feed(const std::vector<uint8_t>& bytes) {
+        for (uint8_t value : bytes) {
+            if (!decoder.push(value)) continue;
+            const uint8_t* payload = decoder.getPayload();
+            payloads.emplace_back(payload, payload + decoder.getPayloadLength());
+            sequences.push_back(decoder.getSequence());
+        }
+    }
+
+    void feed(const char* text) { feed(std::vector<uint8_t>(text, text + strlen(text))); }
+};
+
+static void testCrc() {
+    // CRC-16/CCITT-FALSE check value
+    const char* check = "123456789";
+    CHECK(FrameEncoder::crc16(reinterpret_cast<const uint8_t*>(check), 9) == 0x29B1);
+}
+
+static void testRoundTrip() {
+    std::vector<std::vector<uint8_t>> payloads = {
+        {},
+        {0x42},
+        std::vector<uint8_t>(40, 0x00),         // Nothing but zeros
+        std::vector<uint8_t>(254, 0x11),        // Exactly one full COBS block
+        std::vector<uint8_t>(253, 0x22),
+        std::vector<uint8_t>(255, 0x33),
+        std::vector<uint8_t>(MAX_PAYLOAD, 0xFF), // Several full blocks in a row
+    };
+    std::vector<uint8_t> mixed(MAX_PAYLOAD);
+    for (size_t i = 0; i < mixed.size(); ++i) mixed[i] = static_cast<uint8_t>((i % 300 == 0) ? 0 : i * 7);
+    payloads.push_back(mixed);
+
+    Receiver receiver;
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        std::vector<uint8_t> frame = encode(static_cast<uint8_t>(i + 1), static_cast<uint16_t>(0xFFF0 + i), payloads[i]);
+        // Only the delimiters are zero
+        for (size_t j = 1; j + 1 < frame.size(); ++j) CHECK(frame[j] != 0x00);
+        CHECK(frame.front() == 0x00 && frame.back() == 0x00);
+        receiver.feed(frame);
+        CHECK(receiver.decoder.getType() == i + 1);
+    }
+    CHECK(receiver.payloads == payloads);
+    CHECK(receiver.sequences.size() == payloads.size() && receiver.sequences.back() == 0xFFF0 + payloads.size() - 1);
+    CHECK(receiver.decoder.getErrorCount() == 0);
+
+    // Too small a buffer is refused
+    uint8_t small[8];
+    CHECK(FrameEncoder::encode(1, 0, mixed.data(), 10, small, sizeof(small)) == 0);
+}
+
+static void testCorruption() {
+    std::vector<uint8_t> payload = {1, 2, 3, 0, 5, 6};
+    Receiver receiver;
+    receiver.feed(encode(1, 1, payload));
+
+    // A flipped bit in every position but the delimiters fails the CRC or the framing
+    std::vector<uint8_t> frame = encode(1, 2, payload);
+    for (size_t i = 0; i < frame.size(); ++i) {
+        for (int bit = 0; bit < 8; ++bit) {
+            std::vector<uint8_t> corrupt = frame;
+            corrupt[i] ^= static_cast<uint8_t>(1 << bit);
+            if (corrupt[i] == 0x00 || frame[i] == 0x00) continue;
+            receiver.feed(corrupt);
+        }
+    }
+    CHECK(receiver.payloads.size() == 1);
+    CHECK(receiver.decoder.getErrorCount() > 0);
+
+    // A frame cut short and followed by the next one loses only itself
+    std::vector<uint8_t> truncated = encode(1, 3, payload);
+    truncated.resize(truncated.size() / 2);
+    receiver.feed(truncated);
+    receiver.feed(encode(1, 4, payload));
+    CHECK(receiver.payloads.size() == 2 && receiver.sequences.back() == 4);
+
+    // A frame too long for the buffer is dropped, and the decoder recovers
+    std::vector<uint8_t> large(MAX_PAYLOAD + 1, 0x55);
+    receiver.feed(encode(1, 5, large));
+    receiver.feed(encode(1, 6, payload));
+    CHECK(receiver.payloads.size() == 3 && receiver.sequences.back() == 6);
+}
+
+static void testStdioBetweenFrames() {
+    // printf output shares the UART: before the first frame, between frames
+    // and right before a frame that follows without a pause
+    std::vector<uint8_t> payload = {9, 0, 8, 0, 7};
+    Receiver receiver;
+    receiver.feed("boot: hello\r\n");
+    receiver.feed(encode(2, 1, payload));
+    receiver.feed("Settings: saving key 1 failed\n");
+    receiver.feed(encode(2, 2, payload));
+    receiver.feed(encode(2, 3, payload));
+    receiver.feed("x");
+    receiver.feed(encode(2, 4, payload));
+
+    CHECK(receiver.sequences == std::vector<uint16_t>({1, 2, 3, 4}));
+    for (const std::vector<uint8_t>& received : receiver.payloads) CHECK(received == payload);
+}
+
+int main() {
+    testCrc();
+    testRoundTrip();
+    testCorruption();
+    testStdioBetweenFrames();
+    return checkFailures();
+}
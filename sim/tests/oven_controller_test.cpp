@@ -0,0 +1,76 @@
+// OvenController: a stopped controller must start the next run exactly like a
+// fresh one, whatever feed-forward the previous run ended on.
+
+#include "check.h"
+#include "library/oven_controller.h"
+
+static ThermalCalibrationSummary makeCalibration() {
+    // Heating rate grows with power and falls off with temperature
+    ThermalCalibrationSummary summary = {};
+    for (size_t t = 0; t < ThermalCalibrationSummary::NUM_TEMP_POINTS; ++t) {
+        for (size_t i = 0; i < ThermalCalibrationSummary::NUM_POWER_LEVELS; ++i) {
+            float level = static_cast<float>(i + 1) / 10.0f;
+            summary.heatingRates[t][i] = 3.0f * level - 0.4f * static_cast<float>(t);
+            summary.coolingRates[t][i] = 0.2f + 0.8f * level;
+        }
+    }
+    return summary;
+}
+
+static OvenController::Inputs at(float temperature) {
+    return {temperature, 0.0f, false, false, 0.25f};
+}
+
+static void testStopThenStart() {
+    OvenController used;
+    used.setCalibration(makeCalibration());
+    CHECK(used.hasModel());
+
+    // A run that ends on a steep ramp with plenty of feed-forward
+    used.setTarget(200.0f, 2.0f);
+    for (int i = 0; i < 200; ++i) used.update(at(150.0f + i * 0.2f));
+    CHECK(used.getFeedForward().heaterPower > 10.0f);
+
+    // Stop: everything off, PID held at rest with nothing left over
+    used.setTarget(0.0f, 0.0f);
+    OvenController::Outputs stopped = used.update(at(180.0f));
+    CHECK_NEAR(stopped.heaterPower, 0.0f, 0.0);
+    CHECK_NEAR(stopped.doorPercent, 0.0f, 0.0);
+    CHECK_NEAR(used.getPid().getFeedForward(), 0.0f, 0.0);
+    CHECK_NEAR(used.getPid().getIntegral(), 0.0f, 1e-6);
+
+    // Cool down a while, then start a new run: same outputs as a controller that never ran
+    for (int i = 0; i < 20; ++i) used.update(at(60.0f));
+    OvenController fresh;
+    fresh.setCalibration(makeCalibration());
+    // Close to target so the outputs are not saturated and any integral bias shows
+    used.setTarget(64.0f, 0.5f);
+    fresh.setTarget(64.0f, 0.5f);
+    for (int i = 0; i < 50; ++i) {
+        float temperature = 60.0f + i * 0.05f;
+        OvenController::Outputs a = used.update(at(temperature));
+        OvenController::Outputs b = fresh.update(at(temperature));
+        CHECK_NEAR(a.heaterPower, b.heaterPower, 1e-4);
+        CHECK_NEAR(a.doorPercent, b.doorPercent, 1e-4);
+        CHECK(b.heaterPower > 0.0f && b.heaterPower < 100.0f);
+    }
+}
+
+static void testSensorFaultStops() {
+    OvenController controller;
+    controller.setCalibration(makeCalibration());
+    controller.setTarget(200.0f, 2.0f);
+    for (int i = 0; i < 20; ++i) controller.update(at(100.0f));
+
+    OvenController::Inputs fault = at(100.0f);
+    fault.sensorFault = true;
+    OvenController::Outputs outputs = controller.update(fault);
+    CHECK_NEAR(outputs.heaterPower, 0.0f, 0.0);
+    CHECK_NEAR(controller.getPid().getIntegral(), 0.0f, 1e-6);
+}
+
+int main() {
+    testStopThenStart();
+    testSensorFaultStops();
+    return checkFailures();
+}
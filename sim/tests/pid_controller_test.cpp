@@ -0,0 +1,112 @@
+// PidController: anti-windup, bumpless gain changes and reset seeding.
+
+#include "check.h"
+#include "library/pid_controller.h"
+
+static void testProportionalOnly() {
+    PidController pid(2.0f, 0.0f, 0.0f);
+    CHECK_NEAR(pid.update(100.0f, 90.0f, 0.25f), 20.0f, 1e-4);
+    CHECK_NEAR(pid.update(100.0f, 99.0f, 0.25f), 2.0f, 1e-4);
+    CHECK(!pid.isSaturated());
+}
+
+static void testIntegralAccumulates() {
+    PidController pid(0.0f, 1.0f, 0.0f);
+    for (int i = 0; i < 4; ++i) pid.update(10.0f, 5.0f, 0.5f);
+    // 5 °C error for 2 s at Ki = 1
+    CHECK_NEAR(pid.getIntegral(), 10.0f, 1e-3);
+}
+
+static void testAntiWindup() {
+    PidController pid(2.0f, 0.5f, 0.0f);
+    pid.setIntegralLimits(-20.0f, 100.0f);
+
+    // A large error held for a long time saturates the output
+    for (int i = 0; i < 400; ++i) pid.update(250.0f, 25.0f, 0.25f);
+    CHECK(pid.isSaturated());
+    CHECK_NEAR(pid.getOutput(), 100.0f, 1e-4);
+    // Back-calculation keeps the integral near what the actuator can deliver, well inside the clamp
+    CHECK(pid.getIntegral() <= 100.0f);
+
+    // Once past the setpoint the output comes off the rail within a few ticks, not minutes
+    int ticks = 0;
+    while (pid.update(250.0f, 255.0f, 0.25f) >= 100.0f && ticks < 1000) ticks++;
+    CHECK(ticks < 40);
+}
+
+static void testIntegralClamp() {
+    PidController pid(0.0f, 10.0f, 0.0f);
+    pid.setTrackingGain(1e-6f);
+    pid.setIntegralLimits(-20.0f, 30.0f);
+    for (int i = 0; i < 100; ++i) pid.update(100.0f, 0.0f, 1.0f);
+    CHECK_NEAR(pid.getIntegral(), 30.0f, 1e-4);
+    for (int i = 0; i < 100; ++i) pid.update(0.0f, 100.0f, 1.0f);
+    CHECK_NEAR(pid.getIntegral(), -20.0f, 1e-4);
+}
+
+static void testBumplessGainChange() {
+    // In the linear region: a small error and a slowly rising measurement
+    PidController pid(2.0f, 0.1f, 0.5f);
+    pid.reset(140.0f, 30.0f);
+    float temp = 140.0f;
+    for (int i = 0; i < 40; ++i) {
+        pid.update(150.0f, temp, 0.25f);
+        temp += 0.05f;
+    }
+    CHECK(!pid.isSaturated());
+    float before = pid.getProportional() + pid.getIntegral() + pid.getDerivative();
+
+    pid.setGains(4.0f, 0.2f, 1.0f);
+    float after = pid.getProportional() + pid.getIntegral() + pid.getDerivative();
+    CHECK_NEAR(after, before, 1e-3);
+
+    // The next update moves by what the new gains do with one more tick, not by the gain ratio
+    float output = pid.update(150.0f, temp, 0.25f);
+    CHECK_NEAR(output, before, 5.0);
+}
+
+static void testResetSeedsIntegral() {
+    PidController pid(2.0f, 0.1f, 0.0f);
+    pid.update(200.0f, 100.0f, 0.25f);
+
+    pid.reset(80.0f, 40.0f);
+    CHECK_NEAR(pid.getOutput(), 40.0f, 1e-4);
+    CHECK_NEAR(pid.getIntegral(), 40.0f, 1e-4);
+    CHECK_NEAR(pid.getProportional(), 0.0f, 1e-6);
+
+    // At zero error the first update hands over at the seeded output
+    CHECK_NEAR(pid.update(80.0f, 80.0f, 0.25f), 40.0f, 1e-3);
+
+    // With feed-forward set, the integral only carries the rest of the seed
+    pid.setFeedForward(25.0f);
+    pid.reset(80.0f, 40.0f);
+    CHECK_NEAR(pid.getIntegral(), 15.0f, 1e-4);
+
+    // Seeds outside the output range are clamped
+    pid.setFeedForward(0.0f);
+    pid.reset(80.0f, 150.0f);
+    CHECK_NEAR(pid.getOutput(), 100.0f, 1e-4);
+}
+
+static void testDerivativeOnMeasurement() {
+    PidController pid(0.0f, 0.0f, 1.0f);
+    pid.setDerivativeFilter(0.0f);
+    pid.update(100.0f, 50.0f, 1.0f);
+    // A setpoint step does not kick the output
+    CHECK_NEAR(pid.update(200.0f, 50.0f, 1.0f), 0.0f, 1e-4);
+    // A rising measurement pulls it down
+    CHECK_NEAR(pid.getDerivative(), 0.0f, 1e-6);
+    pid.setOutputLimits(-100.0f, 100.0f);
+    CHECK_NEAR(pid.update(200.0f, 52.0f, 1.0f), -2.0f, 1e-4);
+}
+
+int main() {
+    testProportionalOnly();
+    testIntegralAccumulates();
+    testAntiWindup();
+    testIntegralClamp();
+    testBumplessGainChange();
+    testResetSeedsIntegral();
+    testDerivativeOnMeasurement();
+    return checkFailures();
+}
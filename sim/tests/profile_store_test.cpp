@@ -0,0 +1,244 @@
+// ProfileStore: profiles can be replaced and removed across remounts, a full
+// store keeps accepting replacements through compaction, and a power cut in
+// the middle of any erase or program leaves every profile at its last
+// committed version (or at the one being written) after the next mount.
+
+#include "check.h"
+#include "library/profile_store.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+static const uint32_t REGION_OFFSET = 0x200000;
+static const size_t SECTORS = 3;
+static const size_t NAMES = 6;
+
+// NOR flash in RAM. Program can only clear bits. From 'failAt' on, every
+// operation fails; the one at 'failAt' is torn after 'tearBytes' bytes.
+struct SimulatedFlash {
+    std::vector<uint8_t> bytes;
+    uint32_t operations;
+    uint32_t erases;
+    uint32_t failAt;
+    size_t tearBytes;
+
+    SimulatedFlash()
+        : bytes(SECTORS * ProfileStore::SECTOR_SIZE, 0xFF), operations(0), erases(0), failAt(0), tearBytes(0) {}
+
+    // How many bytes of this operation reach the flash
+    size_t admit(size_t length) {
+        uint32_t operation = ++operations;
+        if (failAt == 0 || operation < failAt) return length;
+        if (operation > failAt) return 0;
+        return tearBytes < length ? tearBytes : length;
+    }
+
+    bool powered() const { return failAt == 0 || operations < failAt; }
+
+    static bool erase(uint32_t offset, size_t length, void* context) {
+        auto* flash = static_cast<SimulatedFlash*>(context);
+        flash->erases++;
+        size_t done = flash->admit(length);
+        memset(&flash->bytes[offset - REGION_OFFSET], 0xFF, done);
+        return done == length && flash->powered();
+    }
+
+    static bool program(uint32_t offset, const uint8_t* data, size_t length, void* context) {
+        auto* flash = static_cast<SimulatedFlash*>(context);
+        size_t done = flash->admit(length);
+        for (size_t i = 0; i < done; ++i) flash->bytes[offset - REGION_OFFSET + i] &= data[i];
+        return done == length && flash->powered();
+    }
+
+    ProfileStore::FlashOps ops() { return {erase, program, this}; }
+};
+
+static void makeName(uint32_t id, char* name) {
+    snprintf(name, StoredProfile::NAME_SIZE, "Profile %02u", static_cast<unsigned>(id));
+}
+
+// Every point carries the version, so a copy mixed from two versions shows up
+static StoredProfile makeProfile(uint32_t id, uint32_t version) {
+    StoredProfile profile;
+    memset(&profile, 0, sizeof(profile));
+    makeName(id, profile.name);
+    profile.pointCount = static_cast<uint8_t>(3 + id % 4);
+    for (size_t i = 0; i < profile.pointCount; ++i) {
+        profile.points[i].tempC = static_cast<float>(version * 100 + i);
+        profile.points[i].timeMs = static_cast<uint32_t>(i * 30000);
+    }
+    return profile;
+}
+
+// 0 if the profile is missing, its version if it is intact, UINT32_MAX if it is not
+static uint32_t readVersion(const ProfileStore& store, uint32_t id) {
+    char name[StoredProfile::NAME_SIZE];
+    makeName(id, name);
+    const StoredProfile* stored = store.findByName(name);
+    if (!stored) return 0;
+
+    uint32_t version = static_cast<uint32_t>(stored->points[0].tempC) / 100;
+    StoredProfile expected = makeProfile(id, version);
+    if (stored->pointCount != expected.pointCount || strcmp(stored->name, expected.name) != 0) return UINT32_MAX;
+    if (memcmp(stored->points, expected.points, expected.pointCount * sizeof(ProfilePoint)) != 0) return UINT32_MAX;
+    return version;
+}
+
+static void testReplaceAndRemove() {
+    SimulatedFlash flash;
+    ProfileStore store(flash.bytes.data(), REGION_OFFSET, SECTORS, flash.ops());
+    store.mount();
+    CHECK(store.getCount() == 0);
+
+    CHECK(store.store(makeProfile(2, 1)) == ProfileStore::Result::OK);
+    CHECK(store.store(makeProfile(1, 1)) == ProfileStore::Result::OK);
+    CHECK(store.store(makeProfile(2, 2)) == ProfileStore::Result::OK);
+    CHECK(store.getCount() == 2);
+    CHECK(readVersion(store, 1) == 1 && readVersion(store, 2) == 2);
+
+    // In name order, and by hash
+    CHECK(strcmp(store.get(0)->name, "Profile 01") == 0 && strcmp(store.get(1)->name, "Profile 02") == 0);
+    CHECK(store.get(2) == nullptr);
+    CHECK(store.findByHash(ProfileStore::hashName("Profile 02")) == store.findByName("Profile 02"));
+
+    CHECK(store.remove("Profile 01"));
+    CHECK(!store.remove("Profile 01"));
+    CHECK(store.getCount() == 1 && readVersion(store, 1) == 0);
+
+    StoredProfile invalid = makeProfile(3, 1);
+    invalid.points[2].timeMs = invalid.points[1].timeMs;
+    CHECK(store.store(invalid) == ProfileStore::Result::INVALID);
+
+    // A first point at 0 ms is a zero-length step
+    StoredProfile startsAtZero = makeProfile(4, 1);
+    CHECK(startsAtZero.points[0].timeMs == 0);
+    CHECK(store.store(startsAtZero) == ProfileStore::Result::OK);
+
+    ProfileStore remounted(flash.bytes.data(), REGION_OFFSET, SECTORS, flash.ops());
+    remounted.mount();
+    CHECK(remounted.getCount() == 2);
+    CHECK(readVersion(remounted, 1) == 0 && readVersion(remounted, 2) == 2 && readVersion(remounted, 4) == 1);
+}
+
+static void testCompactionWhenFull() {
+    SimulatedFlash flash;
+    ProfileStore store(flash.bytes.data(), REGION_OFFSET, SECTORS, flash.ops());
+    store.mount();
+
+    size_t capacity = store.getCapacity();
+    for (uint32_t id = 0; id < capacity; ++id) {
+        CHECK(store.store(makeProfile(id, 1)) == ProfileStore::Result::OK);
+    }
+    CHECK(store.store(makeProfile(static_cast<uint32_t>(capacity), 1)) == ProfileStore::Result::FULL);
+    CHECK(flash.erases == 0);
+
+    // Full, yet every profile can still be replaced, over and over
+    for (uint32_t version = 2; version <= 8; ++version) {
+        for (uint32_t id = 0; id < capacity; ++id) {
+            CHECK(store.store(makeProfile(id, version)) == ProfileStore::Result::OK);
+        }
+    }
+    CHECK(flash.erases > SECTORS);
+
+    ProfileStore remounted(flash.bytes.data(), REGION_OFFSET, SECTORS, flash.ops());
+    remounted.mount();
+    CHECK(remounted.getCount() == capacity);
+    for (uint32_t id = 0; id < capacity; ++id) CHECK(readVersion(remounted, id) == 8);
+}
+
+// Runs the same sequence of stores and removes, cutting the power at operation
+// 'failAt' torn after 'tearBytes', then remounts and checks what survived
+static void runPowerCut(uint32_t failAt, size_t tearBytes, bool* reachedEnd) {
+    SimulatedFlash flash;
+    flash.failAt = failAt;
+    flash.tearBytes = tearBytes;
+
+    uint32_t committed[NAMES] = {};
+    uint32_t pendingId = 0;
+    uint32_t pendingVersion = 0;
+    {
+        ProfileStore store(flash.bytes.data(), REGION_OFFSET, SECTORS, flash.ops());
+        store.mount();
+        *reachedEnd = true;
+        for (uint32_t round = 1; round <= 12 && *reachedEnd; ++round) {
+            for (uint32_t id = 0; id < NAMES; ++id) {
+                // Profile 0 is only written once, so compactions have to copy it;
+                // profile 1 is removed every third round
+                if (id == 0 && round > 1) continue;
+                bool removing = (id == 1 && round % 3 == 0);
+                bool ok;
+                if (removing) {
+                    char name[StoredProfile::NAME_SIZE];
+                    makeName(id, name);
+                    ok = store.remove(name);
+                } else {
+                    ok = store.store(makeProfile(id, round)) == ProfileStore::Result::OK;
+                }
+                // A store that wrote its copy but could not retire the old one still succeeds;
+                // the power is gone, though, so the next operation fails
+                if (!ok) {
+                    pendingId = id;
+                    pendingVersion = removing ? 0 : round;
+                    *reachedEnd = false;
+                    break;
+                }
+                committed[id] = removing ? 0 : round;
+            }
+        }
+    }
+
+    // Power back: mount on the same flash
+    flash.failAt = 0;
+    ProfileStore store(flash.bytes.data(), REGION_OFFSET, SECTORS, flash.ops());
+    store.mount();
+    for (uint32_t id = 0; id < NAMES; ++id) {
+        uint32_t version = readVersion(store, id);
+        bool ok = version == committed[id] || (!*reachedEnd && id == pendingId && version == pendingVersion);
+        if (!ok) {
+            printf("power cut at op %u (+%zu bytes): profile %u read v%u, committed v%u\n", failAt, tearBytes,
+                   id, version, committed[id]);
+        }
+        CHECK(ok);
+    }
+
+    // A remove takes any older copy a power cut left unretired with it
+    char removed[StoredProfile::NAME_SIZE];
+    makeName(1, removed);
+    if (readVersion(store, 1) != 0) CHECK(store.remove(removed));
+    ProfileStore afterRemove(flash.bytes.data(), REGION_OFFSET, SECTORS, flash.ops());
+    afterRemove.mount();
+    CHECK(readVersion(afterRemove, 1) == 0);
+
+    // And the store carries on from there
+    for (uint32_t round = 100; round < 104; ++round) {
+        for (uint32_t id = 0; id < NAMES; ++id) {
+            CHECK(store.store(makeProfile(id, round)) == ProfileStore::Result::OK);
+        }
+    }
+    ProfileStore again(flash.bytes.data(), REGION_OFFSET, SECTORS, flash.ops());
+    again.mount();
+    CHECK(again.getCount() == NAMES);
+    for (uint32_t id = 0; id < NAMES; ++id) CHECK(readVersion(again, id) == 103);
+}
+
+static void testPowerCuts() {
+    // Tear before, inside and after the state word, inside the name, between the time and
+    // temperature of the last point of a six point profile (only the CRC catches that one),
+    // and just short of the end
+    const size_t lastPointTime = offsetof(StoredProfile, points) + 5 * sizeof(ProfilePoint) + offsetof(ProfilePoint, timeMs);
+    const size_t tears[] = {0, 10, 18, 40, lastPointTime, ProfileStore::SLOT_SIZE - 1, ProfileStore::SECTOR_SIZE - 1};
+    for (size_t tearBytes : tears) {
+        bool reachedEnd = false;
+        for (uint32_t failAt = 1; !reachedEnd; ++failAt) {
+            runPowerCut(failAt, tearBytes, &reachedEnd);
+        }
+    }
+}
+
+int main() {
+    testReplaceAndRemove();
+    testCompactionWhenFull();
+    testPowerCuts();
+    return checkFailures();
+}
@@ -0,0 +1,94 @@
+// ProfileTable: segment construction, bucketed lookups and the lookahead rate.
+
+#include "check.h"
+#include "library/profile_table.h"
+#include "library/reflow_curve_library.h"
+
+static constexpr ReflowCurve RAMP = makeReflowCurve("Test", 50.0f, {
+    {StepLabel::PREHEAT, 150.0f, 60000},
+    {StepLabel::SOAK, 150.0f, 30000},
+    {StepLabel::REFLOW, 240.0f, 45000},
+    {StepLabel::COOLDOWN, 60.0f, 0}
+});
+
+static void testSegments() {
+    ProfileTable table;
+    CHECK(table.isEmpty());
+    CHECK(table.build(RAMP, 30.0f));
+    CHECK(table.getSegmentCount() == 4);
+    CHECK(table.getTotalDurationMs() == 135000);
+
+    const ProfileTable::Segment& first = table.getSegment(0);
+    CHECK(first.startMs == 0 && first.endMs == 60000);
+    CHECK_NEAR(first.startTemp, 30.0f, 0.0);
+    CHECK_NEAR(first.slope * 1000.0f, 2.0f, 1e-5);
+    // A zero-length step is a jump, not a division by zero
+    CHECK_NEAR(table.getSegment(3).slope, 0.0f, 0.0);
+}
+
+static void testLookups() {
+    ProfileTable table;
+    table.build(RAMP, 30.0f);
+
+    ProfileTable::Setpoint setpoint = table.at(0);
+    CHECK_NEAR(setpoint.temp, 30.0f, 1e-4);
+    CHECK(setpoint.stepIndex == 0 && !setpoint.complete);
+
+    setpoint = table.at(30000);
+    CHECK_NEAR(setpoint.temp, 90.0f, 1e-3);
+    CHECK_NEAR(setpoint.rate, 2.0f, 1e-4);
+
+    setpoint = table.at(75000);
+    CHECK_NEAR(setpoint.temp, 150.0f, 1e-3);
+    CHECK(setpoint.stepIndex == 1);
+    CHECK_NEAR(setpoint.rate, 0.0f, 1e-6);
+
+    setpoint = table.at(90000);
+    CHECK(setpoint.stepIndex == 2);
+
+    setpoint = table.at(135000);
+    CHECK(setpoint.complete);
+    CHECK_NEAR(setpoint.temp, 60.0f, 0.0);
+    CHECK(setpoint.stepIndex == 3);
+
+    // Every millisecond lands in the segment that spans it, whatever bucket it falls in
+    for (uint32_t t = 0; t < table.getTotalDurationMs(); t += 7) {
+        setpoint = table.at(t);
+        const ProfileTable::Segment& segment = table.getSegment(setpoint.stepIndex);
+        CHECK(t >= segment.startMs && t < segment.endMs);
+    }
+}
+
+static void testLookahead() {
+    ProfileTable table;
+    table.build(RAMP, 30.0f);
+
+    // Ten seconds before the end of the ramp, a 20 s horizon sees half ramp and half soak
+    float meanRate = 0.0f;
+    ProfileTable::Setpoint ahead = table.lookahead(50000, 20000, &meanRate);
+    CHECK_NEAR(ahead.temp, 150.0f, 1e-3);
+    CHECK_NEAR(meanRate, 1.0f, 1e-3);
+
+    table.lookahead(10000, 0, &meanRate);
+    CHECK_NEAR(meanRate, 2.0f, 1e-4);
+}
+
+static void testRejects() {
+    ProfileTable table;
+    ReflowCurve empty = {};
+    CHECK(!table.build(empty, 25.0f));
+    CHECK(table.isEmpty());
+    CHECK(table.at(1000).complete);
+
+    for (const ReflowCurve& curve : ReflowCurveLibrary::getBuiltInCurves()) {
+        CHECK(table.build(curve, 25.0f));
+    }
+}
+
+int main() {
+    testSegments();
+    testLookups();
+    testLookahead();
+    testRejects();
+    return checkFailures();
+}
@@ -0,0 +1,175 @@
+// RunLogPageWriter / RunLogPageReader: samples come back exactly through the
+// delta varint encoding, a run replayed from a wrapped ring keeps the index
+// and time of its samples, and torn or foreign pages are rejected.
+
+#include "check.h"
+#include "library/run_log.h"
+#include <string.h>
+#include <vector>
+
+static const uint16_t PERIOD_MS = 250;
+
+// Smooth most of the time, with the occasional full-scale jump
+static RunSample makeSample(uint32_t index) {
+    RunSample sample;
+    sample.setpointDeciC = static_cast<int16_t>(250 + index * 3);
+    sample.tempDeciC = static_cast<int16_t>(240 + index * 3 - (index % 5));
+    sample.heaterPercent = static_cast<uint8_t>((index * 37) % 101);
+    sample.doorPercent = (index % 7 == 0) ? 100 : 0;
+    if (index % 50 == 13) {
+        sample.setpointDeciC = INT16_MIN;
+        sample.tempDeciC = INT16_MAX;
+    }
+    return sample;
+}
+
+static bool sameSample(const RunSample& a, const RunSample& b) {
+    return a.setpointDeciC == b.setpointDeciC && a.tempDeciC == b.tempDeciC &&
+           a.heaterPercent == b.heaterPercent && a.doorPercent == b.doorPercent;
+}
+
+// A ring of pages, written the way RunRecorderService does it
+struct Ring {
+    std::vector<uint8_t> bytes;
+    uint32_t pages;
+    uint32_t writePage;
+
+    explicit Ring(uint32_t pages) : bytes(pages * RunLog::PAGE_SIZE, 0xFF), pages(pages), writePage(0) {}
+
+    uint8_t* pageAt(uint32_t page) { return &bytes[page * RunLog::PAGE_SIZE]; }
+
+    void record(uint32_t runId, uint32_t samples, RunOutcome outcome) {
+        RunInfo info = {};
+        strncpy(info.curveName, "Lead-Free", sizeof(info.curveName) - 1);
+        RunLogPageWriter writer;
+        writer.begin(runId, 0, PERIOD_MS, &info);
+        for (uint32_t index = 0; index < samples; ++index) {
+            if (!writer.add(makeSample(index))) {
+                writer.finish(nullptr, pageAt(writePage));
+                writePage = (writePage + 1) % pages;
+                writer.begin(runId, index, PERIOD_MS, nullptr);
+                CHECK(writer.add(makeSample(index)));
+            }
+        }
+        RunEnd end = {outcome, 0, 2450};
+        writer.finish(&end, pageAt(writePage));
+        writePage = (writePage + 1) % pages;
+    }
+};
+
+static void testRoundTrip() {
+    RunInfo info = {};
+    strncpy(info.curveName, "Leaded", sizeof(info.curveName) - 1);
+    RunLogPageWriter writer;
+    writer.begin(7, 120, PERIOD_MS, &info);
+    uint32_t count = 0;
+    while (writer.add(makeSample(120 + count))) count++;
+    CHECK(count > 30 && count == writer.getSampleCount());
+
+    uint8_t page[RunLog::PAGE_SIZE];
+    RunEnd end = {RunOutcome::ABORTED, 0, -15};
+    writer.finish(&end, page);
+
+    RunLogPageReader reader;
+    CHECK(reader.open(page));
+    CHECK(reader.getHeader().runId == 7);
+    CHECK(reader.getHeader().firstSample == 120);
+    CHECK(reader.getHeader().samplePeriodMs == PERIOD_MS);
+
+    RunInfo readInfo;
+    RunEnd readEnd;
+    CHECK(reader.getInfo(&readInfo) && strcmp(readInfo.curveName, "Leaded") == 0);
+    CHECK(reader.getEnd(&readEnd) && readEnd.outcome == RunOutcome::ABORTED && readEnd.peakDeciC == -15);
+
+    RunSample sample;
+    uint32_t decoded = 0;
+    while (reader.next(&sample)) {
+        CHECK(sameSample(sample, makeSample(120 + decoded)));
+        decoded++;
+    }
+    CHECK(decoded == count);
+
+    // A page in the middle of a run has neither
+    writer.begin(7, 400, PERIOD_MS, nullptr);
+    CHECK(writer.add(makeSample(400)));
+    writer.finish(nullptr, page);
+    CHECK(reader.open(page));
+    CHECK(!reader.getInfo(&readInfo) && !reader.getEnd(&readEnd));
+    CHECK(reader.next(&sample) && sameSample(sample, makeSample(400)));
+    CHECK(!reader.next(&sample));
+}
+
+static void testWrappedRing() {
+    // Run 2 overwrites the oldest pages of run 1
+    Ring ring(8);
+    ring.record(1, 300, RunOutcome::COMPLETE);
+    uint32_t run1Pages = ring.writePage;
+    ring.record(2, 200, RunOutcome::COMPLETE);
+    CHECK(run1Pages > 4 && ring.writePage < run1Pages);
+
+    // Replay oldest first, as the export does
+    RunLogPageReader reader;
+    bool sawFirstPage = false;
+    uint32_t expected = 0;
+    uint32_t lastRun = 0;
+    for (uint32_t i = 0; i < ring.pages; ++i) {
+        if (!reader.open(ring.pageAt((ring.writePage + i) % ring.pages))) continue;
+        const RunLog::PageHeader& header = reader.getHeader();
+        CHECK(header.runId >= lastRun);
+        if (header.runId != lastRun) {
+            // Run 1 starts part way in; run 2 is complete
+            CHECK(header.runId == 1 ? header.firstSample > 0 : header.firstSample == 0);
+            expected = header.firstSample;
+            lastRun = header.runId;
+        }
+        CHECK(header.firstSample == expected);
+        CHECK(header.samplePeriodMs == PERIOD_MS);
+        RunInfo info;
+        if (reader.getInfo(&info)) sawFirstPage = true;
+
+        RunSample sample;
+        while (reader.next(&sample)) {
+            CHECK(sameSample(sample, makeSample(expected)));
+            expected++;
+        }
+        RunEnd end;
+        if (reader.getEnd(&end)) CHECK(expected == (header.runId == 1 ? 300u : 200u));
+    }
+    CHECK(lastRun == 2 && sawFirstPage);
+}
+
+static void testTornPages() {
+    RunLogPageWriter writer;
+    writer.begin(3, 0, PERIOD_MS, nullptr);
+    for (uint32_t index = 0; writer.add(makeSample(index)); ++index) {}
+    uint8_t written[RunLog::PAGE_SIZE];
+    writer.finish(nullptr, written);
+
+    RunLogPageReader reader;
+    uint8_t page[RunLog::PAGE_SIZE];
+    memset(page, 0xFF, sizeof(page));
+    CHECK(!reader.open(page));
+
+    // A program cut short leaves the tail erased
+    for (size_t tear = 0; tear < RunLog::PAGE_SIZE; tear += 7) {
+        memset(page, 0xFF, sizeof(page));
+        memcpy(page, written, tear);
+        if (memcmp(page, written, sizeof(page)) != 0) CHECK(!reader.open(page));
+    }
+
+    // And a single flipped bit anywhere in the header or samples
+    const RunLog::PageHeader* header = reinterpret_cast<const RunLog::PageHeader*>(written);
+    size_t used = sizeof(RunLog::PageHeader) + header->length;
+    for (size_t bit = 0; bit < used * 8; bit += 5) {
+        memcpy(page, written, sizeof(page));
+        page[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+        CHECK(!reader.open(page));
+    }
+}
+
+int main() {
+    testRoundTrip();
+    testWrappedRing();
+    testTornPages();
+    return checkFailures();
+}
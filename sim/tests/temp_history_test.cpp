@@ -0,0 +1,100 @@
+// TempHistory: the incrementally maintained window statistics against a
+// brute-force recomputation, through ring wrap-around and window resizes.
+
+#include "check.h"
+#include "library/temp_history.h"
+#include <math.h>
+#include <vector>
+
+static std::vector<TempReading> all;
+
+static TempWindowStats bruteForce(uint32_t windowMs) {
+    // The window holds the samples no older than windowMs, and no more than the ring keeps
+    const TempReading& newest = all.back();
+    size_t first = all.size() > TempHistory::CAPACITY ? all.size() - TempHistory::CAPACITY : 0;
+    while (newest.timestamp - all[first].timestamp > windowMs) first++;
+
+    TempWindowStats stats = {};
+    double n = static_cast<double>(all.size() - first);
+    double sumX = 0, sumXX = 0, sumT = 0, sumTT = 0, sumTX = 0;
+    stats.min = stats.max = all[first].currentTemp;
+    for (size_t i = first; i < all.size(); ++i) {
+        double x = all[i].currentTemp;
+        double t = (all[i].timestamp - all[first].timestamp) / 1000.0;
+        sumX += x; sumXX += x * x; sumT += t; sumTT += t * t; sumTX += t * x;
+        stats.min = fminf(stats.min, all[i].currentTemp);
+        stats.max = fmaxf(stats.max, all[i].currentTemp);
+    }
+    stats.count = static_cast<uint32_t>(n);
+    stats.spanMs = newest.timestamp - all[first].timestamp;
+    stats.mean = static_cast<float>(sumX / n);
+    if (n > 1) {
+        stats.variance = static_cast<float>((sumXX - sumX * sumX / n) / (n - 1));
+        stats.slope = static_cast<float>((n * sumTX - sumT * sumX) / (n * sumTT - sumT * sumT));
+    }
+    return stats;
+}
+
+static void checkWindow(const TempHistory& history, TempWindow window) {
+    TempWindowStats actual;
+    CHECK(history.getStats(window, actual));
+    TempWindowStats expected = bruteForce(history.getWindow(window));
+    CHECK(actual.count == expected.count);
+    CHECK(actual.spanMs == expected.spanMs);
+    CHECK_NEAR(actual.mean, expected.mean, 1e-3);
+    CHECK_NEAR(actual.variance, expected.variance, 1e-2);
+    CHECK_NEAR(actual.min, expected.min, 0.0);
+    CHECK_NEAR(actual.max, expected.max, 0.0);
+    CHECK_NEAR(actual.slope, expected.slope, 1e-3);
+}
+
+static void testAgainstBruteForce() {
+    TempHistory* history = new TempHistory();
+    CHECK(history->isEmpty());
+    TempWindowStats empty;
+    CHECK(!history->getStats(TempWindow::RATE, empty));
+
+    // Irregular 50-150 ms spacing and a ramp with noise, long enough to wrap the ring twice
+    uint32_t seed = 12345;
+    uint32_t time = 1000;
+    for (int i = 0; i < 2600; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        time += 50 + (seed >> 16) % 101;
+        float temp = 25.0f + i * 0.08f + ((seed >> 8) % 200) / 100.0f;
+        TempReading reading = {temp, time};
+        all.push_back(reading);
+        history->push(reading);
+
+        if (i % 97 == 0 || i == 2599) {
+            checkWindow(*history, TempWindow::DERIVATIVE);
+            checkWindow(*history, TempWindow::RATE);
+            checkWindow(*history, TempWindow::TREND);
+        }
+    }
+
+    CHECK(history->size() == TempHistory::CAPACITY);
+    CHECK(history->latest().timestamp == all.back().timestamp);
+    CHECK(history->at(0).timestamp == all[all.size() - TempHistory::CAPACITY].timestamp);
+
+    TempReading recent[8];
+    CHECK(history->copyRecent(recent, 8) == 8);
+    CHECK(recent[7].timestamp == all.back().timestamp);
+    CHECK(recent[0].timestamp == all[all.size() - 8].timestamp);
+
+    // Resizing rebuilds from what the ring still holds
+    history->setWindow(TempWindow::RATE, 3000);
+    CHECK(history->getWindow(TempWindow::RATE) == 3000);
+    checkWindow(*history, TempWindow::RATE);
+    history->setWindow(TempWindow::RATE, 1000000);
+    checkWindow(*history, TempWindow::RATE);
+
+    history->clear();
+    CHECK(history->isEmpty());
+    CHECK(!history->getStats(TempWindow::TREND, empty));
+    delete history;
+}
+
+int main() {
+    testAgainstBruteForce();
+    return checkFailures();
+}
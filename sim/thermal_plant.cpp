@@ -0,0 +1,76 @@
+#include "thermal_plant.h"
+#include <math.h>
+#include <string.h>
+
+static const PlantParameters PRESETS[] = {
+    // name                heater  chamber element coupling loss  door  slew  amb  tau  noise
+    {"benchtop-toaster",   1700.0f,  380.0f, 120.0f, 12.0f, 3.0f, 30.0f, 80.0f, 25.0f, 1.5f, 0.2f},
+    {"large-convection",   1800.0f, 1100.0f, 300.0f, 15.0f, 4.0f, 40.0f, 60.0f, 25.0f, 2.0f, 0.2f},
+    {"sluggish-element",   1200.0f,  500.0f, 600.0f,  6.0f, 2.5f, 25.0f, 80.0f, 25.0f, 3.0f, 0.3f},
+    {"leaky-door",         1500.0f,  550.0f, 200.0f,  8.0f, 6.0f, 20.0f, 40.0f, 25.0f, 1.5f, 0.2f},
+};
+
+const PlantParameters* PlantParameters::presets() {
+    return PRESETS;
+}
+
+size_t PlantParameters::presetCount() {
+    return sizeof(PRESETS) / sizeof(PRESETS[0]);
+}
+
+const PlantParameters* PlantParameters::findPreset(const char* name) {
+    for (size_t i = 0; i < presetCount(); ++i) {
+        if (strcmp(PRESETS[i].name, name) == 0) return &PRESETS[i];
+    }
+    return nullptr;
+}
+
+ThermalPlant::ThermalPlant(const PlantParameters& params, float startTemp)
+    : params(params),
+      chamberTemp(startTemp),
+      elementTemp(startTemp),
+      sensorTemp(startTemp),
+      doorPercent(0.0f),
+      noiseState(0x12345678u) {}
+
+void ThermalPlant::step(float dtSeconds, bool heaterOn, float doorTarget) {
+    // Servo slews towards the commanded opening
+    float maxMove = params.doorSlewPerSecond * dtSeconds;
+    float doorError = fminf(fmaxf(doorTarget, 0.0f), 100.0f) - doorPercent;
+    doorPercent += fminf(fmaxf(doorError, -maxMove), maxMove);
+
+    float heaterPower = heaterOn ? params.heaterWatts : 0.0f;
+    float elementFlow = params.elementCoupling * (elementTemp - chamberTemp);
+    float lossFlow = (params.lossConductance + params.doorConductance * doorPercent / 100.0f) *
+                     (chamberTemp - params.ambientTemp);
+
+    elementTemp += (heaterPower - elementFlow) / params.elementCapacity * dtSeconds;
+    chamberTemp += (elementFlow - lossFlow) / params.chamberCapacity * dtSeconds;
+
+    float alpha = dtSeconds / (params.sensorTimeConstant + dtSeconds);
+    sensorTemp += alpha * (chamberTemp - sensorTemp);
+}
+
+float ThermalPlant::readThermocouple() {
+    // xorshift32, deterministic so runs are reproducible
+    noiseState ^= noiseState << 13;
+    noiseState ^= noiseState >> 17;
+    noiseState ^= noiseState << 5;
+    float noise = (static_cast<float>(noiseState) / 4294967295.0f * 2.0f - 1.0f) * params.sensorNoise;
+    return roundf((sensorTemp + noise) * 4.0f) / 4.0f;
+}
+
+ThermalCalibrationSummary ThermalPlant::synthesizeCalibration(float gain) const {
+    ThermalCalibrationSummary summary = {};
+    for (size_t t = 0; t < ThermalCalibrationSummary::NUM_TEMP_POINTS; ++t) {
+        float rise = ThermalCalibrationSummary::TEMP_POINTS[t] - params.ambientTemp;
+        for (size_t i = 0; i < ThermalCalibrationSummary::NUM_POWER_LEVELS; ++i) {
+            float level = static_cast<float>(i + 1) / 10.0f;
+            summary.heatingRates[t][i] =
+                gain * (params.heaterWatts * level - params.lossConductance * rise) / params.chamberCapacity;
+            summary.coolingRates[t][i] =
+                gain * (params.lossConductance + params.doorConductance * level) * rise / params.chamberCapacity;
+        }
+    }
+    return summary;
+}
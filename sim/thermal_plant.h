@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+#include "types/calibration_data.h"
+
+// Lumped-mass oven model: a heating element coupled to the chamber/board mass,
+// which loses heat to ambient through the walls and, much faster, through the
+// door. The thermocouple sees the chamber through a first-order lag and the
+// MAX31855's 0.25 °C quantisation.
+struct PlantParameters {
+    const char* name;
+    float heaterWatts;           // Element power at 100 %
+    float chamberCapacity;       // J/K - air, shelf and board
+    float elementCapacity;       // J/K - the element itself
+    float elementCoupling;       // W/K element -> chamber
+    float lossConductance;       // W/K chamber -> ambient, door shut
+    float doorConductance;       // W/K extra at 100 % door
+    float doorSlewPerSecond;     // % per second the servo can move
+    float ambientTemp;           // °C
+    float sensorTimeConstant;    // s
+    float sensorNoise;           // °C peak, uniform
+
+    static const PlantParameters* presets();
+    static size_t presetCount();
+    static const PlantParameters* findPreset(const char* name);
+};
+
+class ThermalPlant {
+public:
+    explicit ThermalPlant(const PlantParameters& params, float startTemp);
+
+    // Advance by dt with the heater fully on or off and the door commanded to 'doorTarget' %
+    void step(float dtSeconds, bool heaterOn, float doorTarget);
+
+    float getChamberTemp() const { return chamberTemp; }
+    float getElementTemp() const { return elementTemp; }
+    float getSensorTemp() const { return sensorTemp; }
+    float getDoorPercent() const { return doorPercent; }
+
+    // Thermocouple reading: lagged, noisy and quantised like a MAX31855 frame
+    float readThermocouple();
+
+    // Tables a calibration run on this plant would produce, scaled by 'gain' to model a
+    // calibration that is off by some factor
+    ThermalCalibrationSummary synthesizeCalibration(float gain = 1.0f) const;
+
+    const PlantParameters& getParameters() const { return params; }
+
+private:
+    PlantParameters params;
+    float chamberTemp;
+    float elementTemp;
+    float sensorTemp;
+    float doorPercent;
+    uint32_t noiseState;
+};
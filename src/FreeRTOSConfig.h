@@ -82,9 +82,17 @@
 #define configUSE_PASSIVE_IDLE_HOOK 0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS 0
+#define configGENERATE_RUN_TIME_STATS 1
 #define configUSE_TRACE_FACILITY 1
 #define configUSE_STATS_FORMATTING_FUNCTIONS 0
+/* Run time is counted in microseconds from the 64-bit system timer, which is
+shared by both cores and never wraps, so no extra timer has to be set up. */
+#define configRUN_TIME_COUNTER_TYPE uint64_t
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#ifndef __ASSEMBLER__
+#include "hardware/timer.h"
+#endif
+#define portGET_RUN_TIME_COUNTER_VALUE() time_us_64()
 
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES 0
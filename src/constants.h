@@ -10,8 +10,8 @@ const int LIGHTS_GPIO = 3; // GPIO pin for the cooling fan tachometer
 const int HEATER_SSR_GPIO = 4; // GPIO pin for the element SSR
 const int SSR_TEMP_GPIO = 5; // GPIO pin for the SSR temperature sensor
 const int BUZZER_GPIO = 6; // GPIO pin for the buzzer
-const int ENCODER_DC_GPIO = 7; // GPIO pin for the encoder data
-const int ENCODER_CLK_GPIO = 8; // GPIO pin for the encoder clock
+const int ENCODER_DC_GPIO = 7; // GPIO pin for the encoder data (quadrature channel A)
+const int ENCODER_CLK_GPIO = 8; // GPIO pin for the encoder clock (channel B, must be DC + 1)
 const int ENCODER_SW_GPIO = 9; // GPIO pin for the encoder switch
 const int DISPLAY_BACKLIGHT_GPIO = 10; // GPIO pin for the display backlight
 const int DISPLAY_SPI_RST_GPIO = 11;  // Reset (RST) – GPIO 13
@@ -34,48 +34,105 @@ const int SERVO_POWER_GPIO = 28; // MOSFET control for servo power
 // Interaction constants
 const int DEBOUNCE_TIME_MS = 50;     // Button debounce time in milliseconds
 const int LONG_PRESS_TIME_MS = 500;   // Long press detection time in milliseconds  
-const int QUEUE_WAIT_TIME_MS = 10;    // Queue wait time in milliseconds
+
+// Quadrature encoder decoder (see quadrature_encoder.pio)
+#define ENCODER_PIO pio2                 // Jump table must sit at offset 0, so the decoder gets its own PIO
+#define ENCODER_PIO_CLOCK_HZ 1000000     // State machine clock, ~140 kHz sampling of both channels
+#define ENCODER_COUNTS_PER_DETENT 2      // Quadrature counts per mechanical click
 
 
 // SPI configurations
-// OPTION 1: Use SPI0 with existing pins (recommended)
-#define DISPLAY_SPI_PORT spi1  // Use SPI0 since pins 14-15 are used
-
-// OPTION 2: Use SPI1 but change pins (alternative)
-// #define DISPLAY_SPI_PORT spi1  // SPI1 typically uses pins 10-13
-// const int DISPLAY_SPI_CLK_GPIO = 10;  // SPI1 clock (SCK)
-// const int DISPLAY_SPI_MOSI_GPIO = 11; // SPI1 data (MOSI)
-#define DISPLAY_SPI_BAUDRATE 1000000 // 1 MHz
-#define THERMOCOUPLE_SPI_PORT spi1
+#define THERMOCOUPLE_SPI_PORT spi0  // GPIO 16 (RX) / 18 (SCK) are SPI0 pins
 #define THERMOCOUPLE_SPI_BAUDRATE 1000000 // 1 MHz
+#define THERMOCOUPLE_SAMPLE_RATE_HZ 20    // DMA acquisition rate (MAX31855 converts every ~100ms)
+#define THERMOCOUPLE_TIMEOUT_MS 500       // No frame for this long flags a sensor error
+
+// Thermocouple history windows (see TempWindow)
+#define TEMP_WINDOW_DERIVATIVE_MS 1000
+#define TEMP_WINDOW_RATE_MS 10000
+#define TEMP_WINDOW_TREND_MS 45000        // Must fit in TempHistory::CAPACITY samples
 
 // I2C configurations for ambient temperature sensor
 #define AMBIENT_TEMP_I2C_PORT i2c0
 #define SHT30_I2C_ADDR 0x44
 #define AMBIENT_TEMP_I2C_BAUDRATE 400000 // 400 kHz
 
+// Slow sensor pipelines (start conversion, yield, collect later)
+#define AMBIENT_SAMPLE_INTERVAL_MS 2000   // SHT30 ambient temperature / humidity
+#define SSR_TEMP_SAMPLE_INTERVAL_MS 1000  // DS18B20 on the SSR heatsink
+
 // Control constants
 #define MIN_COOLING_CHANGE_INTERVAL 250
 #define HEATER_CONTROL_PERIOD_MS 250  // 250ms time-proportional control window
-#define TEMPERATURE_CONTROL_KP 1.0f   // Proportional control constant
+#define CONTROL_OVERRUN_ACTION ControlOverrunAction::COUNT  // Reaction to a missed control deadline
+#define CONTROL_OVERRUN_LIMIT 3       // Consecutive misses before STOP_HEATING / HALT act
+
+// Heater SSR output stage
+#define HEATER_SSR_WINDOW_MS HEATER_CONTROL_PERIOD_MS  // Time-proportional window
+#define HEATER_SSR_RESOLUTION 100                      // Steps per window
+#define HEATER_SSR_BURST_FIRE false                    // Switch whole mains cycles instead of a time window
+#define MAINS_FREQUENCY_HZ 50
 
 // PID control constants
 #define REFLOW_PID_PROPORTIONAL_GAIN 2.0f
 #define REFLOW_PID_INTEGRAL_GAIN 0.1f
 #define REFLOW_PID_DERIVATIVE_GAIN 0.5f
+#define REFLOW_PID_DERIVATIVE_FILTER_S 1.0f  // Low-pass time constant on the derivative term
+#define REFLOW_PID_INTEGRAL_MIN -20.0f       // Integral clamp in % output
+#define REFLOW_PID_INTEGRAL_MAX 100.0f
+#define REFLOW_FEEDFORWARD_HORIZON_S 5.0f    // Lookahead used when planning heater power / door from the calibration model
+#define COOLING_DOOR_GAIN 2.0f               // Door % per °C above target, on top of the feed-forward opening
 
 // Settings constants
-#define SETTINGS_MAGIC 0xDEADBEEF
-#define FLASH_TARGET_OFFSET 0x100000
-#define CALIBRATION_FLASH_OFFSET 0x100000  // Adjust based on your flash layout
+#define SETTINGS_MAGIC 0xDEADBEEF          // Marks the sectors of the settings store
+#define SETTINGS_FLASH_OFFSET 0x100000     // Settings store region, from the start of flash
+#define SETTINGS_FLASH_SECTORS 4           // 4 KB sectors in the settings ring
+
+// Flash writes (see FlashService). Costs are the flash's typical times with margin,
+// used to plan windows; the real blackout is measured.
+#define FLASH_SECTOR_ERASE_US 60000        // One 4 KB sector erase
+#define FLASH_PAGE_PROGRAM_US 1000         // One 256 byte page program
+#define FLASH_WINDOW_BUDGET_US 100000      // Longest planned blackout of the other core
+#define FLASH_WINDOW_MARGIN_US 20000       // Kept free before the next control loop release
+#define FLASH_LOCKOUT_TIMEOUT_MS 10        // Wait for the other core to park
+#define FLASH_OP_TIMEOUT_MS 5000           // Give up on a batch the control loop never schedules
+
+// Reflow run recorder (see RunRecorderService)
+#define RUN_LOG_FLASH_OFFSET 0x110000      // Past the settings store
+#define RUN_LOG_FLASH_SIZE (256 * 1024)    // About 5 B per sample: ~100 seven-minute runs at 1 Hz
+#define RUN_LOG_SAMPLE_PERIOD_MS 1000      // Default sample period; a change applies from the next run
+
+// Reflow profile catalogue (see ProfileService)
+#define PROFILE_STORE_FLASH_OFFSET 0x150000  // Past the run log
+#define PROFILE_STORE_SECTORS 16             // One profile per 256 byte page: 235 profiles
+#define PROFILE_MAX_TEMP_C 300.0f            // Uploaded curves may not ask for more
+#define PROFILE_MIN_START_TEMP_C 50.0f       // As the built-in curves
 
 // Display Configuration
-#define DISPLAY_SPI_FREQ 20000000  // 40MHz
+#define DISPLAY_PIO pio1  // ST7789 write path (pio0 runs the servo and SSR)
+#define DISPLAY_PIO_FREQ 62500000  // SCK ceiling, the ST7789 write-cycle limit (37.5 MHz at 150 MHz clk_sys)
 #define DISPLAY_WIDTH 320
 #define DISPLAY_HEIGHT 240
 #define DISPLAY_X_OFFSET 0
 #define DISPLAY_Y_OFFSET 0
 #define DISPLAY_ROTATION ST7789_TFT::TFT_Degrees_90  // Rotate 90 degrees for landscape orientation
 #define DISPLAY_BACKLIGHT_PWM_WRAP 65535
+#define DISPLAY_BUFFER_LINES 20          // Lines per LVGL render buffer (two buffers)
+#define DISPLAY_FLUSH_TIMEOUT_MS 100     // Give up waiting on a stuck flush DMA
+#define UI_RENDER_MAX_SLEEP_MS 500       // Longest the UI task sleeps with no LVGL timer due
+#define RENDER_STATS_WINDOW_MS 1000      // Frame time / idle statistics window
+#define UI_BINDING_REFRESH_MS 250        // How often views re-read their bound live values
+#define UI_VIEW_CACHE_PERCENT 25         // Share of LV_MEM_SIZE that built controller views may hold
+
+// Runtime diagnostics
+#define DIAGNOSTICS_PERIOD_MS 1000       // CPU load / stack / heap sampling window
+#define DIAGNOSTICS_MAX_TASKS 16         // Tasks reported, keep in step with Diagnostics.tasks in message.options
+
+// Binary telemetry (see TelemetryService)
+#define TELEMETRY_UART uart0             // Shared with stdio
+#define TELEMETRY_BAUDRATE 921600
+#define TELEMETRY_RATE_HZ 10             // SystemStatus frames per second, 0 disables the feed
+#define TELEMETRY_TX_TIMEOUT_MS 20       // Drop a frame if the previous one is still being sent
+#define TELEMETRY_RX_BUFFER_SIZE 512     // Bytes from the host not yet decoded; a frame is at most ~270
 
 
@@ -0,0 +1,102 @@
+#include "diagnostics_controller.h"
+#include "services/diagnostics_service.h"
+#include "services/run_recorder_service.h"
+#include "constants.h"
+
+#define DIAGNOSTICS_SCROLL_STEP 40  // Pixels per encoder detent
+
+static uint32_t snapshotSequence() {
+    return DiagnosticsService::getInstance().getSequence();
+}
+
+static void applySummary(lv_obj_t* label, const uint32_t&) {
+    DiagnosticsSnapshot snapshot = DiagnosticsService::getInstance().getSnapshot();
+    lv_label_set_text_fmt(label, "CPU0 %u.%u%%   CPU1 %u.%u%%\nHeap %lu B free, %lu B lowest",
+        snapshot.coreLoadPermille[0] / 10, snapshot.coreLoadPermille[0] % 10,
+        snapshot.coreLoadPermille[1] / 10, snapshot.coreLoadPermille[1] % 10,
+        static_cast<unsigned long>(snapshot.heapFreeBytes),
+        static_cast<unsigned long>(snapshot.heapMinFreeBytes));
+}
+
+static void applyControlLoop(lv_obj_t* label, const uint32_t&) {
+    LoopTrace loop = DiagnosticsService::getInstance().getSnapshot().controlLoop;
+    lv_label_set_text_fmt(label, "Control loop %lu-%lu us, late p99 <%lu us\nExec max %lu us, %lu missed deadlines",
+        static_cast<unsigned long>(loop.periodMinUs),
+        static_cast<unsigned long>(loop.periodMaxUs),
+        static_cast<unsigned long>(loop.lateness.percentileUs(99.0f)),
+        static_cast<unsigned long>(loop.execution.maxUs),
+        static_cast<unsigned long>(loop.deadlineMisses));
+}
+
+static void applyTasks(lv_obj_t* table, const uint32_t&) {
+    DiagnosticsSnapshot snapshot = DiagnosticsService::getInstance().getSnapshot();
+    lv_table_set_row_count(table, snapshot.taskCount + 1);
+
+    for (uint8_t i = 0; i < snapshot.taskCount; ++i) {
+        const TaskDiagnostics& task = snapshot.tasks[i];
+        uint32_t row = i + 1;
+        lv_table_set_cell_value(table, row, 0, task.name);
+        lv_table_set_cell_value_fmt(table, row, 1, "%u.%u%%", task.cpuPermille / 10, task.cpuPermille % 10);
+        lv_table_set_cell_value_fmt(table, row, 2, "%lu", static_cast<unsigned long>(task.stackHighWater));
+        lv_table_set_cell_value(table, row, 3, task.coreAffinity == 0x3 ? "any" : (task.coreAffinity == 0x1 ? "0" : "1"));
+    }
+}
+
+DiagnosticsController& DiagnosticsController::getInstance() {
+    static DiagnosticsController instance;
+    return instance;
+}
+
+void DiagnosticsController::buildView(lv_obj_t* parent) {
+    page = lv_obj_create(parent);
+    lv_obj_set_size(page, lv_obj_get_width(parent), lv_obj_get_height(parent));
+    lv_obj_set_style_bg_color(page, lv_color_hex(0x202020), LV_PART_MAIN);
+    lv_obj_set_style_text_color(page, lv_color_hex(0xDDDDDD), LV_PART_MAIN);
+    lv_obj_set_layout(page, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(page, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_scroll_dir(page, LV_DIR_VER);
+    lv_obj_set_style_pad_row(page, 8, 0);
+    lv_obj_set_style_pad_all(page, 10, 0);
+
+    lv_obj_t* title = lv_label_create(page);
+    lv_label_set_text(title, "Diagnostics");
+    lv_obj_set_style_text_color(title, lv_color_hex(0xFFFFFF), 0);
+
+    // Every widget follows the published snapshot, so nothing is redrawn between samples
+    lv_obj_t* summary = lv_label_create(page);
+    bindings.bind<uint32_t>(summary, snapshotSequence, applySummary);
+
+    lv_obj_t* controlLoop = lv_label_create(page);
+    bindings.bind<uint32_t>(controlLoop, snapshotSequence, applyControlLoop);
+
+    lv_obj_t* tasks = lv_table_create(page);
+    lv_table_set_column_count(tasks, 4);
+    lv_table_set_column_width(tasks, 0, 120);
+    lv_table_set_column_width(tasks, 1, 60);
+    lv_table_set_column_width(tasks, 2, 60);
+    lv_table_set_column_width(tasks, 3, 40);
+    lv_obj_set_style_pad_ver(tasks, 2, LV_PART_ITEMS);
+    lv_table_set_cell_value(tasks, 0, 0, "Task");
+    lv_table_set_cell_value(tasks, 0, 1, "CPU");
+    lv_table_set_cell_value(tasks, 0, 2, "Stack");
+    lv_table_set_cell_value(tasks, 0, 3, "Core");
+    bindings.bind<uint32_t>(tasks, snapshotSequence, applyTasks);
+
+    setBindingRefreshPeriod(UI_BINDING_REFRESH_MS);
+}
+
+void DiagnosticsController::didReleaseView() {
+    page = nullptr;
+}
+
+void DiagnosticsController::onEncoderTurn(int steps) {
+    if (page) lv_obj_scroll_by_bounded(page, 0, steps * DIAGNOSTICS_SCROLL_STEP, LV_ANIM_ON);
+}
+
+void DiagnosticsController::onEncoderPress() {
+    RunRecorderService::getInstance().requestExport();
+}
+
+void DiagnosticsController::onEncoderLongPress() {
+    navigateTo("home", 300, TransitionDirection::SLIDE_OUT_RIGHT);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "core/controller.h"
+#include "lvgl.h"
+
+// Live CPU load, task table, heap and control loop timing from
+// DiagnosticsService. Turning the encoder scrolls, a press streams the run log
+// out over telemetry, a long press goes home.
+class DiagnosticsController : public Controller {
+public:
+    static DiagnosticsController& getInstance();
+
+    void buildView(lv_obj_t* parent) override;
+    void didReleaseView() override;
+
+    void onEncoderTurn(int steps) override;
+    void onEncoderPress() override;
+    void onEncoderLongPress() override;
+
+private:
+    DiagnosticsController() = default;
+
+    lv_obj_t* page = nullptr;
+};
@@ -1,6 +1,20 @@
 #include "main_menu_controller.h"
 #include "services/door_service.h"
 #include "services/buzzer_service.h"
+#include "services/sensor_service.h"
+#include "constants.h"
+#include <stdlib.h>
+#include <math.h>
+
+static void applyButtonFocus(lv_obj_t* btn, const bool& focused) {
+    if (focused) {
+        lv_obj_set_style_bg_color(btn, lv_color_hex(0x0080FF), LV_PART_MAIN);
+        lv_obj_set_style_text_color(btn, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
+    } else {
+        lv_obj_set_style_bg_color(btn, lv_color_hex(0x404040), LV_PART_MAIN);
+        lv_obj_set_style_text_color(btn, lv_color_hex(0xDDDDDD), LV_PART_MAIN);
+    }
+}
 
 MainMenuController& MainMenuController::getInstance() {
     static MainMenuController instance;
@@ -14,8 +28,8 @@ void MainMenuController::buildView(lv_obj_t* parent) {
     printf("Cleared buttons\n");
 
     // Create scrollable menu inside parent
-    menu = lv_obj_create(lv_scr_act());
-    lv_obj_set_size(menu, lv_obj_get_width(lv_scr_act()), lv_obj_get_height(lv_scr_act()));
+    menu = lv_obj_create(parent);
+    lv_obj_set_size(menu, lv_obj_get_width(parent), lv_obj_get_height(parent));
     lv_obj_set_style_bg_color(menu, lv_color_hex(0x202020), LV_PART_MAIN);
 
     // Set flex layout and enable vertical scrolling
@@ -33,7 +47,18 @@ void MainMenuController::buildView(lv_obj_t* parent) {
     lv_label_set_text(title, "Reflow Oven");
     lv_obj_set_style_text_font(title, LV_FONT_DEFAULT, 0);
     lv_obj_set_style_text_color(title, lv_color_hex(0xFFFFFF), 0);
-    lv_obj_set_style_pad_bottom(title, 20, 0);
+    lv_obj_set_style_pad_bottom(title, 4, 0);
+
+    // Live oven temperature, redrawn only when the shown tenth changes
+    lv_obj_t* temperature = lv_label_create(menu);
+    lv_obj_set_style_text_color(temperature, lv_color_hex(0xDDDDDD), 0);
+    lv_obj_set_style_pad_bottom(temperature, 16, 0);
+    bindings.bindFloat(temperature, 0.1f,
+        [] { return SensorService::getInstance().getLatestThermocoupleReading().currentTemp; },
+        [](lv_obj_t* label, float temp) {
+            long tenths = lroundf(temp * 10.0f);
+            lv_label_set_text_fmt(label, "Oven %s%ld.%ld °C", tenths < 0 ? "-" : "", labs(tenths) / 10, labs(tenths) % 10);
+        });
 
     // Menu items
     const char* items[] = {
@@ -53,34 +78,19 @@ void MainMenuController::buildView(lv_obj_t* parent) {
         lv_label_set_text(label, items[i]);
         lv_obj_center(label);
 
-        if (i == selectedIndex) {
-            lv_obj_set_style_bg_color(btn, lv_color_hex(0x0080FF), LV_PART_MAIN);
-            lv_obj_set_style_text_color(btn, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-        } else {
-            lv_obj_set_style_bg_color(btn, lv_color_hex(0x404040), LV_PART_MAIN);
-            lv_obj_set_style_text_color(btn, lv_color_hex(0xDDDDDD), LV_PART_MAIN);
-        }
-
+        bindings.bind<bool>(btn, [this, i] { return selectedIndex == i; }, applyButtonFocus);
         buttons.push_back(btn);
     }
+
+    setBindingRefreshPeriod(UI_BINDING_REFRESH_MS);
 }
 
 
 void MainMenuController::updateButtonFocus() {
     if (!menu || buttons.empty()) return;
 
-    for (int i = 0; i < static_cast<int>(buttons.size()); ++i) {
-        lv_obj_t* btn = buttons[i];
-        if (!lv_obj_is_valid(btn)) continue;
-
-        if (i == selectedIndex) {
-            lv_obj_set_style_bg_color(btn, lv_color_hex(0x0080FF), LV_PART_MAIN);
-            lv_obj_set_style_text_color(btn, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-        } else {
-            lv_obj_set_style_bg_color(btn, lv_color_hex(0x404040), LV_PART_MAIN);
-            lv_obj_set_style_text_color(btn, lv_color_hex(0xDDDDDD), LV_PART_MAIN);
-        }
-    }
+    // Only the two buttons whose focus flipped are restyled
+    bindings.refresh();
 }
 
 void MainMenuController::init() {}
@@ -111,8 +121,21 @@ void MainMenuController::onEncoderDown() {
     }
 }
 
+void MainMenuController::onEncoderTurn(int steps) {
+    // A fast spin arrives as one batch: move the focus once, clamped to the list
+    int last = static_cast<int>(buttons.size()) - 1;
+    if (last < 0) return;
+    int index = selectedIndex - steps;
+    index = index < 0 ? 0 : (index > last ? last : index);
+    if (index == selectedIndex) return;
+
+    selectedIndex = index;
+    updateButtonFocus();
+}
+
 void MainMenuController::onEncoderLongPress() {
-    // No back action in main menu
+    // No back action in main menu; the long press opens the diagnostics screen instead
+    navigateTo("diagnostics", 300, TransitionDirection::SLIDE_OUT_LEFT);
 }
 
 void MainMenuController::selectReflowCurve() {
@@ -140,10 +163,11 @@ void MainMenuController::toggleDoor() {
 }
 
 void MainMenuController::willUnload() {
-    if (menu) {
-        lv_obj_del(menu);
-        menu = nullptr;
-    }
-    buttons.clear();
+    // The view stays cached; coming back starts at the top of the menu
     selectedIndex = 0;
 }
+
+void MainMenuController::didReleaseView() {
+    menu = nullptr;
+    buttons.clear();
+}
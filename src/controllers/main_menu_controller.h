@@ -11,10 +11,12 @@ public:
     void buildView(lv_obj_t* parent) override;
     void init() override;
     void willUnload() override;
+    void didReleaseView() override;
 
     void onEncoderPress() override;
     void onEncoderUp() override;
     void onEncoderDown() override;
+    void onEncoderTurn(int steps) override;
     void onEncoderLongPress() override;
 
     // UI action methods
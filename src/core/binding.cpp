@@ -0,0 +1,34 @@
+#include "binding.h"
+
+Binding::Binding(lv_obj_t* widget) : widget(widget) {
+    lv_obj_add_event_cb(widget, widgetDeleted, LV_EVENT_DELETE, this);
+}
+
+Binding::~Binding() {
+    if (widget) {
+        lv_obj_remove_event_cb_with_user_data(widget, widgetDeleted, this);
+    }
+}
+
+void Binding::widgetDeleted(lv_event_t* e) {
+    auto* binding = static_cast<Binding*>(lv_event_get_user_data(e));
+    binding->widget = nullptr;
+}
+
+size_t BindingSet::refresh(bool force) {
+    size_t updated = 0;
+    for (auto& binding : bindings) {
+        if (binding->refresh(force)) updated++;
+    }
+    return updated;
+}
+
+void BindingSet::clear() {
+    bindings.clear();
+}
+
+void BindingSet::add(std::unique_ptr<Binding> binding) {
+    // Put the current value on screen straight away
+    binding->refresh(true);
+    bindings.push_back(std::move(binding));
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <limits.h>
+#include <math.h>
+#include "lvgl.h"
+
+// A widget that shows one value read from a model or service. refresh() reads
+// the source and only calls apply() - and so only invalidates the widget - when
+// the value differs from what is on screen.
+class Binding {
+public:
+    explicit Binding(lv_obj_t* widget);
+    virtual ~Binding();
+
+    Binding(const Binding&) = delete;
+    Binding& operator=(const Binding&) = delete;
+
+    // Returns true if the widget was touched
+    virtual bool refresh(bool force) = 0;
+
+protected:
+    lv_obj_t* widget;
+
+private:
+    static void widgetDeleted(lv_event_t* e);
+};
+
+template <typename T>
+class ValueBinding : public Binding {
+public:
+    using Read = std::function<T()>;
+    using Apply = std::function<void(lv_obj_t*, const T&)>;
+
+    ValueBinding(lv_obj_t* widget, Read read, Apply apply)
+        : Binding(widget), read(std::move(read)), apply(std::move(apply)) {}
+
+    bool refresh(bool force) override {
+        if (!widget) return false;
+        T value = read();
+        if (!force && hasValue && value == last) return false;
+        last = value;
+        hasValue = true;
+        apply(widget, value);
+        return true;
+    }
+
+private:
+    Read read;
+    Apply apply;
+    T last{};
+    bool hasValue = false;
+};
+
+// Float source compared at display resolution, so sensor noise below the last
+// shown digit does not redraw the widget
+class FloatBinding : public Binding {
+public:
+    using Read = std::function<float()>;
+    using Apply = std::function<void(lv_obj_t*, float)>;
+
+    FloatBinding(lv_obj_t* widget, float resolution, Read read, Apply apply)
+        : Binding(widget), resolution(resolution), read(std::move(read)), apply(std::move(apply)) {}
+
+    bool refresh(bool force) override {
+        if (!widget) return false;
+        float value = read();
+        long step = isfinite(value) ? lroundf(value / resolution) : LONG_MIN;
+        if (!force && hasValue && step == lastStep) return false;
+        lastStep = step;
+        hasValue = true;
+        apply(widget, value);
+        return true;
+    }
+
+private:
+    float resolution;
+    Read read;
+    Apply apply;
+    long lastStep = 0;
+    bool hasValue = false;
+};
+
+// The bindings of one controller's view. Bindings detach themselves when
+// their widget is deleted, so a stale binding is skipped rather than touching
+// freed LVGL memory.
+class BindingSet {
+public:
+    template <typename T>
+    void bind(lv_obj_t* widget, typename ValueBinding<T>::Read read, typename ValueBinding<T>::Apply apply) {
+        add(std::unique_ptr<Binding>(new ValueBinding<T>(widget, std::move(read), std::move(apply))));
+    }
+
+    void bindFloat(lv_obj_t* widget, float resolution, FloatBinding::Read read, FloatBinding::Apply apply) {
+        add(std::unique_ptr<Binding>(new FloatBinding(widget, resolution, std::move(read), std::move(apply))));
+    }
+
+    // Returns the number of widgets updated
+    size_t refresh(bool force = false);
+    void clear();
+    bool isEmpty() const { return bindings.empty(); }
+
+private:
+    void add(std::unique_ptr<Binding> binding);
+
+    std::vector<std::unique_ptr<Binding>> bindings;
+};
@@ -13,7 +13,13 @@ void Controller::invalidateView() {
     }
 }
 
+void Controller::onEncoderTurn(int steps) {
+    for (; steps > 0; --steps) onEncoderUp();
+    for (; steps < 0; ++steps) onEncoderDown();
+}
+
 void Controller::render(lv_obj_t* parent) {
+    bindings.clear();
     if (rootView && lv_obj_is_valid(rootView)) {
         lv_obj_del(rootView);
     }
@@ -23,4 +29,59 @@ void Controller::render(lv_obj_t* parent) {
     lv_obj_set_size(rootView, lv_obj_get_width(parent), lv_obj_get_height(parent));
 
     buildView(rootView); // <-- subclasses must implement this
+
+    if (bindingTimer && !bindings.isEmpty()) {
+        lv_timer_resume(bindingTimer);
+    }
+}
+
+bool Controller::hasView() const {
+    return rootView && lv_obj_is_valid(rootView);
+}
+
+void Controller::releaseView() {
+    suspendBindings();
+    bindings.clear();
+    if (hasView()) {
+        lv_obj_del(rootView);
+    }
+    rootView = nullptr;
+    didReleaseView();
+}
+
+void Controller::refreshBindings() {
+    bindings.refresh();
+}
+
+void Controller::suspendBindings() {
+    if (bindingTimer) lv_timer_pause(bindingTimer);
+}
+
+void Controller::resumeBindings() {
+    bindings.refresh();
+    if (bindingTimer && !bindings.isEmpty()) {
+        lv_timer_resume(bindingTimer);
+    }
+}
+
+void Controller::setBindingRefreshPeriod(uint32_t periodMs) {
+    bindingRefreshMs = periodMs;
+    if (periodMs == 0) {
+        if (bindingTimer) {
+            lv_timer_delete(bindingTimer);
+            bindingTimer = nullptr;
+        }
+        return;
+    }
+
+    if (bindingTimer) {
+        lv_timer_set_period(bindingTimer, periodMs);
+    } else {
+        bindingTimer = lv_timer_create(bindingTimerCallback, periodMs, this);
+    }
+}
+
+void Controller::bindingTimerCallback(lv_timer_t* timer) {
+    auto* controller = static_cast<Controller*>(lv_timer_get_user_data(timer));
+    controller->refreshBindings();
 }
@@ -3,6 +3,7 @@
 #include <string>
 #include "lvgl.h"
 #include "types/transitions.h"
+#include "core/binding.h"
 
 // Forward declarations
 class ControllerCollection;
@@ -12,6 +13,13 @@ protected:
     lv_obj_t* rootView = nullptr;
     ControllerCollection* controllerCollection = nullptr;
 
+    // Widgets that track live values; declare them in buildView(). They are
+    // dropped whenever the view is rebuilt.
+    BindingSet bindings;
+
+    // Poll bound values every 'periodMs' while the view is shown (0 = only on invalidateView)
+    void setBindingRefreshPeriod(uint32_t periodMs);
+
 public:
     virtual ~Controller() = default;
 
@@ -22,6 +30,10 @@ public:
 
     // Return the root LVGL object of this controller
     lv_obj_t* getView() const { return rootView; }
+    bool hasView() const;
+
+    // Delete the view and its bindings; the next navigation rebuilds it
+    void releaseView();
 
     // Called when this controller is about to be hidden or removed
     virtual void willUnload() {}
@@ -29,9 +41,14 @@ public:
     // Called when this controller becomes visible
     virtual void didAppear() {}
 
+    // Called after the view was deleted to free LVGL memory; drop widget pointers here
+    virtual void didReleaseView() {}
+
     // Optional input event handlers
     virtual void onEncoderUp() {}
     virtual void onEncoderDown() {}
+    // Net detents since the last frame; defaults to one up/down call per detent
+    virtual void onEncoderTurn(int steps);
     virtual void onEncoderPress() {}
     virtual void onEncoderLongPress() {}
 
@@ -44,4 +61,18 @@ public:
 
     void navigateTo(const std::string& controllerId, uint32_t duration = 300, TransitionDirection direction = TransitionDirection::SLIDE_IN_LEFT);
     void invalidateView();
+
+    // Re-read every bound value and update only the widgets that changed
+    void refreshBindings();
+    bool hasBindings() const { return !bindings.isEmpty(); }
+    // Stop polling while the view is off screen
+    void suspendBindings();
+    // Catch up on values that changed while hidden and poll again
+    void resumeBindings();
+
+private:
+    static void bindingTimerCallback(lv_timer_t* timer);
+
+    lv_timer_t* bindingTimer = nullptr;
+    uint32_t bindingRefreshMs = 0;
 };
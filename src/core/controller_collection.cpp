@@ -1,6 +1,8 @@
 #include "controller_collection.h"
 #include "controller.h"
+#include "constants.h"
 #include <map>
+#include <vector>
 
 static void setXPosition(void* obj, int32_t v) {
     lv_obj_set_x(static_cast<lv_obj_t*>(obj), v);
@@ -10,37 +12,143 @@ static void setOpacity(void* obj, int32_t v) {
     lv_obj_set_style_opa(static_cast<lv_obj_t*>(obj), v, 0);
 }
 
+static void hideWhenDone(lv_anim_t* anim) {
+    lv_obj_t* view = static_cast<lv_obj_t*>(lv_anim_get_user_data(anim));
+    if (view) lv_obj_add_flag(view, LV_OBJ_FLAG_HIDDEN);
+}
+
+// Stops any transition running on 'view'. Its completed callback will not run, so
+// the view it was uncovering is hidden and put back in place here instead.
+static void stopTransition(lv_obj_t* view) {
+    lv_anim_t* anim = lv_anim_get(view, nullptr);
+    if (!anim) return;
+    lv_obj_t* outgoing = static_cast<lv_obj_t*>(lv_anim_get_user_data(anim));
+    if (outgoing) {
+        lv_obj_add_flag(outgoing, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_set_x(outgoing, 0);
+        lv_obj_set_style_opa(outgoing, LV_OPA_COVER, 0);
+    }
+    lv_anim_delete(view, nullptr);
+}
+
+static size_t lvglHeapUsed() {
+    lv_mem_monitor_t monitor;
+    lv_mem_monitor(&monitor);
+    return monitor.total_size - monitor.free_size;
+}
+
 class ControllerCollectionImpl {
 public:
+    // Controllers with a built view, least recently shown first
+    struct CachedView {
+        Controller* controller;
+        size_t bytes;  // LVGL heap the view took when it was built
+    };
+
     std::map<std::string, Controller*> controllers;
     Controller* activeController = nullptr;
     lv_obj_t* container = nullptr;
     bool dirty = false;
+    std::vector<CachedView> cache;
+    size_t cacheBudget = static_cast<size_t>(LV_MEM_SIZE) * UI_VIEW_CACHE_PERCENT / 100;
+
+    // Unhide a cached view, or build it if it was never built or has been evicted
+    void show(Controller* controller) {
+        if (controller->hasView()) {
+            lv_obj_t* view = controller->getView();
+            lv_obj_set_x(view, 0);
+            lv_obj_set_style_opa(view, LV_OPA_COVER, 0);
+            lv_obj_remove_flag(view, LV_OBJ_FLAG_HIDDEN);
+            lv_obj_move_foreground(view);
+            controller->resumeBindings();
+            touch(controller);
+            return;
+        }
+        build(controller);
+    }
+
+    void build(Controller* controller) {
+        forget(controller);
+        if (controller->hasView()) controller->releaseView();
+        size_t before = lvglHeapUsed();
+        controller->render(container);
+        size_t after = lvglHeapUsed();
+        cache.push_back({controller, after > before ? after - before : 0});
+    }
+
+    void touch(Controller* controller) {
+        for (size_t i = 0; i < cache.size(); ++i) {
+            if (cache[i].controller != controller) continue;
+            CachedView entry = cache[i];
+            cache.erase(cache.begin() + i);
+            cache.push_back(entry);
+            return;
+        }
+    }
+
+    void forget(Controller* controller) {
+        for (size_t i = 0; i < cache.size(); ++i) {
+            if (cache[i].controller == controller) {
+                cache.erase(cache.begin() + i);
+                return;
+            }
+        }
+    }
+
+    size_t cachedBytes() const {
+        size_t total = 0;
+        for (const CachedView& entry : cache) total += entry.bytes;
+        return total;
+    }
+
+    // Drop the least recently shown views until the cache fits its budget. Only
+    // hidden views go; one still on screen or mid-transition is skipped.
+    void evict() {
+        size_t total = cachedBytes();
+        size_t i = 0;
+        while (total > cacheBudget && i < cache.size()) {
+            Controller* controller = cache[i].controller;
+            if (controller == activeController || !lv_obj_has_flag(controller->getView(), LV_OBJ_FLAG_HIDDEN)) {
+                i++;
+                continue;
+            }
+            total -= cache[i].bytes;
+            cache.erase(cache.begin() + i);
+            controller->releaseView();
+        }
+    }
 
     void animateTransition(Controller* from, Controller* to, uint32_t duration, TransitionDirection direction) {
         if (!to || !container) return;
 
-        lv_obj_t* oldView = from ? from->getView() : nullptr;
+        lv_obj_t* oldView = (from && from->hasView()) ? from->getView() : nullptr;
+
+        // Navigating again before a transition finished: settle it where it is
+        if (oldView) stopTransition(oldView);
+        if (to->hasView()) stopTransition(to->getView());
+
+        if (from) {
+            from->suspendBindings();
+            from->willUnload();
+        }
+
+        show(to);
+        lv_obj_t* newView = to->getView();
 
-        // If no transition or nothing to animate, just replace
+        // If no transition or nothing to animate, just swap
         if (direction == TransitionDirection::NONE || !oldView) {
-            if (from) from->willUnload();
-            lv_obj_clean(container);
-            to->render(container);
+            if (oldView) lv_obj_add_flag(oldView, LV_OBJ_FLAG_HIDDEN);
             to->didAppear();
             return;
         }
 
-        // Render new view off-screen for animation
-        to->render(container);
-        lv_obj_t* newView = to->getView();
-
         switch (direction) {
             case TransitionDirection::SLIDE_IN_LEFT:
                 lv_obj_set_x(newView, -lv_obj_get_width(container));
                 break;
             case TransitionDirection::SLIDE_OUT_LEFT:
-                lv_obj_set_x(newView, 0); // animate old out, new stays
+                // Old view slides away on top of the new one
+                lv_obj_move_foreground(oldView);
                 break;
             case TransitionDirection::FADE:
                 lv_obj_set_style_opa(newView, LV_OPA_TRANSP, 0);
@@ -49,16 +157,18 @@ public:
                 break;
         }
 
-        // Setup animation
+        // Setup animation; the old view is hidden, not deleted, once it is covered
         lv_anim_t anim;
         lv_anim_init(&anim);
         lv_anim_set_time(&anim, duration);
+        lv_anim_set_user_data(&anim, oldView);
+        lv_anim_set_completed_cb(&anim, hideWhenDone);
 
         if (direction == TransitionDirection::SLIDE_IN_LEFT) {
             lv_anim_set_var(&anim, newView);
             lv_anim_set_exec_cb(&anim, setXPosition);
             lv_anim_set_values(&anim, -lv_obj_get_width(container), 0);
-        } else if (direction == TransitionDirection::SLIDE_OUT_LEFT && oldView) {
+        } else if (direction == TransitionDirection::SLIDE_OUT_LEFT) {
             lv_anim_set_var(&anim, oldView);
             lv_anim_set_exec_cb(&anim, setXPosition);
             lv_anim_set_values(&anim, 0, -lv_obj_get_width(container));
@@ -66,11 +176,13 @@ public:
             lv_anim_set_var(&anim, newView);
             lv_anim_set_exec_cb(&anim, setOpacity);
             lv_anim_set_values(&anim, LV_OPA_TRANSP, LV_OPA_COVER);
+        } else {
+            lv_obj_add_flag(oldView, LV_OBJ_FLAG_HIDDEN);
+            to->didAppear();
+            return;
         }
 
         lv_anim_start(&anim);
-
-        if (from) from->willUnload();
         to->didAppear();
     }
 };
@@ -100,6 +212,7 @@ void ControllerCollection::navigateTo(const std::string& id, uint32_t duration,
 
     impl->animateTransition(impl->activeController, next, duration, direction);
     impl->activeController = next;
+    impl->evict();
 }
 
 Controller* ControllerCollection::currentController() const {
@@ -114,6 +227,10 @@ void ControllerCollection::handleEncoderDown() {
     if (impl->activeController) impl->activeController->onEncoderDown();
 }
 
+void ControllerCollection::handleEncoderTurn(int steps) {
+    if (impl->activeController) impl->activeController->onEncoderTurn(steps);
+}
+
 void ControllerCollection::handleEncoderPress() {
     if (impl->activeController) impl->activeController->onEncoderPress();
 }
@@ -131,11 +248,18 @@ bool ControllerCollection::isDirty() const {
 }
 
 void ControllerCollection::invalidateActiveController() {
-    if (impl->activeController && impl->container) {
-        lv_obj_clean(impl->container);
-        impl->activeController->render(impl->container);
+    if (!impl->activeController || !impl->container) return;
+
+    // A view that declares bindings is updated in place; only legacy views are rebuilt
+    if (impl->activeController->hasBindings()) {
+        impl->activeController->refreshBindings();
         impl->dirty = false;
+        return;
     }
+
+    // render() replaces only this controller's own view; cached views stay
+    impl->build(impl->activeController);
+    impl->dirty = false;
 }
 
 void ControllerCollection::update() {
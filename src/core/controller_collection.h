@@ -23,6 +23,7 @@ public:
 
     void handleEncoderUp();
     void handleEncoderDown();
+    void handleEncoderTurn(int steps);
     void handleEncoderPress();
     void handleEncoderLongPress();
 
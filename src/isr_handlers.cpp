@@ -1,9 +1,21 @@
 #include "isr_handlers.h"
 #include "services/interaction_service.h"
+#include "services/sensor_service.h"
+#include "services/ui_view_service.h"
 #include "constants.h"
 
 void sharedISR(uint gpio, uint32_t events) {
-    if (gpio == ENCODER_CLK_GPIO || gpio == ENCODER_DC_GPIO || gpio == ENCODER_SW_GPIO) {
+    if (gpio == ENCODER_SW_GPIO) {
         InteractionService::getInstance().gpioISR(gpio, events);
     }
 }
+
+// DMA_IRQ_0 is enabled on the control core; each owner checks and acks its own channels
+void sharedDma0ISR() {
+    SensorService::getInstance().thermocoupleDmaISR();
+}
+
+// DMA_IRQ_1 is enabled on the UI core
+void sharedDma1ISR() {
+    UIViewService::getInstance().displayDmaISR();
+}
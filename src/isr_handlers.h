@@ -3,4 +3,5 @@
 #include "pico/stdlib.h"
 
 void sharedISR(uint gpio, uint32_t events);
-
+void sharedDma0ISR();
+void sharedDma1ISR();
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stddef.h>
+
+// Read-only, non-owning view of a contiguous array: a pointer and a length.
+// Cheap to pass by value and usable in constant expressions.
+template <typename T>
+class ArrayView {
+public:
+    constexpr ArrayView() : items(nullptr), count(0) {}
+    constexpr ArrayView(const T* items, size_t count) : items(items), count(count) {}
+    template <size_t N>
+    constexpr ArrayView(const T (&array)[N]) : items(array), count(N) {}
+
+    constexpr const T* begin() const { return items; }
+    constexpr const T* end() const { return items + count; }
+    constexpr size_t size() const { return count; }
+    constexpr bool empty() const { return count == 0; }
+    constexpr const T& operator[](size_t index) const { return items[index]; }
+    constexpr const T& back() const { return items[count - 1]; }
+
+private:
+    const T* items;
+    size_t count;
+};
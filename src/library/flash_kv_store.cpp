@@ -0,0 +1,306 @@
+#include "flash_kv_store.h"
+#include <string.h>
+
+FlashKvStore::FlashKvStore(const uint8_t* mapped, uint32_t flashOffset, size_t sectorCount, uint32_t magic,
+                           const FlashOps& ops)
+    : mapped(mapped),
+      flashOffset(flashOffset),
+      sectorCount(static_cast<uint32_t>(sectorCount < 2 ? 2 : (sectorCount > MAX_SECTORS ? MAX_SECTORS : sectorCount))),
+      magic(magic),
+      ops(ops),
+      activeSector(NO_SECTOR),
+      activeGeneration(0),
+      writeOffset(0),
+      nextSequence(1),
+      eraseCount(0),
+      keyCount(0),
+      queuedErases(0),
+      stageOffset(0),
+      stageLength(0) {
+    memset(sectorValid, 0, sizeof(sectorValid));
+}
+
+void FlashKvStore::mount() {
+    queuedErases = 0;
+    stageLength = 0;
+    keyCount = 0;
+    activeSector = NO_SECTOR;
+    activeGeneration = 0;
+    writeOffset = 0;
+    nextSequence = 1;
+
+    // Replay the valid sectors oldest first
+    uint32_t order[MAX_SECTORS];
+    uint32_t generations[MAX_SECTORS];
+    size_t validCount = 0;
+    for (uint32_t sector = 0; sector < sectorCount; ++sector) {
+        uint32_t generation;
+        sectorValid[sector] = readSectorHeader(sector, &generation);
+        if (!sectorValid[sector]) continue;
+
+        size_t slot = validCount++;
+        while (slot > 0 && generations[slot - 1] > generation) {
+            order[slot] = order[slot - 1];
+            generations[slot] = generations[slot - 1];
+            slot--;
+        }
+        order[slot] = sector;
+        generations[slot] = generation;
+    }
+
+    for (size_t i = 0; i < validCount; ++i) {
+        uint32_t end = scanSector(order[i]);
+        activeSector = order[i];
+        activeGeneration = generations[i];
+        writeOffset = end;
+    }
+}
+
+bool FlashKvStore::find(uint16_t key, const uint8_t** value, size_t* length) const {
+    const IndexEntry* entry = findEntry(key);
+    if (!entry) return false;
+
+    RecordHeader header;
+    memcpy(&header, mapped + entry->offset, sizeof(header));
+    *value = mapped + entry->offset + RECORD_HEADER_SIZE;
+    *length = header.length;
+    return true;
+}
+
+bool FlashKvStore::read(uint16_t key, void* value, size_t length) const {
+    const uint8_t* stored;
+    size_t storedLength;
+    if (!find(key, &stored, &storedLength) || storedLength != length) return false;
+    memcpy(value, stored, length);
+    return true;
+}
+
+bool FlashKvStore::write(uint16_t key, const void* value, size_t length) {
+    if (length > MAX_VALUE_SIZE) return false;
+
+    size_t pages = (RECORD_HEADER_SIZE + length + PAGE_SIZE - 1) / PAGE_SIZE;
+    const IndexEntry* existing = findEntry(key);
+    if (!existing && keyCount >= MAX_KEYS) return false;
+
+    // Everything live has to fit in a fresh sector, or the next rotation could not copy it forward
+    size_t live = livePages() - (existing ? existing->pages : 0) + pages;
+    if (live > PAGES_PER_SECTOR - 1) return false;
+
+    // An empty region starts at its last sector, so the first record never overwrites sector 0
+    bool ok = activeSector != NO_SECTOR || openSector(sectorCount - 1);
+
+    // Finish a rotation that lost power before its last sector was reclaimed
+    uint32_t spare = (activeSector + 1) % sectorCount;
+    if (ok && sectorValid[spare]) ok = reclaim(spare);
+
+    if (ok && writeOffset + pages * PAGE_SIZE > (activeSector + 1) * SECTOR_SIZE) ok = rotate();
+
+    ok = ok && append(key, static_cast<const uint8_t*>(value), length) && flush();
+
+    // The index ran ahead of the flash; read back what actually got there
+    if (!ok) mount();
+    return ok;
+}
+
+size_t FlashKvStore::getFreeBytes() const {
+    if (activeSector == NO_SECTOR) return (PAGES_PER_SECTOR - 1) * PAGE_SIZE;
+    return (activeSector + 1) * SECTOR_SIZE - writeOffset;
+}
+
+uint32_t FlashKvStore::crc32(const uint8_t* data, size_t length, uint32_t crc) {
+    crc = ~crc;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+uint32_t FlashKvStore::recordCrc(const RecordHeader& header, const uint8_t* payload) {
+    uint32_t crc = crc32(reinterpret_cast<const uint8_t*>(&header), offsetof(RecordHeader, crc));
+    return crc32(payload, header.length, crc);
+}
+
+bool FlashKvStore::isErased(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+bool FlashKvStore::readSectorHeader(uint32_t sector, uint32_t* generation) const {
+    SectorHeader header;
+    memcpy(&header, sectorAt(sector), sizeof(header));
+    if (header.magic != magic || header.formatVersion != FORMAT_VERSION) return false;
+    if (header.crc != crc32(reinterpret_cast<const uint8_t*>(&header), offsetof(SectorHeader, crc))) return false;
+    *generation = header.generation;
+    return true;
+}
+
+uint32_t FlashKvStore::scanSector(uint32_t sector) {
+    const uint8_t* base = sectorAt(sector);
+    size_t used = 1;  // The sector header page
+
+    size_t page = 1;
+    while (page < PAGES_PER_SECTOR) {
+        const uint8_t* record = base + page * PAGE_SIZE;
+        if (isErased(record, PAGE_SIZE)) {
+            page++;
+            continue;
+        }
+
+        RecordHeader header;
+        memcpy(&header, record, sizeof(header));
+        bool valid = header.magic == RECORD_MAGIC
+            && header.pages > 0
+            && page + header.pages <= PAGES_PER_SECTOR
+            && RECORD_HEADER_SIZE + header.length <= header.pages * PAGE_SIZE
+            && header.crc == recordCrc(header, record + RECORD_HEADER_SIZE);
+
+        // A torn write only costs the pages it touched
+        size_t span = valid ? header.pages : 1;
+        if (valid) {
+            IndexEntry* entry = findEntry(header.key);
+            if (!entry && keyCount < MAX_KEYS) {
+                entry = &index[keyCount++];
+                entry->key = header.key;
+                entry->sequence = 0;
+            }
+            if (entry && header.sequence >= entry->sequence) {
+                entry->sequence = header.sequence;
+                entry->pages = header.pages;
+                entry->offset = sector * SECTOR_SIZE + page * PAGE_SIZE;
+            }
+            if (header.sequence >= nextSequence) nextSequence = header.sequence + 1;
+        }
+
+        page += span;
+        used = page;
+    }
+
+    return sector * SECTOR_SIZE + used * PAGE_SIZE;
+}
+
+FlashKvStore::IndexEntry* FlashKvStore::findEntry(uint16_t key) {
+    for (size_t i = 0; i < keyCount; ++i) {
+        if (index[i].key == key) return &index[i];
+    }
+    return nullptr;
+}
+
+const FlashKvStore::IndexEntry* FlashKvStore::findEntry(uint16_t key) const {
+    return const_cast<FlashKvStore*>(this)->findEntry(key);
+}
+
+size_t FlashKvStore::livePages() const {
+    size_t pages = 0;
+    for (size_t i = 0; i < keyCount; ++i) pages += index[i].pages;
+    return pages;
+}
+
+void FlashKvStore::queueErase(uint32_t sector) {
+    for (size_t i = 0; i < queuedErases; ++i) {
+        if (eraseQueue[i] == sector) return;
+    }
+    eraseQueue[queuedErases++] = sector;
+    eraseCount++;
+}
+
+uint8_t* FlashKvStore::stagePages(uint32_t offset, size_t size) {
+    if (stageLength == 0) stageOffset = offset;
+    if (offset != stageOffset + stageLength || stageLength + size > SECTOR_SIZE) return nullptr;
+
+    uint8_t* pages = stage + stageLength;
+    memset(pages, 0xFF, size);
+    stageLength += size;
+    return pages;
+}
+
+bool FlashKvStore::flush() {
+    FlashOp batch[MAX_BATCH_ERASES + 1];
+    size_t count = 0;
+    for (size_t i = 0; i < queuedErases; ++i) {
+        batch[count++] = {true, flashOffset + eraseQueue[i] * static_cast<uint32_t>(SECTOR_SIZE), nullptr, SECTOR_SIZE};
+    }
+    if (stageLength > 0) batch[count++] = {false, flashOffset + stageOffset, stage, stageLength};
+
+    bool ok = count == 0 || ops.execute(batch, count, ops.context);
+    ok = ok && memcmp(mapped + stageOffset, stage, stageLength) == 0;
+    queuedErases = 0;
+    stageLength = 0;
+    return ok;
+}
+
+bool FlashKvStore::openSector(uint32_t sector) {
+    uint32_t offset = sector * SECTOR_SIZE;
+    queueErase(sector);
+
+    SectorHeader header = {magic, FORMAT_VERSION, 0xFFFF, activeGeneration + 1, 0};
+    header.crc = crc32(reinterpret_cast<const uint8_t*>(&header), offsetof(SectorHeader, crc));
+    uint8_t* page = stagePages(offset, PAGE_SIZE);
+    if (!page) return false;
+    memcpy(page, &header, sizeof(header));
+
+    sectorValid[sector] = true;
+    activeSector = sector;
+    activeGeneration = header.generation;
+    writeOffset = offset + PAGE_SIZE;
+    return true;
+}
+
+bool FlashKvStore::reclaim(uint32_t sector) {
+    uint32_t start = sector * SECTOR_SIZE;
+
+    // Copy forward whatever is still current in this sector, then it can go
+    for (size_t i = 0; i < keyCount; ++i) {
+        IndexEntry& entry = index[i];
+        if (entry.offset < start || entry.offset >= start + SECTOR_SIZE) continue;
+
+        RecordHeader header;
+        memcpy(&header, mapped + entry.offset, sizeof(header));
+        if (!append(header.key, mapped + entry.offset + RECORD_HEADER_SIZE, header.length)) return false;
+    }
+
+    // The copies have to be on the flash before the sector goes; the erase waits for the next batch
+    if (!flush()) return false;
+    queueErase(sector);
+    sectorValid[sector] = false;
+    return true;
+}
+
+bool FlashKvStore::rotate() {
+    uint32_t next = (activeSector + 1) % sectorCount;
+    if (!openSector(next)) return false;
+
+    uint32_t oldest = (next + 1) % sectorCount;
+    return !sectorValid[oldest] || reclaim(oldest);
+}
+
+bool FlashKvStore::append(uint16_t key, const uint8_t* value, size_t length) {
+    size_t pages = (RECORD_HEADER_SIZE + length + PAGE_SIZE - 1) / PAGE_SIZE;
+    size_t size = pages * PAGE_SIZE;
+    if (writeOffset + size > (activeSector + 1) * SECTOR_SIZE) return false;
+
+    RecordHeader header = {RECORD_MAGIC, key, static_cast<uint16_t>(length), static_cast<uint16_t>(pages),
+                           nextSequence, 0};
+    header.crc = recordCrc(header, value);
+
+    uint32_t offset = writeOffset;
+    uint8_t* record = stagePages(offset, size);
+    if (!record) return false;
+    memcpy(record, &header, sizeof(header));
+    if (length > 0) memcpy(record + RECORD_HEADER_SIZE, value, length);
+    writeOffset += size;
+
+    IndexEntry* entry = findEntry(key);
+    if (!entry) {
+        entry = &index[keyCount++];
+        entry->key = key;
+    }
+    entry->sequence = nextSequence++;
+    entry->pages = static_cast<uint16_t>(pages);
+    entry->offset = offset;
+    return true;
+}
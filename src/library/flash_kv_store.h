@@ -0,0 +1,160 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Log-structured key/value store over a ring of flash sectors.
+//
+// Every save appends a record (header, payload, CRC-32) at the next free
+// page of the active sector: one program of ceil((16 + length) / 256) pages
+// and no erase. The record with the highest sequence number wins, so an
+// update never touches the previous copy. When the active sector fills up the
+// store moves on to the next sector in the ring, copies forward whatever
+// still lives only in the sector after that, then erases it, so one erased
+// sector is always ahead of the writer and erases spread evenly over the ring.
+//
+// Power-safe by construction: a record or sector header that was being
+// written when power failed fails its CRC and is ignored on the next mount,
+// and the previous copy is still in place. A sector is only erased once
+// everything live in it has a newer copy. An empty region is started at its
+// last sector, so whatever an older layout left in sector 0 is still there
+// once the first record has been written and verified.
+//
+// Flash work is handed over in batches, so a whole save goes to the flash in
+// as few blackouts as the erases allow: a plain save is one program, and a
+// rotation is two batches, the new sector's erase with its header and the
+// copied records, then the old sector's erase with the new record. The
+// copies are read back before the old sector is erased.
+//
+// No Pico SDK dependencies: the flash is read through its memory-mapped
+// (XIP) window and written through the execute callback, which takes offsets
+// relative to the start of flash.
+class FlashKvStore {
+public:
+    static constexpr size_t SECTOR_SIZE = 4096;
+    static constexpr size_t PAGE_SIZE = 256;
+    static constexpr size_t MAX_SECTORS = 8;
+    static constexpr size_t MAX_KEYS = 16;
+    static constexpr size_t RECORD_HEADER_SIZE = 16;
+    static constexpr size_t MAX_RECORD_SIZE = 4 * PAGE_SIZE;
+    static constexpr size_t MAX_VALUE_SIZE = MAX_RECORD_SIZE - RECORD_HEADER_SIZE;
+
+    // Bumped whenever the on-flash layout changes; older sectors read as blank
+    static constexpr uint16_t FORMAT_VERSION = 1;
+
+    // One step of a batch. 'offset' is from the start of flash; 'data' is in RAM.
+    struct FlashOp {
+        bool erase;            // Else a program of 'data'
+        uint32_t offset;
+        const uint8_t* data;
+        size_t length;
+    };
+
+    // A batch is up to this many erases followed by at most one program
+    static constexpr size_t MAX_BATCH_ERASES = 3;
+
+    struct FlashOps {
+        // Runs the operations in order; false if any of them failed
+        bool (*execute)(const FlashOp* operations, size_t count, void* context);
+        void* context;
+    };
+
+    // 'mapped' is where the region at 'flashOffset' can be read from.
+    // 'sectorCount' is clamped to 2..MAX_SECTORS. 'magic' marks the sectors
+    // as belonging to this store.
+    FlashKvStore(const uint8_t* mapped, uint32_t flashOffset, size_t sectorCount, uint32_t magic,
+                 const FlashOps& ops);
+
+    // Scans the region and rebuilds the key index. Never writes; sectors that
+    // hold no valid header are simply treated as free.
+    void mount();
+
+    // Latest value of 'key'. The pointer is into the XIP window and is only
+    // valid until the next write.
+    bool find(uint16_t key, const uint8_t** value, size_t* length) const;
+    // Copies the latest value; fails if it is missing or not exactly 'length' bytes
+    bool read(uint16_t key, void* value, size_t length) const;
+
+    // Appends a new version of 'key'. Fails if the value is too large, the
+    // live set would no longer fit in one sector, or the flash write fails.
+    bool write(uint16_t key, const void* value, size_t length);
+
+    uint32_t getEraseCount() const { return eraseCount; }
+    size_t getFreeBytes() const;
+
+private:
+    static constexpr size_t PAGES_PER_SECTOR = SECTOR_SIZE / PAGE_SIZE;
+    static constexpr uint16_t RECORD_MAGIC = 0x4B56;  // "VK"
+    static constexpr uint32_t NO_SECTOR = 0xFFFFFFFFu;
+
+    struct SectorHeader {
+        uint32_t magic;        // The store's magic
+        uint16_t formatVersion;
+        uint16_t reserved;
+        uint32_t generation;   // Increases by one per sector opened
+        uint32_t crc;
+    };
+
+    struct RecordHeader {
+        uint16_t magic;        // RECORD_MAGIC
+        uint16_t key;
+        uint16_t length;       // Payload bytes
+        uint16_t pages;        // Pages the record occupies
+        uint32_t sequence;     // Store-wide, increasing; the highest per key wins
+        uint32_t crc;          // CRC-32 of the header up to here and the payload
+    };
+    static_assert(sizeof(RecordHeader) == RECORD_HEADER_SIZE, "record header layout");
+
+    struct IndexEntry {
+        uint16_t key;
+        uint16_t pages;
+        uint32_t sequence;
+        uint32_t offset;       // Of the record header, within the region
+    };
+
+    static uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0);
+    static uint32_t recordCrc(const RecordHeader& header, const uint8_t* payload);
+    static bool isErased(const uint8_t* data, size_t length);
+
+    const uint8_t* sectorAt(uint32_t sector) const { return mapped + sector * SECTOR_SIZE; }
+    bool readSectorHeader(uint32_t sector, uint32_t* generation) const;
+    // Indexes the sector's records; returns the offset just past its last used page
+    uint32_t scanSector(uint32_t sector);
+    IndexEntry* findEntry(uint16_t key);
+    const IndexEntry* findEntry(uint16_t key) const;
+    size_t livePages() const;
+
+    // Batch building: erases run first, then the staged pages, which must be contiguous
+    void queueErase(uint32_t sector);
+    uint8_t* stagePages(uint32_t offset, size_t size);
+    // Runs the batch and reads the staged pages back
+    bool flush();
+
+    bool openSector(uint32_t sector);
+    bool reclaim(uint32_t sector);
+    bool rotate();
+    bool append(uint16_t key, const uint8_t* value, size_t length);
+
+    const uint8_t* mapped;
+    uint32_t flashOffset;
+    uint32_t sectorCount;
+    uint32_t magic;
+    FlashOps ops;
+
+    uint32_t activeSector;
+    uint32_t activeGeneration;
+    uint32_t writeOffset;      // Next free page in the active sector, within the region
+    uint32_t nextSequence;
+    bool sectorValid[MAX_SECTORS];
+    uint32_t eraseCount;
+
+    IndexEntry index[MAX_KEYS];
+    size_t keyCount;
+
+    // Pending batch; index and sector state above already reflect it
+    uint32_t eraseQueue[MAX_BATCH_ERASES];  // Sectors
+    size_t queuedErases;
+    uint32_t stageOffset;      // Within the region
+    size_t stageLength;
+    uint8_t stage[SECTOR_SIZE];
+};
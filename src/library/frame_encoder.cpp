@@ -0,0 +1,119 @@
+#include "library/frame_encoder.h"
+
+namespace {
+
+// Streaming COBS: 'code' is the index of the pending overhead byte, which is
+// filled in once its run of non-zero bytes ends
+struct CobsWriter {
+    uint8_t* out;
+    size_t length;
+    size_t code;
+
+    explicit CobsWriter(uint8_t* buffer) : out(buffer), length(1), code(0) {}
+
+    void put(uint8_t value) {
+        if (value != 0) {
+            out[length++] = value;
+            if (length - code < 0xFF) return;
+        }
+        out[code] = static_cast<uint8_t>(length - code);
+        code = length++;
+    }
+
+    size_t finish() {
+        out[code] = static_cast<uint8_t>(length - code);
+        out[length++] = 0x00;
+        return length;
+    }
+};
+
+}
+
+size_t FrameEncoder::encode(uint8_t type, uint16_t sequence, const uint8_t* payload, size_t length,
+                            uint8_t* out, size_t capacity) {
+    if (capacity < maxEncodedSize(length)) return 0;
+
+    uint8_t header[HEADER_SIZE] = {
+        type,
+        static_cast<uint8_t>(sequence & 0xFF),
+        static_cast<uint8_t>(sequence >> 8)
+    };
+    uint16_t crc = crc16(header, sizeof(header));
+    crc = crc16(payload, length, crc);
+
+    out[0] = 0x00;
+    CobsWriter writer(out + 1);
+    for (uint8_t value : header) writer.put(value);
+    for (size_t i = 0; i < length; ++i) writer.put(payload[i]);
+    writer.put(static_cast<uint8_t>(crc & 0xFF));
+    writer.put(static_cast<uint8_t>(crc >> 8));
+    return 1 + writer.finish();
+}
+
+uint16_t FrameEncoder::crc16(const uint8_t* data, size_t length, uint16_t crc) {
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+FrameDecoder::FrameDecoder(uint8_t* buffer, size_t capacity)
+    : buffer(buffer),
+      capacity(capacity),
+      length(0),
+      frameLength(0),
+      blockLeft(0),
+      zeroPending(false),
+      synced(false),
+      errorCount(0) {}
+
+bool FrameDecoder::push(uint8_t value) {
+    if (value == 0x00) {
+        bool valid = synced && blockLeft == 0 && length >= FrameEncoder::HEADER_SIZE + FrameEncoder::CRC_SIZE;
+        if (valid) {
+            size_t crcAt = length - FrameEncoder::CRC_SIZE;
+            uint16_t received = static_cast<uint16_t>(buffer[crcAt] | (buffer[crcAt + 1] << 8));
+            valid = received == FrameEncoder::crc16(buffer, crcAt);
+        }
+        if (valid) {
+            frameLength = length;
+        } else if (synced && length > 0) {
+            errorCount++;
+        }
+
+        synced = true;
+        length = 0;
+        blockLeft = 0;
+        zeroPending = false;
+        return valid;
+    }
+
+    if (!synced) return false;
+
+    if (blockLeft == 0) {
+        // Code byte: the zero the previous block ended in, then value - 1 data bytes
+        if (zeroPending) {
+            if (length == capacity) {
+                synced = false;
+                errorCount++;
+                return false;
+            }
+            buffer[length++] = 0x00;
+        }
+        blockLeft = value - 1;
+        zeroPending = value != 0xFF;
+        return false;
+    }
+
+    if (length == capacity) {
+        synced = false;
+        errorCount++;
+        return false;
+    }
+    buffer[length++] = value;
+    blockLeft--;
+    return false;
+}
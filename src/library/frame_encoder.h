@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Wire framing for the binary telemetry link. A frame is
+//
+//   0x00 COBS( type | sequence (u16 LE) | payload | CRC-16 (u16 LE) ) 0x00
+//
+// The CRC is CRC-16/CCITT-FALSE over type, sequence and payload. COBS leaves
+// no zero bytes inside a frame, so a receiver resynchronises on the next 0x00
+// after any corruption. Each frame opens with a delimiter as well as closing
+// with one, so stdio text on the same UART is decoded on its own, fails the
+// CRC and costs no frame.
+class FrameEncoder {
+public:
+    static constexpr size_t HEADER_SIZE = 3;
+    static constexpr size_t CRC_SIZE = 2;
+
+    // Worst-case encoded size, delimiter included, for a payload of 'length' bytes
+    static constexpr size_t maxEncodedSize(size_t length) {
+        return (HEADER_SIZE + length + CRC_SIZE) + (HEADER_SIZE + length + CRC_SIZE) / 254 + 3;
+    }
+
+    // Encodes one frame into 'out'. Returns the number of bytes written, or 0 if
+    // 'capacity' is below maxEncodedSize(length).
+    static size_t encode(uint8_t type, uint16_t sequence, const uint8_t* payload, size_t length,
+                         uint8_t* out, size_t capacity);
+
+    static uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF);
+};
+
+// Receiving side of the same framing, fed one byte at a time. Bytes before
+// the first delimiter, frames that overflow the buffer and frames with a bad
+// CRC are dropped.
+class FrameDecoder {
+public:
+    // 'buffer' holds the decoded type, sequence, payload and CRC of a frame;
+    // frames with more than capacity - 5 payload bytes are dropped
+    FrameDecoder(uint8_t* buffer, size_t capacity);
+
+    // True when 'value' completed a valid frame, which stays readable until
+    // the next call
+    bool push(uint8_t value);
+
+    uint8_t getType() const { return buffer[0]; }
+    uint16_t getSequence() const { return static_cast<uint16_t>(buffer[1] | (buffer[2] << 8)); }
+    const uint8_t* getPayload() const { return buffer + FrameEncoder::HEADER_SIZE; }
+    size_t getPayloadLength() const { return frameLength - FrameEncoder::HEADER_SIZE - FrameEncoder::CRC_SIZE; }
+    uint32_t getErrorCount() const { return errorCount; }
+
+private:
+    uint8_t* buffer;
+    size_t capacity;
+    size_t length;          // Decoded bytes of the frame in progress
+    size_t frameLength;     // Decoded bytes of the last valid frame
+    uint8_t blockLeft;      // Data bytes left in the current COBS block, 0 when a code byte is due
+    bool zeroPending;       // The current block ends in an implied zero, unless the frame ends first
+    bool synced;            // A delimiter has been seen since start or overflow
+    uint32_t errorCount;
+};
@@ -0,0 +1,49 @@
+#include "library/input_pipeline.h"
+
+void InputPipeline::addSteps(int32_t count, uint32_t nowUs) {
+    if (count == 0) return;
+    steps.fetch_add(count, std::memory_order_release);
+    stamp(nowUs);
+}
+
+void InputPipeline::addPress(uint32_t nowUs) {
+    presses.fetch_add(1, std::memory_order_release);
+    stamp(nowUs);
+}
+
+void InputPipeline::addLongPress(uint32_t nowUs) {
+    longPresses.fetch_add(1, std::memory_order_release);
+    stamp(nowUs);
+}
+
+void InputPipeline::markPending(uint32_t nowUs) {
+    stamp(nowUs);
+}
+
+void InputPipeline::setStepSource(StepSource source, void* context) {
+    stepSource = source;
+    stepSourceContext = context;
+}
+
+bool InputPipeline::drain(InputBatch& out) {
+    uint32_t first = firstEventUs.exchange(0, std::memory_order_acquire);
+    if (first == 0) return false;
+
+    out.steps = steps.exchange(0, std::memory_order_acquire);
+    if (stepSource) out.steps += stepSource(stepSourceContext);
+    uint32_t pressCount = presses.exchange(0, std::memory_order_acquire);
+    uint32_t longPressCount = longPresses.exchange(0, std::memory_order_acquire);
+    out.presses = static_cast<uint8_t>(pressCount > 255 ? 255 : pressCount);
+    out.longPresses = static_cast<uint8_t>(longPressCount > 255 ? 255 : longPressCount);
+    out.firstEventUs = first;
+
+    // Turning back and forth within one frame can net out to nothing
+    return out.steps != 0 || out.presses != 0 || out.longPresses != 0;
+}
+
+void InputPipeline::stamp(uint32_t nowUs) {
+    // After the counter, so a drain in between never strands a count without a
+    // stamp. Keeps the oldest timestamp; 0 is reserved for "empty".
+    uint32_t expected = 0;
+    firstEventUs.compare_exchange_strong(expected, nowUs ? nowUs : 1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+// Everything the user did since the last frame
+struct InputBatch {
+    int32_t steps;         // Net encoder detents, positive = up
+    uint8_t presses;
+    uint8_t longPresses;
+    uint32_t firstEventUs; // time_us_32() of the oldest event in the batch
+};
+
+// Lock-free accumulator between the input ISRs / timer callbacks and the LVGL
+// thread. Producers only add to counters, so a fast spin costs one atomic add
+// per detent and never allocates; the consumer takes the whole batch at once.
+// Any number of producers, one consumer.
+class InputPipeline {
+public:
+    // Polled on drain for sources that keep their own position count
+    using StepSource = int32_t (*)(void* context);
+
+    void addSteps(int32_t steps, uint32_t nowUs);
+    void addPress(uint32_t nowUs);
+    void addLongPress(uint32_t nowUs);
+    // A polled source has something; it is read on the next drain
+    void markPending(uint32_t nowUs);
+
+    // Set once, before any producer runs
+    void setStepSource(StepSource source, void* context);
+
+    // Consumer side; returns false if nothing happened since the last drain
+    bool drain(InputBatch& out);
+
+private:
+    void stamp(uint32_t nowUs);
+
+    std::atomic<int32_t> steps{0};
+    std::atomic<uint32_t> presses{0};
+    std::atomic<uint32_t> longPresses{0};
+    std::atomic<uint32_t> firstEventUs{0};  // 0 = no event pending
+    StepSource stepSource = nullptr;
+    void* stepSourceContext = nullptr;
+};
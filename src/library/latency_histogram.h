@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Log2 latency histogram. Bucket 0 holds everything below MinUs, bucket i
+// holds [MinUs << (i - 1), MinUs << i), and the last bucket is open-ended.
+// Plain data so it can be published through a SeqLock.
+template <uint32_t MinUs, size_t Buckets>
+struct Log2Histogram {
+    static constexpr size_t BUCKETS = Buckets;
+    static constexpr uint32_t MIN_US = MinUs;
+
+    uint32_t buckets[BUCKETS];
+    uint32_t count;
+    uint32_t maxUs;
+    uint64_t sumUs;
+
+    void record(uint32_t us) {
+        size_t bucket = 0;
+        uint32_t edge = MIN_US;
+        while (bucket < BUCKETS - 1 && us >= edge) {
+            bucket++;
+            edge <<= 1;
+        }
+        buckets[bucket]++;
+        count++;
+        sumUs += us;
+        if (us > maxUs) maxUs = us;
+    }
+
+    void clear() {
+        for (uint32_t& bucket : buckets) bucket = 0;
+        count = 0;
+        maxUs = 0;
+        sumUs = 0;
+    }
+
+    uint32_t meanUs() const {
+        return count ? static_cast<uint32_t>(sumUs / count) : 0;
+    }
+
+    // Upper edge of the bucket holding the given percentile (0..100), capped at the maximum seen
+    uint32_t percentileUs(float percentile) const {
+        if (count == 0) return 0;
+        uint32_t rank = static_cast<uint32_t>(percentile / 100.0f * count + 0.5f);
+        if (rank < 1) rank = 1;
+
+        uint32_t seen = 0;
+        for (size_t i = 0; i < BUCKETS - 1; ++i) {
+            seen += buckets[i];
+            if (seen >= rank) return bucketUpperUs(i) < maxUs ? bucketUpperUs(i) : maxUs;
+        }
+        return maxUs;
+    }
+
+    static uint32_t bucketUpperUs(size_t bucket) {
+        return MIN_US << bucket;
+    }
+};
+
+// UI input latency: 250 µs .. 256 ms, then overflow
+typedef Log2Histogram<250, 12> LatencyHistogram;
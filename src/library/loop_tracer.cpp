@@ -0,0 +1,70 @@
+#include "library/loop_tracer.h"
+
+LoopTracer::LoopTracer(uint32_t periodUs) : periodUs(periodUs) {
+    reset();
+}
+
+void LoopTracer::setOverrunHandler(OverrunHandler handler, void* context) {
+    overrunHandler = handler;
+    overrunContext = context;
+}
+
+void LoopTracer::reset() {
+    trace = {};
+    started = false;
+    releaseUs = 0;
+    wakeUs = 0;
+    consecutiveMisses = 0;
+}
+
+void LoopTracer::begin(uint64_t nowUs) {
+    if (!started) {
+        started = true;
+        releaseUs = nowUs;
+    } else {
+        releaseUs += periodUs;
+
+        uint32_t intervalUs = static_cast<uint32_t>(nowUs - wakeUs);
+        if (trace.iterations == 1 || intervalUs < trace.periodMinUs) trace.periodMinUs = intervalUs;
+        if (intervalUs > trace.periodMaxUs) trace.periodMaxUs = intervalUs;
+        trace.periodSumUs += intervalUs;
+    }
+    wakeUs = nowUs;
+
+    trace.lateness.record(latenessUs());
+    trace.iterations++;
+}
+
+bool LoopTracer::end(uint64_t nowUs) {
+    uint32_t executionUs = static_cast<uint32_t>(nowUs - wakeUs);
+    trace.execution.record(executionUs);
+
+    if (nowUs <= releaseUs + periodUs) {
+        consecutiveMisses = 0;
+        return false;
+    }
+
+    trace.deadlineMisses++;
+    consecutiveMisses++;
+    if (consecutiveMisses > trace.maxConsecutiveMisses) trace.maxConsecutiveMisses = consecutiveMisses;
+
+    if (overrunHandler) {
+        Overrun overrun;
+        overrun.iteration = trace.iterations;
+        overrun.latenessUs = latenessUs();
+        overrun.executionUs = executionUs;
+        overrun.consecutive = consecutiveMisses;
+        overrunHandler(overrun, overrunContext);
+    }
+    return true;
+}
+
+uint32_t LoopTracer::slackUs(uint64_t nowUs) const {
+    uint64_t nextReleaseUs = releaseUs + periodUs;
+    return started && nowUs < nextReleaseUs ? static_cast<uint32_t>(nextReleaseUs - nowUs) : 0;
+}
+
+uint32_t LoopTracer::latenessUs() const {
+    // Tick rounding can wake the task a hair before the grid point
+    return wakeUs > releaseUs ? static_cast<uint32_t>(wakeUs - releaseUs) : 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+#include "library/latency_histogram.h"
+
+// Periodic loop timing: 16 µs .. 262 ms, then overflow, so a 250 ms period fits
+typedef Log2Histogram<16, 16> LoopHistogram;
+
+// Everything a LoopTracer recorded since its last reset. Plain data so it can
+// be published through a SeqLock.
+struct LoopTrace {
+    LoopHistogram lateness;         // Wake-up time after the scheduled release
+    LoopHistogram execution;        // Wake-up to the end of the iteration
+    uint32_t iterations;
+    uint32_t deadlineMisses;        // Iterations that ended after the next release
+    uint32_t maxConsecutiveMisses;
+    uint32_t periodMinUs;           // Wake-to-wake interval
+    uint32_t periodMaxUs;
+    uint64_t periodSumUs;
+
+    uint32_t periodMeanUs() const {
+        return iterations > 1 ? static_cast<uint32_t>(periodSumUs / (iterations - 1)) : 0;
+    }
+};
+
+// Hot-path timing of a task that sleeps with vTaskDelayUntil(): begin() on
+// wake-up, end() before going back to sleep, both with a microsecond
+// timestamp. Releases sit on a fixed grid from the first begin(), as with
+// vTaskDelayUntil(), so one late iteration does not shift the rest.
+// An iteration that ends after the next release is a deadline miss; the
+// overrun handler is called from end(), on the traced task. No Pico SDK or
+// FreeRTOS dependencies, so the simulator traces its control loop with it too.
+class LoopTracer {
+public:
+    struct Overrun {
+        uint32_t iteration;
+        uint32_t latenessUs;
+        uint32_t executionUs;
+        uint32_t consecutive;  // Misses in a row, this one included
+    };
+    typedef void (*OverrunHandler)(const Overrun& overrun, void* context);
+
+    explicit LoopTracer(uint32_t periodUs);
+
+    void setOverrunHandler(OverrunHandler handler, void* context);
+
+    void begin(uint64_t nowUs);
+    // Returns true if the iteration missed its deadline
+    bool end(uint64_t nowUs);
+
+    const LoopTrace& getTrace() const { return trace; }
+    // Time left until the next release, 0 once it has passed
+    uint32_t slackUs(uint64_t nowUs) const;
+    uint32_t getPeriodUs() const { return periodUs; }
+    // Forget the history; the next begin() starts a new release grid
+    void reset();
+
+private:
+    uint32_t latenessUs() const;
+
+    uint32_t periodUs;
+    OverrunHandler overrunHandler = nullptr;
+    void* overrunContext = nullptr;
+
+    LoopTrace trace;
+    bool started = false;
+    uint64_t releaseUs = 0;  // Scheduled release of the current iteration
+    uint64_t wakeUs = 0;
+    uint32_t consecutiveMisses = 0;
+};
@@ -6,13 +6,32 @@
 #error Regenerate this file with the current version of nanopb generator.
 #endif
 
-PB_BIND(UICommand, UICommand, AUTO)
+PB_BIND(oven_UICommand, oven_UICommand, AUTO)
+
+
+PB_BIND(oven_SystemStatus, oven_SystemStatus, AUTO)
+
+
+PB_BIND(oven_ReflowCurve, oven_ReflowCurve, AUTO)
+
+
+PB_BIND(oven_TaskStats, oven_TaskStats, AUTO)
+
+
+PB_BIND(oven_Diagnostics, oven_Diagnostics, 2)
+
+
+PB_BIND(oven_RunLogSample, oven_RunLogSample, AUTO)
+
+
+PB_BIND(oven_RunLogSummary, oven_RunLogSummary, AUTO)
+
+
+PB_BIND(oven_ProfileUploadResult, oven_ProfileUploadResult, AUTO)
 
 
-PB_BIND(SystemStatus, SystemStatus, AUTO)
 
 
-PB_BIND(ReflowCurve, ReflowCurve, AUTO)
 
 
 
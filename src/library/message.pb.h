@@ -1,8 +1,8 @@
 /* Automatically generated nanopb header */
 /* Generated by nanopb-0.4.9.1 */
 
-#ifndef PB_MESSAGE_PB_H_INCLUDED
-#define PB_MESSAGE_PB_H_INCLUDED
+#ifndef PB_OVEN_MESSAGE_PB_H_INCLUDED
+#define PB_OVEN_MESSAGE_PB_H_INCLUDED
 #include <pb.h>
 
 #if PB_PROTO_HEADER_VERSION != 40
@@ -10,33 +10,47 @@
 #endif
 
 /* Enum definitions */
-typedef enum _UICommand_Type {
-    UICommand_Type_START_REFLOW = 0,
-    UICommand_Type_CANCEL_REFLOW = 1,
-    UICommand_Type_OPEN_DOOR = 2,
-    UICommand_Type_CLOSE_DOOR = 3,
-    UICommand_Type_CALIBRATE_THERMOCOUPLE = 4,
-    UICommand_Type_RUN_CALIBRATION_CYCLE = 5,
-    UICommand_Type_SET_LED_BRIGHTNESS = 6,
-    UICommand_Type_SET_SELECTED_CURVE = 7,
-    UICommand_Type_RUN_DOOR_CALIBRATION = 8
-} UICommand_Type;
-
-typedef enum _SystemStatus_ShutdownReason {
-    SystemStatus_ShutdownReason_NONE = 0,
-    SystemStatus_ShutdownReason_SSR_OVERHEAT = 1,
-    SystemStatus_ShutdownReason_OVEN_OVERHEAT = 2,
-    SystemStatus_ShutdownReason_DOOR_MALFUNCTION = 3
-} SystemStatus_ShutdownReason;
+typedef enum _oven_UICommand_Type {
+    oven_UICommand_Type_START_REFLOW = 0,
+    oven_UICommand_Type_CANCEL_REFLOW = 1,
+    oven_UICommand_Type_OPEN_DOOR = 2,
+    oven_UICommand_Type_CLOSE_DOOR = 3,
+    oven_UICommand_Type_CALIBRATE_THERMOCOUPLE = 4,
+    oven_UICommand_Type_RUN_CALIBRATION_CYCLE = 5,
+    oven_UICommand_Type_SET_LED_BRIGHTNESS = 6,
+    oven_UICommand_Type_SET_SELECTED_CURVE = 7,
+    oven_UICommand_Type_RUN_DOOR_CALIBRATION = 8
+} oven_UICommand_Type;
+
+typedef enum _oven_SystemStatus_ShutdownReason {
+    oven_SystemStatus_ShutdownReason_NONE = 0,
+    oven_SystemStatus_ShutdownReason_SSR_OVERHEAT = 1,
+    oven_SystemStatus_ShutdownReason_OVEN_OVERHEAT = 2,
+    oven_SystemStatus_ShutdownReason_DOOR_MALFUNCTION = 3
+} oven_SystemStatus_ShutdownReason;
+
+typedef enum _oven_RunLogSummary_Outcome {
+    oven_RunLogSummary_Outcome_INTERRUPTED = 0, /* The run never finished, or its last page was lost */
+    oven_RunLogSummary_Outcome_COMPLETE = 1,
+    oven_RunLogSummary_Outcome_ABORTED = 2
+} oven_RunLogSummary_Outcome;
+
+typedef enum _oven_ProfileUploadResult_Status {
+    oven_ProfileUploadResult_Status_OK = 0,
+    oven_ProfileUploadResult_Status_INVALID = 1, /* Undecodable, unnamed, too many points or times not increasing after the first */
+    oven_ProfileUploadResult_Status_FULL = 2,
+    oven_ProfileUploadResult_Status_FLASH_ERROR = 3,
+    oven_ProfileUploadResult_Status_NOT_FOUND = 4 /* Removal of a profile that is not stored */
+} oven_ProfileUploadResult_Status;
 
 /* Struct definitions */
-typedef struct _UICommand {
-    UICommand_Type type;
+typedef struct _oven_UICommand {
+    oven_UICommand_Type type;
     int32_t value; /* e.g. brightness, curve ID */
     pb_callback_t curve_name; /* optional named curve */
-} UICommand;
+} oven_UICommand;
 
-typedef struct _SystemStatus {
+typedef struct _oven_SystemStatus {
     float current_temp;
     float ambient_temp;
     float target_temp;
@@ -54,14 +68,70 @@ typedef struct _SystemStatus {
     bool door_fully_open;
     bool door_fully_closed;
     bool emergency_shutdown; /* True if emergency shut down occurred */
-    SystemStatus_ShutdownReason shutdown_reason; /* Indicates the specific cause */
-} SystemStatus;
+    oven_SystemStatus_ShutdownReason shutdown_reason; /* Indicates the specific cause */
+} oven_SystemStatus;
 
-typedef struct _ReflowCurve {
+typedef struct _oven_ReflowCurve {
     pb_callback_t name;
     pb_callback_t temp_points;
     pb_callback_t time_points_ms;
-} ReflowCurve;
+} oven_ReflowCurve;
+
+typedef struct _oven_TaskStats {
+    char name[16];
+    uint32_t cpu_permille; /* Share of one core over the sampling window */
+    uint32_t core_affinity; /* Bit n set: may run on core n */
+    uint32_t stack_high_water; /* Fewest bytes of stack ever left free */
+    uint32_t priority;
+} oven_TaskStats;
+
+typedef struct _oven_Diagnostics {
+    uint32_t uptime_ms;
+    pb_size_t core_load_permille_count;
+    uint32_t core_load_permille[2];
+    pb_size_t tasks_count;
+    oven_TaskStats tasks[16]; /* Busiest first */
+    uint32_t heap_free_bytes;
+    uint32_t heap_min_free_bytes;
+    /* Control loop timing since boot */
+    uint32_t control_period_min_us;
+    uint32_t control_period_max_us;
+    uint32_t control_period_mean_us;
+    uint32_t control_exec_max_us;
+    uint32_t control_overruns; /* Deadline misses */
+    uint32_t control_lateness_p99_us; /* Wake-up after the scheduled release, histogram bucket edge */
+    uint32_t control_lateness_max_us;
+    uint32_t control_exec_p99_us;
+} oven_Diagnostics;
+
+/* One recorded sample of a reflow run, replayed from the run log */
+typedef struct _oven_RunLogSample {
+    uint32_t run_id;
+    uint32_t sample_index;
+    uint32_t time_ms; /* Since the start of the run */
+    float target_temp;
+    float current_temp;
+    uint32_t ssr_power_percent;
+    float door_percent_open;
+} oven_RunLogSample;
+
+/* Sent after the last sample of each run in the log */
+typedef struct _oven_RunLogSummary {
+    uint32_t run_id;
+    char curve_name[24]; /* Empty if the run's first page was overwritten */
+    uint32_t sample_period_ms;
+    uint32_t sample_count;
+    float peak_temp;
+    oven_RunLogSummary_Outcome outcome;
+} oven_RunLogSummary;
+
+/* Reply to a ReflowCurve uploaded to the oven. The curve is stored under its
+ name, replacing any profile of that name; a curve with no points removes it. */
+typedef struct _oven_ProfileUploadResult {
+    uint32_t name_hash; /* FNV-1a of the name, to select the profile by */
+    oven_ProfileUploadResult_Status status;
+    uint32_t profile_count;
+} oven_ProfileUploadResult;
 
 
 #ifdef __cplusplus
@@ -69,63 +139,122 @@ extern "C" {
 #endif
 
 /* Helper constants for enums */
-#define _UICommand_Type_MIN UICommand_Type_START_REFLOW
-#define _UICommand_Type_MAX UICommand_Type_RUN_DOOR_CALIBRATION
-#define _UICommand_Type_ARRAYSIZE ((UICommand_Type)(UICommand_Type_RUN_DOOR_CALIBRATION+1))
+#define _oven_UICommand_Type_MIN oven_UICommand_Type_START_REFLOW
+#define _oven_UICommand_Type_MAX oven_UICommand_Type_RUN_DOOR_CALIBRATION
+#define _oven_UICommand_Type_ARRAYSIZE ((oven_UICommand_Type)(oven_UICommand_Type_RUN_DOOR_CALIBRATION+1))
 
-#define _SystemStatus_ShutdownReason_MIN SystemStatus_ShutdownReason_NONE
-#define _SystemStatus_ShutdownReason_MAX SystemStatus_ShutdownReason_DOOR_MALFUNCTION
-#define _SystemStatus_ShutdownReason_ARRAYSIZE ((SystemStatus_ShutdownReason)(SystemStatus_ShutdownReason_DOOR_MALFUNCTION+1))
+#define _oven_SystemStatus_ShutdownReason_MIN oven_SystemStatus_ShutdownReason_NONE
+#define _oven_SystemStatus_ShutdownReason_MAX oven_SystemStatus_ShutdownReason_DOOR_MALFUNCTION
+#define _oven_SystemStatus_ShutdownReason_ARRAYSIZE ((oven_SystemStatus_ShutdownReason)(oven_SystemStatus_ShutdownReason_DOOR_MALFUNCTION+1))
 
-#define UICommand_type_ENUMTYPE UICommand_Type
+#define _oven_RunLogSummary_Outcome_MIN oven_RunLogSummary_Outcome_INTERRUPTED
+#define _oven_RunLogSummary_Outcome_MAX oven_RunLogSummary_Outcome_ABORTED
+#define _oven_RunLogSummary_Outcome_ARRAYSIZE ((oven_RunLogSummary_Outcome)(oven_RunLogSummary_Outcome_ABORTED+1))
 
-#define SystemStatus_shutdown_reason_ENUMTYPE SystemStatus_ShutdownReason
+#define _oven_ProfileUploadResult_Status_MIN oven_ProfileUploadResult_Status_OK
+#define _oven_ProfileUploadResult_Status_MAX oven_ProfileUploadResult_Status_NOT_FOUND
+#define _oven_ProfileUploadResult_Status_ARRAYSIZE ((oven_ProfileUploadResult_Status)(oven_ProfileUploadResult_Status_NOT_FOUND+1))
 
+#define oven_UICommand_type_ENUMTYPE oven_UICommand_Type
+
+#define oven_SystemStatus_shutdown_reason_ENUMTYPE oven_SystemStatus_ShutdownReason
+
+
+
+
+
+#define oven_RunLogSummary_outcome_ENUMTYPE oven_RunLogSummary_Outcome
+
+#define oven_ProfileUploadResult_status_ENUMTYPE oven_ProfileUploadResult_Status
 
 
 /* Initializer values for message structs */
-#define UICommand_init_default                   {_UICommand_Type_MIN, 0, {{NULL}, NULL}}
-#define SystemStatus_init_default                {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, {{NULL}, NULL}, 0, 0, 0, 0, _SystemStatus_ShutdownReason_MIN}
-#define ReflowCurve_init_default                 {{{NULL}, NULL}, {{NULL}, NULL}, {{NULL}, NULL}}
-#define UICommand_init_zero                      {_UICommand_Type_MIN, 0, {{NULL}, NULL}}
-#define SystemStatus_init_zero                   {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, {{NULL}, NULL}, 0, 0, 0, 0, _SystemStatus_ShutdownReason_MIN}
-#define ReflowCurve_init_zero                    {{{NULL}, NULL}, {{NULL}, NULL}, {{NULL}, NULL}}
+#define oven_UICommand_init_default              {_oven_UICommand_Type_MIN, 0, {{NULL}, NULL}}
+#define oven_SystemStatus_init_default           {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, {{NULL}, NULL}, 0, 0, 0, 0, _oven_SystemStatus_ShutdownReason_MIN}
+#define oven_ReflowCurve_init_default            {{{NULL}, NULL}, {{NULL}, NULL}, {{NULL}, NULL}}
+#define oven_TaskStats_init_default              {"", 0, 0, 0, 0}
+#define oven_Diagnostics_init_default            {0, 0, {0, 0}, 0, {oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default, oven_TaskStats_init_default}, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define oven_RunLogSample_init_default           {0, 0, 0, 0, 0, 0, 0}
+#define oven_RunLogSummary_init_default          {0, "", 0, 0, 0, _oven_RunLogSummary_Outcome_MIN}
+#define oven_ProfileUploadResult_init_default    {0, _oven_ProfileUploadResult_Status_MIN, 0}
+#define oven_UICommand_init_zero                 {_oven_UICommand_Type_MIN, 0, {{NULL}, NULL}}
+#define oven_SystemStatus_init_zero              {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, {{NULL}, NULL}, 0, 0, 0, 0, _oven_SystemStatus_ShutdownReason_MIN}
+#define oven_ReflowCurve_init_zero               {{{NULL}, NULL}, {{NULL}, NULL}, {{NULL}, NULL}}
+#define oven_TaskStats_init_zero                 {"", 0, 0, 0, 0}
+#define oven_Diagnostics_init_zero               {0, 0, {0, 0}, 0, {oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero, oven_TaskStats_init_zero}, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define oven_RunLogSample_init_zero              {0, 0, 0, 0, 0, 0, 0}
+#define oven_RunLogSummary_init_zero             {0, "", 0, 0, 0, _oven_RunLogSummary_Outcome_MIN}
+#define oven_ProfileUploadResult_init_zero       {0, _oven_ProfileUploadResult_Status_MIN, 0}
 
 /* Field tags (for use in manual encoding/decoding) */
-#define UICommand_type_tag                       1
-#define UICommand_value_tag                      2
-#define UICommand_curve_name_tag                 3
-#define SystemStatus_current_temp_tag            1
-#define SystemStatus_ambient_temp_tag            2
-#define SystemStatus_target_temp_tag             3
-#define SystemStatus_ssr_temp_tag                4
-#define SystemStatus_reflow_active_tag           5
-#define SystemStatus_door_open_tag               6
-#define SystemStatus_servo_powered_tag           7
-#define SystemStatus_time_elapsed_ms_tag         8
-#define SystemStatus_time_remaining_ms_tag       9
-#define SystemStatus_ssr_power_percent_tag       10
-#define SystemStatus_fan_speed_percent_tag       11
-#define SystemStatus_led_brightness_tag          12
-#define SystemStatus_current_stage_tag           13
-#define SystemStatus_door_percent_open_tag       14
-#define SystemStatus_door_fully_open_tag         15
-#define SystemStatus_door_fully_closed_tag       16
-#define SystemStatus_emergency_shutdown_tag      17
-#define SystemStatus_shutdown_reason_tag         18
-#define ReflowCurve_name_tag                     1
-#define ReflowCurve_temp_points_tag              2
-#define ReflowCurve_time_points_ms_tag           3
+#define oven_UICommand_type_tag                  1
+#define oven_UICommand_value_tag                 2
+#define oven_UICommand_curve_name_tag            3
+#define oven_SystemStatus_current_temp_tag       1
+#define oven_SystemStatus_ambient_temp_tag       2
+#define oven_SystemStatus_target_temp_tag        3
+#define oven_SystemStatus_ssr_temp_tag           4
+#define oven_SystemStatus_reflow_active_tag      5
+#define oven_SystemStatus_door_open_tag          6
+#define oven_SystemStatus_servo_powered_tag      7
+#define oven_SystemStatus_time_elapsed_ms_tag    8
+#define oven_SystemStatus_time_remaining_ms_tag  9
+#define oven_SystemStatus_ssr_power_percent_tag  10
+#define oven_SystemStatus_fan_speed_percent_tag  11
+#define oven_SystemStatus_led_brightness_tag     12
+#define oven_SystemStatus_current_stage_tag      13
+#define oven_SystemStatus_door_percent_open_tag  14
+#define oven_SystemStatus_door_fully_open_tag    15
+#define oven_SystemStatus_door_fully_closed_tag  16
+#define oven_SystemStatus_emergency_shutdown_tag 17
+#define oven_SystemStatus_shutdown_reason_tag    18
+#define oven_ReflowCurve_name_tag                1
+#define oven_ReflowCurve_temp_points_tag         2
+#define oven_ReflowCurve_time_points_ms_tag      3
+#define oven_TaskStats_name_tag                  1
+#define oven_TaskStats_cpu_permille_tag          2
+#define oven_TaskStats_core_affinity_tag         3
+#define oven_TaskStats_stack_high_water_tag      4
+#define oven_TaskStats_priority_tag              5
+#define oven_Diagnostics_uptime_ms_tag           1
+#define oven_Diagnostics_core_load_permille_tag  2
+#define oven_Diagnostics_tasks_tag               3
+#define oven_Diagnostics_heap_free_bytes_tag     4
+#define oven_Diagnostics_heap_min_free_bytes_tag 5
+#define oven_Diagnostics_control_period_min_us_tag 6
+#define oven_Diagnostics_control_period_max_us_tag 7
+#define oven_Diagnostics_control_period_mean_us_tag 8
+#define oven_Diagnostics_control_exec_max_us_tag 9
+#define oven_Diagnostics_control_overruns_tag    10
+#define oven_Diagnostics_control_lateness_p99_us_tag 11
+#define oven_Diagnostics_control_lateness_max_us_tag 12
+#define oven_Diagnostics_control_exec_p99_us_tag 13
+#define oven_RunLogSample_run_id_tag             1
+#define oven_RunLogSample_sample_index_tag       2
+#define oven_RunLogSample_time_ms_tag            3
+#define oven_RunLogSample_target_temp_tag        4
+#define oven_RunLogSample_current_temp_tag       5
+#define oven_RunLogSample_ssr_power_percent_tag  6
+#define oven_RunLogSample_door_percent_open_tag  7
+#define oven_RunLogSummary_run_id_tag            1
+#define oven_RunLogSummary_curve_name_tag        2
+#define oven_RunLogSummary_sample_period_ms_tag  3
+#define oven_RunLogSummary_sample_count_tag      4
+#define oven_RunLogSummary_peak_temp_tag         5
+#define oven_RunLogSummary_outcome_tag           6
+#define oven_ProfileUploadResult_name_hash_tag   1
+#define oven_ProfileUploadResult_status_tag      2
+#define oven_ProfileUploadResult_profile_count_tag 3
 
 /* Struct field encoding specification for nanopb */
-#define UICommand_FIELDLIST(X, a) \
+#define oven_UICommand_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, UENUM,    type,              1) \
 X(a, STATIC,   SINGULAR, INT32,    value,             2) \
 X(a, CALLBACK, SINGULAR, STRING,   curve_name,        3)
-#define UICommand_CALLBACK pb_default_field_callback
-#define UICommand_DEFAULT NULL
+#define oven_UICommand_CALLBACK pb_default_field_callback
+#define oven_UICommand_DEFAULT NULL
 
-#define SystemStatus_FIELDLIST(X, a) \
+#define oven_SystemStatus_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, FLOAT,    current_temp,      1) \
 X(a, STATIC,   SINGULAR, FLOAT,    ambient_temp,      2) \
 X(a, STATIC,   SINGULAR, FLOAT,    target_temp,       3) \
@@ -144,29 +273,100 @@ X(a, STATIC,   SINGULAR, BOOL,     door_fully_open,  15) \
 X(a, STATIC,   SINGULAR, BOOL,     door_fully_closed,  16) \
 X(a, STATIC,   SINGULAR, BOOL,     emergency_shutdown,  17) \
 X(a, STATIC,   SINGULAR, UENUM,    shutdown_reason,  18)
-#define SystemStatus_CALLBACK pb_default_field_callback
-#define SystemStatus_DEFAULT NULL
+#define oven_SystemStatus_CALLBACK pb_default_field_callback
+#define oven_SystemStatus_DEFAULT NULL
 
-#define ReflowCurve_FIELDLIST(X, a) \
+#define oven_ReflowCurve_FIELDLIST(X, a) \
 X(a, CALLBACK, SINGULAR, STRING,   name,              1) \
 X(a, CALLBACK, REPEATED, FLOAT,    temp_points,       2) \
 X(a, CALLBACK, REPEATED, INT32,    time_points_ms,    3)
-#define ReflowCurve_CALLBACK pb_default_field_callback
-#define ReflowCurve_DEFAULT NULL
+#define oven_ReflowCurve_CALLBACK pb_default_field_callback
+#define oven_ReflowCurve_DEFAULT NULL
+
+#define oven_TaskStats_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, STRING,   name,              1) \
+X(a, STATIC,   SINGULAR, UINT32,   cpu_permille,      2) \
+X(a, STATIC,   SINGULAR, UINT32,   core_affinity,     3) \
+X(a, STATIC,   SINGULAR, UINT32,   stack_high_water,   4) \
+X(a, STATIC,   SINGULAR, UINT32,   priority,          5)
+#define oven_TaskStats_CALLBACK NULL
+#define oven_TaskStats_DEFAULT NULL
+
+#define oven_Diagnostics_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   uptime_ms,         1) \
+X(a, STATIC,   REPEATED, UINT32,   core_load_permille,   2) \
+X(a, STATIC,   REPEATED, MESSAGE,  tasks,             3) \
+X(a, STATIC,   SINGULAR, UINT32,   heap_free_bytes,   4) \
+X(a, STATIC,   SINGULAR, UINT32,   heap_min_free_bytes,   5) \
+X(a, STATIC,   SINGULAR, UINT32,   control_period_min_us,   6) \
+X(a, STATIC,   SINGULAR, UINT32,   control_period_max_us,   7) \
+X(a, STATIC,   SINGULAR, UINT32,   control_period_mean_us,   8) \
+X(a, STATIC,   SINGULAR, UINT32,   control_exec_max_us,   9) \
+X(a, STATIC,   SINGULAR, UINT32,   control_overruns,  10) \
+X(a, STATIC,   SINGULAR, UINT32,   control_lateness_p99_us,  11) \
+X(a, STATIC,   SINGULAR, UINT32,   control_lateness_max_us,  12) \
+X(a, STATIC,   SINGULAR, UINT32,   control_exec_p99_us,  13)
+#define oven_Diagnostics_CALLBACK NULL
+#define oven_Diagnostics_DEFAULT NULL
+#define oven_Diagnostics_tasks_MSGTYPE oven_TaskStats
+
+#define oven_RunLogSample_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   run_id,            1) \
+X(a, STATIC,   SINGULAR, UINT32,   sample_index,      2) \
+X(a, STATIC,   SINGULAR, UINT32,   time_ms,           3) \
+X(a, STATIC,   SINGULAR, FLOAT,    target_temp,       4) \
+X(a, STATIC,   SINGULAR, FLOAT,    current_temp,      5) \
+X(a, STATIC,   SINGULAR, UINT32,   ssr_power_percent,   6) \
+X(a, STATIC,   SINGULAR, FLOAT,    door_percent_open,   7)
+#define oven_RunLogSample_CALLBACK NULL
+#define oven_RunLogSample_DEFAULT NULL
+
+#define oven_RunLogSummary_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   run_id,            1) \
+X(a, STATIC,   SINGULAR, STRING,   curve_name,        2) \
+X(a, STATIC,   SINGULAR, UINT32,   sample_period_ms,   3) \
+X(a, STATIC,   SINGULAR, UINT32,   sample_count,      4) \
+X(a, STATIC,   SINGULAR, FLOAT,    peak_temp,         5) \
+X(a, STATIC,   SINGULAR, UENUM,    outcome,           6)
+#define oven_RunLogSummary_CALLBACK NULL
+#define oven_RunLogSummary_DEFAULT NULL
+
+#define oven_ProfileUploadResult_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   name_hash,         1) \
+X(a, STATIC,   SINGULAR, UENUM,    status,            2) \
+X(a, STATIC,   SINGULAR, UINT32,   profile_count,     3)
+#define oven_ProfileUploadResult_CALLBACK NULL
+#define oven_ProfileUploadResult_DEFAULT NULL
 
-extern const pb_msgdesc_t UICommand_msg;
-extern const pb_msgdesc_t SystemStatus_msg;
-extern const pb_msgdesc_t ReflowCurve_msg;
+extern const pb_msgdesc_t oven_UICommand_msg;
+extern const pb_msgdesc_t oven_SystemStatus_msg;
+extern const pb_msgdesc_t oven_ReflowCurve_msg;
+extern const pb_msgdesc_t oven_TaskStats_msg;
+extern const pb_msgdesc_t oven_Diagnostics_msg;
+extern const pb_msgdesc_t oven_RunLogSample_msg;
+extern const pb_msgdesc_t oven_RunLogSummary_msg;
+extern const pb_msgdesc_t oven_ProfileUploadResult_msg;
 
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
-#define UICommand_fields &UICommand_msg
-#define SystemStatus_fields &SystemStatus_msg
-#define ReflowCurve_fields &ReflowCurve_msg
+#define oven_UICommand_fields &oven_UICommand_msg
+#define oven_SystemStatus_fields &oven_SystemStatus_msg
+#define oven_ReflowCurve_fields &oven_ReflowCurve_msg
+#define oven_TaskStats_fields &oven_TaskStats_msg
+#define oven_Diagnostics_fields &oven_Diagnostics_msg
+#define oven_RunLogSample_fields &oven_RunLogSample_msg
+#define oven_RunLogSummary_fields &oven_RunLogSummary_msg
+#define oven_ProfileUploadResult_fields &oven_ProfileUploadResult_msg
 
 /* Maximum encoded size of messages (where known) */
-/* UICommand_size depends on runtime parameters */
-/* SystemStatus_size depends on runtime parameters */
-/* ReflowCurve_size depends on runtime parameters */
+/* oven_UICommand_size depends on runtime parameters */
+/* oven_SystemStatus_size depends on runtime parameters */
+/* oven_ReflowCurve_size depends on runtime parameters */
+#define OVEN_MESSAGE_PB_H_MAX_SIZE               oven_Diagnostics_size
+#define oven_Diagnostics_size                    766
+#define oven_ProfileUploadResult_size            14
+#define oven_RunLogSample_size                   39
+#define oven_RunLogSummary_size                  50
+#define oven_TaskStats_size                      41
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -0,0 +1,48 @@
+#include "library/oven_control_loop.h"
+#include "constants.h"
+
+OvenControlLoop::OvenControlLoop(const Hal& hal)
+    : hal(hal),
+      heaterPower(0),
+      coolingPower(0),
+      lastCoolingChangeMs(0),
+      lastUpdateMs(0),
+      hasLastUpdate(false) {}
+
+void OvenControlLoop::update(uint32_t nowMs, float targetTemp, float rampRate, const Measurement& measurement) {
+    // Measured iteration to iteration, so a late tick integrates the time it actually covered
+    float dt = hasLastUpdate ? (nowMs - lastUpdateMs) / 1000.0f : HEATER_CONTROL_PERIOD_MS / 1000.0f;
+    lastUpdateMs = nowMs;
+    hasLastUpdate = true;
+
+    controller.setTarget(targetTemp, rampRate);
+
+    OvenController::Inputs inputs;
+    inputs.temperature = measurement.temperature;
+    inputs.temperatureRate = measurement.temperatureRate;
+    inputs.hasRate = measurement.hasRate;
+    inputs.sensorFault = measurement.sensorFault;
+    inputs.dtSeconds = dt;
+    OvenController::Outputs outputs = controller.update(inputs);
+
+    setHeaterPower(static_cast<uint8_t>(outputs.heaterPower));
+    setCoolingPower(nowMs, static_cast<uint8_t>(outputs.doorPercent));
+}
+
+void OvenControlLoop::stopHeating(uint32_t nowMs) {
+    setHeaterPower(0);
+    setCoolingPower(nowMs, 100); // Open vents for maximum cooling
+}
+
+void OvenControlLoop::setHeaterPower(uint8_t percent) {
+    heaterPower = percent;
+    hal.setHeaterPower(percent, hal.context);
+}
+
+void OvenControlLoop::setCoolingPower(uint32_t nowMs, uint8_t percent) {
+    if ((nowMs - lastCoolingChangeMs) < MIN_COOLING_CHANGE_INTERVAL) return;
+
+    coolingPower = percent > 100 ? 100 : percent;
+    lastCoolingChangeMs = nowMs;
+    hal.setDoorPosition(coolingPower, hal.context);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+#include "library/oven_controller.h"
+
+// One heater/door control iteration as TemperatureControlService runs it:
+// OvenController on the latest measurement, outputs truncated to whole
+// percent, door moves rate-limited, and the stop sequence (heater off, door
+// open). The hardware is reached through the Hal callbacks, so the host
+// simulator drives exactly this code against its plant. No Pico SDK or
+// FreeRTOS dependencies; the caller serialises access.
+class OvenControlLoop {
+public:
+    struct Hal {
+        void (*setHeaterPower)(uint8_t percent, void* context);
+        void (*setDoorPosition)(uint8_t percent, void* context);
+        void* context;
+    };
+
+    struct Measurement {
+        float temperature;      // °C
+        float temperatureRate;  // °C/s, used when hasRate is set
+        bool hasRate;
+        bool sensorFault;
+    };
+
+    explicit OvenControlLoop(const Hal& hal);
+
+    // A target of 0 °C is idle: heater off, door closed
+    void update(uint32_t nowMs, float targetTemp, float rampRate, const Measurement& measurement);
+
+    // Heater off, door fully open
+    void stopHeating(uint32_t nowMs);
+
+    void setHeaterPower(uint8_t percent);
+    // Ignored if the door moved less than MIN_COOLING_CHANGE_INTERVAL ago
+    void setCoolingPower(uint32_t nowMs, uint8_t percent);
+
+    uint8_t getHeaterPower() const { return heaterPower; }
+    uint8_t getCoolingPower() const { return coolingPower; }
+
+    OvenController& getController() { return controller; }
+    const OvenController& getController() const { return controller; }
+
+private:
+    Hal hal;
+    OvenController controller;
+    uint8_t heaterPower;
+    uint8_t coolingPower;
+    uint32_t lastCoolingChangeMs;
+    uint32_t lastUpdateMs;
+    bool hasLastUpdate;
+};
@@ -0,0 +1,54 @@
+#include "library/oven_controller.h"
+#include "constants.h"
+#include <math.h>
+
+OvenController::OvenController()
+    : pid(REFLOW_PID_PROPORTIONAL_GAIN, REFLOW_PID_INTEGRAL_GAIN, REFLOW_PID_DERIVATIVE_GAIN),
+      feedForward{0.0f, 0.0f, 0.0f},
+      targetTemp(0.0f),
+      targetRampRate(0.0f) {
+    pid.setIntegralLimits(REFLOW_PID_INTEGRAL_MIN, REFLOW_PID_INTEGRAL_MAX);
+    pid.setDerivativeFilter(REFLOW_PID_DERIVATIVE_FILTER_S);
+}
+
+void OvenController::setTarget(float temp, float rampRate) {
+    targetTemp = temp;
+    targetRampRate = rampRate;
+}
+
+void OvenController::setCalibration(const ThermalCalibrationSummary& summary) {
+    model.setSummary(summary);
+}
+
+void OvenController::clearCalibration() {
+    model = ThermalModel();
+}
+
+void OvenController::setGains(float kp, float ki, float kd) {
+    pid.setGains(kp, ki, kd);
+}
+
+OvenController::Outputs OvenController::update(const Inputs& inputs) {
+    Outputs outputs = {0.0f, 0.0f};
+
+    if (inputs.sensorFault || targetTemp == 0.0f) {
+        // Drop the last run's feed-forward first, or reset() seeds the integral against it
+        feedForward = {0.0f, 0.0f, 0.0f};
+        pid.setFeedForward(0.0f);
+        pid.reset(inputs.temperature);
+        return outputs;
+    }
+
+    feedForward = model.isValid() ? model.plan(targetTemp, targetRampRate, REFLOW_FEEDFORWARD_HORIZON_S)
+                                  : ThermalModel::Plan{0.0f, 0.0f, 0.0f};
+
+    // Model supplies the power the ramp needs; the PID only corrects what the model gets wrong
+    pid.setFeedForward(feedForward.heaterPower);
+    outputs.heaterPower = inputs.hasRate ? pid.update(targetTemp, inputs.temperature, inputs.temperatureRate, inputs.dtSeconds)
+                                         : pid.update(targetTemp, inputs.temperature, inputs.dtSeconds);
+
+    // Feed-forward opening for cooling ramps, trimmed proportionally by how far we are off target
+    float error = inputs.temperature - targetTemp;
+    outputs.doorPercent = fminf(fmaxf(feedForward.doorPercent + error * COOLING_DOOR_GAIN, 0.0f), 100.0f);
+    return outputs;
+}
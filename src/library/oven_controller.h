@@ -0,0 +1,52 @@
+#pragma once
+
+#include "library/pid_controller.h"
+#include "library/thermal_model.h"
+#include "types/calibration_data.h"
+
+// Control law for the oven: model feed-forward plus PID on the heater, and
+// feed-forward plus proportional trim on the door. Pure computation with no
+// Pico SDK or FreeRTOS dependencies - TemperatureControlService feeds it from
+// the sensors and applies its outputs to the hardware, and the host simulator
+// drives the same code against a simulated plant.
+class OvenController {
+public:
+    struct Inputs {
+        float temperature;      // °C
+        float temperatureRate;  // °C/s, used for the derivative when hasRate is set
+        bool hasRate;
+        bool sensorFault;
+        float dtSeconds;
+    };
+
+    struct Outputs {
+        float heaterPower;  // 0-100 %
+        float doorPercent;  // 0-100 %
+    };
+
+    OvenController();
+
+    // A target of 0 °C means idle: heater off, door closed, PID held in reset
+    void setTarget(float temp, float rampRate);
+    float getTarget() const { return targetTemp; }
+    float getRampRate() const { return targetRampRate; }
+
+    void setCalibration(const ThermalCalibrationSummary& summary);
+    void clearCalibration();
+    bool hasModel() const { return model.isValid(); }
+
+    void setGains(float kp, float ki, float kd);
+    PidController::Gains getGains() const { return pid.getGains(); }
+
+    Outputs update(const Inputs& inputs);
+
+    const ThermalModel::Plan& getFeedForward() const { return feedForward; }
+    const PidController& getPid() const { return pid; }
+
+private:
+    PidController pid;
+    ThermalModel model;
+    ThermalModel::Plan feedForward;
+    float targetTemp;
+    float targetRampRate;
+};
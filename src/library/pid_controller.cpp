@@ -0,0 +1,111 @@
+#include "library/pid_controller.h"
+#include <math.h>
+
+PidController::PidController(float kp, float ki, float kd, float outputMin, float outputMax)
+    : gains{kp, ki, kd},
+      outputMin(outputMin),
+      outputMax(outputMax),
+      integralMin(outputMin),
+      integralMax(outputMax) {
+    updateTrackingGain();
+}
+
+float PidController::update(float setpoint, float measurement, float dtSeconds) {
+    float rate = 0.0f;
+    if (hasLastMeasurement && dtSeconds > 0.0f) {
+        rate = (measurement - lastMeasurement) / dtSeconds;
+    }
+    lastMeasurement = measurement;
+    hasLastMeasurement = true;
+    return step(setpoint - measurement, rate, dtSeconds);
+}
+
+float PidController::update(float setpoint, float measurement, float measurementRate, float dtSeconds) {
+    lastMeasurement = measurement;
+    hasLastMeasurement = true;
+    return step(setpoint - measurement, measurementRate, dtSeconds);
+}
+
+float PidController::step(float error, float measurementRate, float dtSeconds) {
+    if (dtSeconds <= 0.0f) return output;
+
+    proportional = gains.kp * error;
+
+    // First-order low-pass on -Kd * dy/dt
+    float rawDerivative = -gains.kd * measurementRate;
+    float alpha = dtSeconds / (derivativeFilterSeconds + dtSeconds);
+    derivative += alpha * (rawDerivative - derivative);
+
+    float unclamped = proportional + integral + derivative + feedForward;
+    output = fminf(fmaxf(unclamped, outputMin), outputMax);
+    saturated = (output != unclamped);
+
+    // Back-calculation: bleed the integral towards what the actuator can actually deliver
+    integral += gains.ki * error * dtSeconds + trackingGain * (output - unclamped) * dtSeconds;
+    integral = clampIntegral(integral);
+
+    lastError = error;
+    return output;
+}
+
+void PidController::setGains(float kp, float ki, float kd) {
+    // Bumpless: keep P + I + D unchanged at the current operating point
+    float newProportional = kp * lastError;
+    float newDerivative = (gains.kd != 0.0f) ? derivative * (kd / gains.kd) : 0.0f;
+    integral = clampIntegral(integral + (proportional - newProportional) + (derivative - newDerivative));
+
+    gains = {kp, ki, kd};
+    proportional = newProportional;
+    derivative = newDerivative;
+    updateTrackingGain();
+}
+
+void PidController::setOutputLimits(float min, float max) {
+    outputMin = min;
+    outputMax = max;
+    output = fminf(fmaxf(output, outputMin), outputMax);
+}
+
+void PidController::setIntegralLimits(float min, float max) {
+    integralMin = min;
+    integralMax = max;
+    integral = clampIntegral(integral);
+}
+
+void PidController::setDerivativeFilter(float timeConstantSeconds) {
+    derivativeFilterSeconds = timeConstantSeconds > 0.0f ? timeConstantSeconds : 0.0f;
+}
+
+void PidController::setTrackingGain(float gain) {
+    autoTrackingGain = (gain <= 0.0f);
+    trackingGain = gain;
+    updateTrackingGain();
+}
+
+void PidController::reset(float measurement, float seedOutput) {
+    proportional = 0.0f;
+    derivative = 0.0f;
+    lastError = 0.0f;
+    lastMeasurement = measurement;
+    hasLastMeasurement = false;
+    saturated = false;
+    output = fminf(fmaxf(seedOutput, outputMin), outputMax);
+    integral = clampIntegral(output - feedForward);
+}
+
+void PidController::updateTrackingGain() {
+    if (!autoTrackingGain) return;
+    if (gains.ki <= 0.0f || gains.kp <= 0.0f) {
+        trackingGain = 0.0f;
+        return;
+    }
+    // Rule of thumb: Tt = sqrt(Ti * Td), falling back to Ti for PI control
+    float ti = gains.kp / gains.ki;
+    float td = gains.kd / gains.kp;
+    float tt = (td > 0.0f) ? sqrtf(ti * td) : ti;
+    trackingGain = 1.0f / tt;
+}
+
+float PidController::clampIntegral(float value) const {
+    return fminf(fmaxf(value, integralMin), integralMax);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+// Discrete PID controller for the heater loop.
+// - Derivative acts on the measurement, not the error, so setpoint steps do not kick the output
+// - The derivative is low-pass filtered with a configurable time constant
+// - Integral windup is limited by back-calculation from the saturated output plus a hard clamp
+// - Gain changes are bumpless: the integral absorbs the difference so the output does not jump
+// - An optional feed-forward term is added before saturation, so the integral only trims model error
+// No Pico SDK or FreeRTOS dependencies, so it builds and runs on the host.
+class PidController {
+public:
+    struct Gains {
+        float kp;  // Output per °C of error
+        float ki;  // Output per °C·s of accumulated error
+        float kd;  // Output per °C/s of measurement rate
+    };
+
+    PidController(float kp, float ki, float kd, float outputMin = 0.0f, float outputMax = 100.0f);
+
+    // Derivative taken from successive measurements
+    float update(float setpoint, float measurement, float dtSeconds);
+    // Derivative supplied by the caller, e.g. a least-squares slope over recent samples
+    float update(float setpoint, float measurement, float measurementRate, float dtSeconds);
+
+    void setGains(float kp, float ki, float kd);
+    Gains getGains() const { return gains; }
+
+    void setOutputLimits(float min, float max);
+    void setIntegralLimits(float min, float max);
+    void setDerivativeFilter(float timeConstantSeconds);
+    // 1/Tt in the back-calculation term; 0 picks sqrt(Ti * Td) (or Ti) from the gains
+    void setTrackingGain(float trackingGain);
+    // Open-loop output added to P + I + D on the next update
+    void setFeedForward(float value) { feedForward = value; }
+
+    // Clear history; 'output' seeds the integral for a bumpless hand-over from manual control
+    void reset(float measurement = 0.0f, float output = 0.0f);
+
+    float getOutput() const { return output; }
+    float getProportional() const { return proportional; }
+    float getIntegral() const { return integral; }
+    float getDerivative() const { return derivative; }
+    float getFeedForward() const { return feedForward; }
+    bool isSaturated() const { return saturated; }
+
+private:
+    float step(float error, float measurementRate, float dtSeconds);
+    void updateTrackingGain();
+    float clampIntegral(float value) const;
+
+    Gains gains;
+    float outputMin;
+    float outputMax;
+    float integralMin;
+    float integralMax;
+    float derivativeFilterSeconds = 1.0f;
+    float trackingGain = 0.0f;
+    bool autoTrackingGain = true;
+
+    float proportional = 0.0f;
+    float integral = 0.0f;
+    float derivative = 0.0f;
+    float feedForward = 0.0f;
+    float output = 0.0f;
+    float lastError = 0.0f;
+    float lastMeasurement = 0.0f;
+    bool hasLastMeasurement = false;
+    bool saturated = false;
+};
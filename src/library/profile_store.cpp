@@ -0,0 +1,282 @@
+#include "library/profile_store.h"
+#include "library/frame_encoder.h"
+#include <string.h>
+
+static_assert(sizeof(StoredProfile) <= ProfileStore::SLOT_SIZE, "a profile must fit in one flash page");
+
+ProfileStore::ProfileStore(const uint8_t* mapped, uint32_t flashOffset, size_t sectorCount, const FlashOps& ops)
+    : mapped(mapped),
+      flashOffset(flashOffset),
+      sectorCount(sectorCount < 2 ? 2 : (sectorCount > MAX_SECTORS ? MAX_SECTORS : sectorCount)),
+      ops(ops),
+      nextSequence(1),
+      count(0) {
+    memset(slots, 0, sizeof(slots));
+}
+
+void ProfileStore::mount() {
+    count = 0;
+    nextSequence = 1;
+
+    for (size_t slot = 0; slot < sectorCount * SLOTS_PER_SECTOR; ++slot) {
+        const StoredProfile* record = slotAt(slot);
+        if (isErased(reinterpret_cast<const uint8_t*>(record), SLOT_SIZE)) {
+            slots[slot] = SlotState::ERASED;
+            continue;
+        }
+
+        slots[slot] = SlotState::DEAD;
+        if (!isValid(*record)) continue;
+        if (record->sequence >= nextSequence) nextSequence = record->sequence + 1;
+        if (record->state != STATE_LIVE) continue;
+
+        // Two live copies of a name only survive a power cut between writing one and retiring the other
+        size_t i = findIndex(record->name);
+        if (i == count) {
+            insertIndex(static_cast<uint16_t>(slot));
+            slots[slot] = SlotState::LIVE;
+        } else if (record->sequence > slotAt(index[i])->sequence) {
+            slots[index[i]] = SlotState::DEAD;
+            index[i] = static_cast<uint16_t>(slot);
+            slots[slot] = SlotState::LIVE;
+        }
+    }
+}
+
+const StoredProfile* ProfileStore::get(size_t position) const {
+    return position < count ? slotAt(index[position]) : nullptr;
+}
+
+const StoredProfile* ProfileStore::findByHash(uint32_t nameHash) const {
+    for (size_t i = 0; i < count; ++i) {
+        const StoredProfile* record = slotAt(index[i]);
+        if (record->nameHash == nameHash) return record;
+    }
+    return nullptr;
+}
+
+const StoredProfile* ProfileStore::findByName(const char* name) const {
+    return get(findIndex(name));
+}
+
+ProfileStore::Result ProfileStore::store(const StoredProfile& profile) {
+    if (!isWellFormed(profile)) return Result::INVALID;
+    if (findIndex(profile.name) == count && count >= getCapacity()) return Result::FULL;
+
+    Result result = Result::OK;
+    uint16_t slot = allocate(&result);
+    if (slot == NO_SLOT) return result;
+    if (!writeRecord(slot, profile)) return Result::FLASH_ERROR;
+
+    // Looked up again: compaction may have moved the previous copy
+    size_t i = findIndex(profile.name);
+    if (i < count) {
+        uint16_t previous = index[i];
+        index[i] = slot;
+        // If this fails the new copy still wins on sequence
+        retire(previous);
+        slots[previous] = SlotState::DEAD;
+    } else {
+        insertIndex(slot);
+    }
+    return Result::OK;
+}
+
+bool ProfileStore::remove(const char* name) {
+    size_t i = findIndex(name);
+    if (i == count) return false;
+
+    // Older copies left unretired by a power cut go first, or they could come back in place of this one
+    uint32_t hash = hashName(name);
+    for (size_t slot = 0; slot < sectorCount * SLOTS_PER_SECTOR; ++slot) {
+        const StoredProfile* record = slotAt(slot);
+        if (slots[slot] == SlotState::DEAD && record->magic == RECORD_MAGIC && record->state == STATE_LIVE
+            && record->nameHash == hash && strncmp(record->name, name, sizeof(record->name)) == 0) {
+            retire(static_cast<uint16_t>(slot));
+        }
+    }
+
+    if (!retire(index[i])) return false;
+    slots[index[i]] = SlotState::DEAD;
+    memmove(&index[i], &index[i + 1], (count - i - 1) * sizeof(index[0]));
+    count--;
+    return true;
+}
+
+uint32_t ProfileStore::hashName(const char* name) {
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash ^= static_cast<uint8_t>(*name++);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool ProfileStore::isWellFormed(const StoredProfile& profile) {
+    if (profile.name[0] == '\0' || !memchr(profile.name, '\0', sizeof(profile.name))) return false;
+    if (profile.pointCount == 0 || profile.pointCount > StoredProfile::MAX_POINTS) return false;
+
+    // A first point at 0 ms is a zero-length step: the run starts at that temperature
+    uint32_t previousMs = 0;
+    for (size_t i = 0; i < profile.pointCount; ++i) {
+        const ProfilePoint& point = profile.points[i];
+        if (point.tempC != point.tempC || (i > 0 && point.timeMs <= previousMs)) return false;
+        previousMs = point.timeMs;
+    }
+    return true;
+}
+
+const StoredProfile* ProfileStore::slotAt(size_t slot) const {
+    return reinterpret_cast<const StoredProfile*>(mapped + slot * SLOT_SIZE);
+}
+
+uint16_t ProfileStore::recordCrc(const StoredProfile& record) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+    uint16_t crc = FrameEncoder::crc16(bytes, offsetof(StoredProfile, crc));
+    return FrameEncoder::crc16(bytes + offsetof(StoredProfile, name), sizeof(StoredProfile) - offsetof(StoredProfile, name), crc);
+}
+
+bool ProfileStore::isErased(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+bool ProfileStore::isValid(const StoredProfile& record) const {
+    return record.magic == RECORD_MAGIC
+        && isWellFormed(record)
+        && record.crc == recordCrc(record)
+        && record.nameHash == hashName(record.name);
+}
+
+size_t ProfileStore::findIndex(const char* name) const {
+    uint32_t hash = hashName(name);
+    for (size_t i = 0; i < count; ++i) {
+        const StoredProfile* record = slotAt(index[i]);
+        if (record->nameHash == hash && strcmp(record->name, name) == 0) return i;
+    }
+    return count;
+}
+
+void ProfileStore::insertIndex(uint16_t slot) {
+    const char* name = slotAt(slot)->name;
+    size_t position = 0;
+    while (position < count && strcmp(slotAt(index[position])->name, name) < 0) position++;
+
+    memmove(&index[position + 1], &index[position], (count - position) * sizeof(index[0]));
+    index[position] = slot;
+    count++;
+}
+
+bool ProfileStore::sectorErased(size_t sector) const {
+    for (size_t slot = sector * SLOTS_PER_SECTOR; slot < (sector + 1) * SLOTS_PER_SECTOR; ++slot) {
+        if (slots[slot] != SlotState::ERASED) return false;
+    }
+    return true;
+}
+
+uint16_t ProfileStore::allocate(Result* result) {
+    // Each compaction frees at least one page; after a power cut left the reserve short it may take more than one
+    uint16_t slot;
+    while ((slot = freeSlot()) == NO_SLOT) {
+        *result = compact();
+        if (*result != Result::OK) return NO_SLOT;
+    }
+    return slot;
+}
+
+uint16_t ProfileStore::freeSlot() const {
+    // Erased pages are held back so a compaction always has somewhere to copy to.
+    // Partly used sectors are filled first, so the reserve normally includes a whole sector.
+    size_t erased = 0;
+    uint16_t partial = NO_SLOT;
+    uint16_t fresh = NO_SLOT;
+    for (size_t sector = 0; sector < sectorCount; ++sector) {
+        bool wholeSector = sectorErased(sector);
+        for (size_t slot = sector * SLOTS_PER_SECTOR; slot < (sector + 1) * SLOTS_PER_SECTOR; ++slot) {
+            if (slots[slot] != SlotState::ERASED) continue;
+            erased++;
+            uint16_t& candidate = wholeSector ? fresh : partial;
+            if (candidate == NO_SLOT) candidate = static_cast<uint16_t>(slot);
+        }
+    }
+    if (erased <= RESERVED_SLOTS) return NO_SLOT;
+    return partial != NO_SLOT ? partial : fresh;
+}
+
+ProfileStore::Result ProfileStore::compact() {
+    size_t erased = 0;
+    for (size_t slot = 0; slot < sectorCount * SLOTS_PER_SECTOR; ++slot) {
+        if (slots[slot] == SlotState::ERASED) erased++;
+    }
+
+    // Reclaim the sector with the most dead pages whose live ones fit in the erased pages elsewhere
+    size_t victim = sectorCount;
+    size_t victimDead = 0;
+    for (size_t sector = 0; sector < sectorCount; ++sector) {
+        size_t live = 0;
+        size_t dead = 0;
+        for (size_t slot = sector * SLOTS_PER_SECTOR; slot < (sector + 1) * SLOTS_PER_SECTOR; ++slot) {
+            if (slots[slot] == SlotState::LIVE) live++;
+            if (slots[slot] == SlotState::DEAD) dead++;
+        }
+        size_t erasedElsewhere = erased - (SLOTS_PER_SECTOR - live - dead);
+        if (dead > victimDead && live <= erasedElsewhere) {
+            victim = sector;
+            victimDead = dead;
+        }
+    }
+    if (victim == sectorCount) return Result::FULL;
+
+    // The copies get newer sequence numbers, so they win even if the erase below never happens
+    size_t target = 0;
+    for (size_t slot = victim * SLOTS_PER_SECTOR; slot < (victim + 1) * SLOTS_PER_SECTOR; ++slot) {
+        if (slots[slot] != SlotState::LIVE) continue;
+
+        while (target / SLOTS_PER_SECTOR == victim || slots[target] != SlotState::ERASED) target++;
+        if (!writeRecord(static_cast<uint16_t>(target), *slotAt(slot))) return Result::FLASH_ERROR;
+        for (size_t i = 0; i < count; ++i) {
+            if (index[i] == slot) index[i] = static_cast<uint16_t>(target);
+        }
+        slots[slot] = SlotState::DEAD;
+    }
+
+    if (!ops.erase(flashOffset + victim * SECTOR_SIZE, SECTOR_SIZE, ops.context)) return Result::FLASH_ERROR;
+    for (size_t slot = victim * SLOTS_PER_SECTOR; slot < (victim + 1) * SLOTS_PER_SECTOR; ++slot) {
+        slots[slot] = SlotState::ERASED;
+    }
+    return Result::OK;
+}
+
+bool ProfileStore::writeRecord(uint16_t slot, const StoredProfile& profile) {
+    StoredProfile record;
+    memcpy(&record, &profile, sizeof(record));
+    record.magic = RECORD_MAGIC;
+    record.sequence = nextSequence++;
+    record.nameHash = hashName(record.name);
+    record.reserved = 0;
+    record.state = STATE_LIVE;
+    record.crc = recordCrc(record);
+
+    memset(pageBuffer, 0xFF, SLOT_SIZE);
+    memcpy(pageBuffer, &record, sizeof(record));
+
+    // The page is spent unless the program never touched it
+    bool ok = ops.program(flashOffset + slot * SLOT_SIZE, pageBuffer, SLOT_SIZE, ops.context)
+        && memcmp(slotAt(slot), pageBuffer, SLOT_SIZE) == 0;
+    if (ok) {
+        slots[slot] = SlotState::LIVE;
+    } else {
+        slots[slot] = isErased(reinterpret_cast<const uint8_t*>(slotAt(slot)), SLOT_SIZE) ? SlotState::ERASED : SlotState::DEAD;
+    }
+    return ok;
+}
+
+bool ProfileStore::retire(uint16_t slot) {
+    // Programming the page again with only the state word cleared leaves the rest as it is
+    memset(pageBuffer, 0xFF, SLOT_SIZE);
+    memset(pageBuffer + offsetof(StoredProfile, state), 0, sizeof(uint32_t));
+    return ops.program(flashOffset + slot * SLOT_SIZE, pageBuffer, SLOT_SIZE, ops.context)
+        && slotAt(slot)->state == 0;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// A reflow profile as it sits in flash: the temperature to reach at each
+// point in time from the start of the run. ProfileStore reads it in place
+// through the XIP window, so a catalogue of any size costs no RAM beyond its
+// index; ProfileService copies it out for anyone else.
+struct ProfilePoint {
+    float tempC;
+    uint32_t timeMs;            // From the start of the run, strictly increasing; the first may be 0
+};
+
+struct StoredProfile {
+    static constexpr size_t NAME_SIZE = 32;
+    static constexpr size_t MAX_POINTS = 16;
+
+    uint32_t magic;
+    uint32_t sequence;          // The newest copy of a name wins
+    uint32_t nameHash;          // ProfileStore::hashName(name)
+    uint8_t pointCount;
+    uint8_t reserved;
+    uint16_t crc;               // CRC-16 of the record except 'state' and the CRC itself
+    uint32_t state;             // Cleared in place once the profile is replaced or removed
+    char name[NAME_SIZE];       // NUL-terminated
+    ProfilePoint points[MAX_POINTS];
+};
+
+// Catalogue of reflow profiles in a region of flash sectors, one profile per
+// 256 byte page. A profile is written once to a free page and looked up by
+// index (in name order), by name or by name hash, returning a pointer into
+// the XIP window. A compaction can erase the page under such a pointer, so
+// it is only good until the next store() or remove(); ProfileService copies
+// the profile out under its mutex and never hands the pointer on. Replacing or removing a profile
+// clears the 'state' word of the old page in place (NOR flash can always
+// program more bits to zero), so no erase is needed until the free pages run
+// out. Then the live profiles of the sector with the most dead pages are
+// copied into a sector's worth of erased pages that is always held back, and
+// that sector is erased.
+//
+// Power-safe: a page torn by a power cut fails its CRC, and if power fails
+// between writing a new copy and retiring the old one, the higher sequence
+// number wins on the next mount.
+//
+// No Pico SDK dependencies: writes go through the erase / program callbacks,
+// which take offsets relative to the start of flash.
+class ProfileStore {
+public:
+    static constexpr size_t SECTOR_SIZE = 4096;
+    static constexpr size_t SLOT_SIZE = 256;
+    static constexpr size_t SLOTS_PER_SECTOR = SECTOR_SIZE / SLOT_SIZE;
+    static constexpr size_t MAX_SECTORS = 16;
+    static constexpr size_t MAX_SLOTS = MAX_SECTORS * SLOTS_PER_SECTOR;
+
+    enum class Result : uint8_t {
+        OK,
+        INVALID,                // Empty or unterminated name, no points or times not increasing after the first
+        FULL,
+        FLASH_ERROR
+    };
+
+    struct FlashOps {
+        bool (*erase)(uint32_t offset, size_t length, void* context);
+        bool (*program)(uint32_t offset, const uint8_t* data, size_t length, void* context);
+        void* context;
+    };
+
+    // 'mapped' is where the region at 'flashOffset' can be read from.
+    // 'sectorCount' is clamped to 2..MAX_SECTORS.
+    ProfileStore(const uint8_t* mapped, uint32_t flashOffset, size_t sectorCount, const FlashOps& ops);
+
+    // Scans the region and rebuilds the index. Never writes.
+    void mount();
+
+    size_t getCount() const { return count; }
+    // Less the reserved pages and one page for replacing a profile when full
+    size_t getCapacity() const { return sectorCount * SLOTS_PER_SECTOR - RESERVED_SLOTS - 1; }
+
+    // Pointers are into the XIP window and valid until the next store() or remove()
+    const StoredProfile* get(size_t index) const;
+    const StoredProfile* findByHash(uint32_t nameHash) const;
+    const StoredProfile* findByName(const char* name) const;
+
+    // Writes the name and points of 'profile' as the newest version of that
+    // name; the header fields are filled in here.
+    Result store(const StoredProfile& profile);
+    // False if there is no such profile or it could not be retired
+    bool remove(const char* name);
+
+    // FNV-1a
+    static uint32_t hashName(const char* name);
+    static bool isWellFormed(const StoredProfile& profile);
+
+private:
+    static constexpr uint32_t RECORD_MAGIC = 0x50524F46;   // "PROF"
+    static constexpr uint32_t STATE_LIVE = 0xFFFFFFFFu;
+    static constexpr uint16_t NO_SLOT = 0xFFFF;
+    // Erased pages held back: a sector's worth for compaction plus slack for pages torn by power cuts
+    static constexpr size_t RESERVED_SLOTS = SLOTS_PER_SECTOR + 4;
+
+    enum class SlotState : uint8_t { ERASED, LIVE, DEAD };
+
+    const StoredProfile* slotAt(size_t slot) const;
+    static uint16_t recordCrc(const StoredProfile& record);
+    static bool isErased(const uint8_t* data, size_t length);
+    bool isValid(const StoredProfile& record) const;
+
+    size_t findIndex(const char* name) const;
+    void insertIndex(uint16_t slot);
+    bool sectorErased(size_t sector) const;
+
+    uint16_t allocate(Result* result);
+    uint16_t freeSlot() const;
+    Result compact();
+    bool writeRecord(uint16_t slot, const StoredProfile& profile);
+    bool retire(uint16_t slot);
+
+    const uint8_t* mapped;
+    uint32_t flashOffset;
+    size_t sectorCount;
+    FlashOps ops;
+
+    uint32_t nextSequence;
+    SlotState slots[MAX_SLOTS];
+    uint16_t index[MAX_SLOTS];  // Live slots in name order
+    size_t count;
+    uint8_t pageBuffer[SLOT_SIZE];
+};
@@ -0,0 +1,86 @@
+#include "library/profile_table.h"
+
+static_assert(ReflowCurve::MAX_STEPS <= ProfileTable::MAX_SEGMENTS, "every curve must fit the segment table");
+
+ProfileTable::ProfileTable() {
+    clear();
+}
+
+void ProfileTable::clear() {
+    segmentCount = 0;
+    totalDurationMs = 0;
+    bucketMs = 1;
+    for (size_t i = 0; i < INDEX_BUCKETS; ++i) {
+        bucketSegment[i] = 0;
+    }
+}
+
+bool ProfileTable::build(const ReflowCurve& curve, float startTemp) {
+    clear();
+    if (curve.stepCount == 0 || curve.stepCount > MAX_SEGMENTS) return false;
+
+    uint32_t time = 0;
+    float temp = startTemp;
+    for (const ReflowStep& step : curve.getSteps()) {
+        Segment& segment = segments[segmentCount++];
+        segment.startMs = time;
+        segment.endMs = time + step.durationMs;
+        segment.startTemp = temp;
+        segment.endTemp = step.targetTempC;
+        segment.slope = (step.durationMs > 0) ? (step.targetTempC - temp) / static_cast<float>(step.durationMs) : 0.0f;
+        time = segment.endMs;
+        temp = step.targetTempC;
+    }
+    totalDurationMs = time;
+
+    // Round the bucket width up so the last bucket still covers the end of the profile
+    bucketMs = totalDurationMs / INDEX_BUCKETS + 1;
+    size_t segment = 0;
+    for (size_t bucket = 0; bucket < INDEX_BUCKETS; ++bucket) {
+        uint32_t bucketStart = static_cast<uint32_t>(bucket) * bucketMs;
+        while (segment + 1 < segmentCount && segments[segment].endMs <= bucketStart) {
+            segment++;
+        }
+        bucketSegment[bucket] = static_cast<uint8_t>(segment);
+    }
+    return true;
+}
+
+ProfileTable::Setpoint ProfileTable::at(uint32_t elapsedMs) const {
+    Setpoint setpoint = {0.0f, 0.0f, 0, true};
+    if (segmentCount == 0) return setpoint;
+
+    if (elapsedMs >= totalDurationMs) {
+        const Segment& last = segments[segmentCount - 1];
+        setpoint.temp = last.endTemp;
+        setpoint.stepIndex = static_cast<uint8_t>(segmentCount - 1);
+        return setpoint;
+    }
+
+    size_t index = findSegment(elapsedMs);
+    const Segment& segment = segments[index];
+    setpoint.temp = segment.startTemp + segment.slope * static_cast<float>(elapsedMs - segment.startMs);
+    setpoint.rate = segment.slope * 1000.0f;
+    setpoint.stepIndex = static_cast<uint8_t>(index);
+    setpoint.complete = false;
+    return setpoint;
+}
+
+ProfileTable::Setpoint ProfileTable::lookahead(uint32_t elapsedMs, uint32_t horizonMs, float* meanRate) const {
+    Setpoint now = at(elapsedMs);
+    Setpoint ahead = at(elapsedMs + horizonMs);
+    if (meanRate) {
+        *meanRate = (horizonMs > 0) ? (ahead.temp - now.temp) * 1000.0f / static_cast<float>(horizonMs) : now.rate;
+    }
+    return ahead;
+}
+
+size_t ProfileTable::findSegment(uint32_t elapsedMs) const {
+    size_t bucket = elapsedMs / bucketMs;
+    size_t index = bucketSegment[bucket < INDEX_BUCKETS ? bucket : INDEX_BUCKETS - 1];
+    // A bucket spans at most a handful of segment boundaries
+    while (index + 1 < segmentCount && elapsedMs >= segments[index].endMs) {
+        index++;
+    }
+    return index;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "models/reflow_model.h"
+
+// Piecewise-linear setpoint table precomputed from a ReflowCurve. Each step
+// becomes one segment ramping from the previous step's target (or the start
+// temperature) to its own. A coarse time-bucket index maps any elapsed time
+// straight to its segment, so lookups cost the same whatever the profile
+// length and allocate nothing. No Pico SDK or FreeRTOS dependencies.
+class ProfileTable {
+public:
+    static constexpr size_t MAX_SEGMENTS = 16;
+    static constexpr size_t INDEX_BUCKETS = 64;
+
+    struct Segment {
+        uint32_t startMs;
+        uint32_t endMs;
+        float startTemp;
+        float endTemp;
+        float slope;  // °C per ms
+    };
+
+    struct Setpoint {
+        float temp;
+        float rate;         // °C/s of the segment in effect
+        uint8_t stepIndex;
+        bool complete;      // elapsed time is past the end of the profile
+    };
+
+    ProfileTable();
+
+    // Returns false if the curve is empty or has more steps than MAX_SEGMENTS
+    bool build(const ReflowCurve& curve, float startTemp);
+    void clear();
+
+    Setpoint at(uint32_t elapsedMs) const;
+    // Setpoint a fixed time ahead, and the mean ramp rate (°C/s) between now and then.
+    // The mean rate anticipates corners in the profile before they arrive.
+    Setpoint lookahead(uint32_t elapsedMs, uint32_t horizonMs, float* meanRate) const;
+
+    size_t getSegmentCount() const { return segmentCount; }
+    const Segment& getSegment(size_t index) const { return segments[index]; }
+    uint32_t getTotalDurationMs() const { return totalDurationMs; }
+    bool isEmpty() const { return segmentCount == 0; }
+
+private:
+    size_t findSegment(uint32_t elapsedMs) const;
+
+    Segment segments[MAX_SEGMENTS];
+    size_t segmentCount;
+    uint32_t totalDurationMs;
+    uint32_t bucketMs;
+    uint8_t bucketSegment[INDEX_BUCKETS];  // First segment overlapping each bucket
+};
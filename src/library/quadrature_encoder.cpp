@@ -0,0 +1,43 @@
+#include "library/quadrature_encoder.h"
+#include "hardware/clocks.h"
+#include "quadrature_encoder.pio.h"
+
+QuadratureEncoder::QuadratureEncoder(PIO pio, uint pinA) : pio(pio), pinA(pinA) {}
+
+void QuadratureEncoder::init(uint32_t clockHz) {
+    float clkDiv = static_cast<float>(clock_get_hz(clk_sys)) / clockHz;
+    if (clkDiv < 1.0f) clkDiv = 1.0f;
+
+    pio_add_program_at_offset(pio, &quadrature_encoder_program, 0);
+    sm = pio_claim_unused_sm(pio, true);
+    quadrature_encoder_program_init(pio, sm, pinA, clkDiv);
+}
+
+int32_t QuadratureEncoder::getCount() const {
+    // The state machine pushes the count every loop; drain the FIFO and wait
+    // for one more so the value is current rather than whatever was queued
+    uint32_t value = 0;
+    uint level = pio_sm_get_rx_fifo_level(pio, sm) + 1;
+    while (level-- > 0) {
+        value = pio_sm_get_blocking(pio, sm);
+    }
+    return static_cast<int32_t>(value);
+}
+
+void QuadratureEncoder::arm() {
+    pio_interrupt_clear(pio, sm);
+    pio_set_irq0_source_enabled(pio, movedSource(), true);
+}
+
+void QuadratureEncoder::disarm() {
+    pio_set_irq0_source_enabled(pio, movedSource(), false);
+}
+
+uint QuadratureEncoder::getIrq() const {
+    return pio_get_irq_num(pio, 0);
+}
+
+pio_interrupt_source_t QuadratureEncoder::movedSource() const {
+    // 'irq nowait 0 rel' sets the flag numbered after the state machine
+    return static_cast<pio_interrupt_source_t>(pis_interrupt0 + sm);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Rotary encoder decoded entirely by a PIO state machine. The CPU takes no
+// per-edge interrupts; it reads the running position count whenever it likes,
+// and can ask for a single interrupt on the next movement. Bounce on one
+// channel cancels out in the Gray-code decoding; nothing is debounced in time.
+// Channel B must be on the GPIO right after channel A. The program's jump table
+// has to live at instruction 0, so the encoder takes a PIO block of its own.
+class QuadratureEncoder {
+public:
+    QuadratureEncoder(PIO pio, uint pinA);
+
+    // State machine clock; one sample takes about 7 cycles
+    void init(uint32_t clockHz);
+
+    // Quadrature counts (four per full electrical cycle) since init
+    int32_t getCount() const;
+
+    // Movement interrupt, on the PIO's IRQ 0 line. arm() clears any earlier
+    // movement and enables it; the handler should disarm() so a fast spin
+    // raises one interrupt and not one per count.
+    void arm();
+    void disarm();
+    uint getIrq() const;
+
+private:
+    pio_interrupt_source_t movedSource() const;
+
+    PIO pio;
+    uint pinA;
+    int sm = -1;
+};
@@ -1,57 +1,36 @@
 #include "library/reflow_curve_library.h"
+#include <string.h>
 
-std::vector<ReflowCurve> ReflowCurveLibrary::builtInCurves;
-bool ReflowCurveLibrary::initialized = false;
+static constexpr ReflowCurve BUILT_IN_CURVES[] = {
+    makeReflowCurve("Lead-Free (SAC305)", 50.0f, {
+        {StepLabel::PREHEAT, 150.0f, 60000},
+        {StepLabel::SOAK, 180.0f, 90000},
+        {StepLabel::REFLOW, 245.0f, 30000},
+        {StepLabel::COOLDOWN, 50.0f, 60000}
+    }),
+    makeReflowCurve("Leaded (Sn63Pb37)", 50.0f, {
+        {StepLabel::PREHEAT, 140.0f, 60000},
+        {StepLabel::SOAK, 160.0f, 90000},
+        {StepLabel::REFLOW, 215.0f, 30000},
+        {StepLabel::COOLDOWN, 50.0f, 60000}
+    }, 183.0f),
+    makeReflowCurve("Custom Profile", 50.0f, { // Placeholder
+        {StepLabel::PREHEAT, 120.0f, 30000},
+        {StepLabel::RAMP_UP, 200.0f, 60000},
+        {StepLabel::REFLOW, 230.0f, 30000},
+        {StepLabel::COOLDOWN, 50.0f, 60000}
+    })
+};
 
-void ReflowCurveLibrary::initialize() {
-    if (initialized) return;
-    initialized = true;
-
-    builtInCurves = {
-        {
-            "Lead-Free (SAC305)",
-            50.0f,
-            {
-                {"Preheat", 150.0f, 60000},
-                {"Soak", 180.0f, 90000},
-                {"Reflow", 245.0f, 30000},
-                {"Cooldown", 50.0f, 60000}
-            }
-        },
-        {
-            "Leaded (Sn63Pb37)",
-            50.0f,
-            {
-                {"Preheat", 140.0f, 60000},
-                {"Soak", 160.0f, 90000},
-                {"Reflow", 215.0f, 30000},
-                {"Cooldown", 50.0f, 60000}
-            }
-        },
-        {
-            "Custom Profile", // Placeholder
-            50.0f,
-            {
-                {"Preheat", 120.0f, 30000},
-                {"Ramp Up", 200.0f, 60000},
-                {"Reflow", 230.0f, 30000},
-                {"Cooldown", 50.0f, 60000}
-            }
-        }
-    };
+ArrayView<ReflowCurve> ReflowCurveLibrary::getBuiltInCurves() {
+    return BUILT_IN_CURVES;
 }
 
-const std::vector<ReflowCurve>& ReflowCurveLibrary::getBuiltInCurves() {
-    initialize();
-    return builtInCurves;
-}
-
-std::optional<ReflowCurve> ReflowCurveLibrary::getCurveByName(const std::string& name) {
-    initialize();
-    for (const auto& curve : builtInCurves) {
-        if (curve.name == name) {
-            return curve;
+const ReflowCurve* ReflowCurveLibrary::getCurveByName(const char* name) {
+    for (const ReflowCurve& curve : BUILT_IN_CURVES) {
+        if (strcmp(curve.name, name) == 0) {
+            return &curve;
         }
     }
-    return std::nullopt;
-}
\ No newline at end of file
+    return nullptr;
+}
@@ -1,16 +1,12 @@
 #pragma once
 
 #include "models/reflow_model.h"
-#include <vector>
-#include <optional>
+#include "library/array_view.h"
 
+// The built-in curves, built at compile time into flash
 class ReflowCurveLibrary {
 public:
-    static const std::vector<ReflowCurve>& getBuiltInCurves();
-    static std::optional<ReflowCurve> getCurveByName(const std::string& name);
-
-private:
-    static std::vector<ReflowCurve> builtInCurves;
-    static void initialize();
-    static bool initialized;
-};
\ No newline at end of file
+    static ArrayView<ReflowCurve> getBuiltInCurves();
+    // Null if there is no built-in curve of that name
+    static const ReflowCurve* getCurveByName(const char* name);
+};
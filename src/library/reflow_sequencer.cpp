@@ -0,0 +1,70 @@
+#include "library/reflow_sequencer.h"
+
+ReflowSequencer::ReflowSequencer(const ControlOps& ops)
+    : ops(ops),
+      curve{},
+      startMs(0),
+      runState(ReflowRunState::IDLE),
+      abortRequested(false) {}
+
+bool ReflowSequencer::start(const ReflowCurve& newCurve, float startTemp, uint32_t nowMs) {
+    if (runState == ReflowRunState::RUNNING) return false;
+
+    // update() only touches the table while RUNNING, so it is safe to rebuild here.
+    // A fixed-size copy rather than a reference: an uploaded profile's page can move mid-run.
+    curve = newCurve;
+    if (!table.build(curve, startTemp)) {
+        return false;
+    }
+
+    abortRequested = false;
+    startMs = nowMs;
+    runState = ReflowRunState::RUNNING;
+    return true;
+}
+
+void ReflowSequencer::abort() {
+    if (runState != ReflowRunState::RUNNING) return;
+    abortRequested = true;
+}
+
+ReflowProgress ReflowSequencer::update(uint32_t nowMs) {
+    uint32_t elapsedMs = nowMs - startMs;
+
+    if (abortRequested) {
+        finish(ReflowRunState::ABORTED);
+        return makeProgress(ReflowRunState::ABORTED, elapsedMs);
+    }
+
+    if (elapsedMs >= table.getTotalDurationMs()) {
+        finish(ReflowRunState::COMPLETE);
+        return makeProgress(ReflowRunState::COMPLETE, table.getTotalDurationMs());
+    }
+
+    ReflowProgress snapshot = makeProgress(ReflowRunState::RUNNING, elapsedMs);
+    ops.setTarget(snapshot.setpoint, snapshot.lookaheadRate, ops.context);
+    return snapshot;
+}
+
+void ReflowSequencer::finish(ReflowRunState finalState) {
+    ops.stopHeating(ops.context);
+    runState = finalState;
+    abortRequested = false;
+}
+
+ReflowProgress ReflowSequencer::makeProgress(ReflowRunState state, uint32_t elapsedMs) const {
+    ReflowProgress snapshot = {};
+    snapshot.runState = state;
+    snapshot.elapsedMs = elapsedMs;
+    snapshot.totalMs = table.getTotalDurationMs();
+    snapshot.stepCount = static_cast<uint8_t>(table.getSegmentCount());
+    if (table.isEmpty()) return snapshot;
+
+    ProfileTable::Setpoint setpoint = table.at(elapsedMs);
+    ProfileTable::Setpoint ahead = table.lookahead(elapsedMs, LOOKAHEAD_MS, &snapshot.lookaheadRate);
+    snapshot.stepIndex = setpoint.stepIndex;
+    snapshot.setpoint = setpoint.temp;
+    snapshot.rampRate = setpoint.rate;
+    snapshot.lookaheadSetpoint = ahead.temp;
+    return snapshot;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+#include "models/reflow_model.h"
+#include "types/reflow_progress.h"
+#include "library/profile_table.h"
+#include "constants.h"
+
+// The reflow run state machine behind ReflowEngine: builds the curve's
+// ProfileTable at start, and on every tick either hands the setpoint and
+// lookahead ramp rate to the temperature loop or, once the profile is over or
+// an abort was asked for, stops heating. The loop is reached through the
+// ControlOps callbacks, so the host simulator runs exactly this code. No Pico
+// SDK or FreeRTOS dependencies; ReflowEngine provides the task and locking.
+class ReflowSequencer {
+public:
+    struct ControlOps {
+        void (*setTarget)(float temp, float rampRate, void* context);
+        void (*stopHeating)(void* context);
+        void* context;
+    };
+
+    explicit ReflowSequencer(const ControlOps& ops);
+
+    // Copies the curve; the first step ramps from 'startTemp'. Returns false if
+    // a run is active or the curve does not fit the segment table.
+    bool start(const ReflowCurve& curve, float startTemp, uint32_t nowMs);
+    // Takes effect on the next update()
+    void abort();
+
+    // One engine tick while running; returns the progress to publish
+    ReflowProgress update(uint32_t nowMs);
+
+    bool isRunning() const { return runState == ReflowRunState::RUNNING; }
+    bool isAbortRequested() const { return abortRequested; }
+    ReflowRunState getRunState() const { return runState; }
+    const ReflowCurve& getCurve() const { return curve; }
+    const ProfileTable& getTable() const { return table; }
+
+    ReflowProgress makeProgress(ReflowRunState state, uint32_t elapsedMs) const;
+
+private:
+    static constexpr uint32_t LOOKAHEAD_MS = static_cast<uint32_t>(REFLOW_FEEDFORWARD_HORIZON_S * 1000.0f);
+
+    void finish(ReflowRunState finalState);
+
+    ControlOps ops;
+    ReflowCurve curve;
+    ProfileTable table;
+    uint32_t startMs;
+    volatile ReflowRunState runState;
+    volatile bool abortRequested;
+};
@@ -0,0 +1,126 @@
+#include "library/render_scheduler.h"
+#include "constants.h"
+
+void RenderScheduler::init(lv_display_t* display) {
+    this->display = display;
+    lv_tick_set_cb(tickMs);
+
+    lv_display_add_event_cb(display, displayEventCallback, LV_EVENT_INVALIDATE_AREA, this);
+    lv_display_add_event_cb(display, displayEventCallback, LV_EVENT_REFR_START, this);
+    lv_display_add_event_cb(display, displayEventCallback, LV_EVENT_REFR_READY, this);
+}
+
+void RenderScheduler::run() {
+    task = xTaskGetCurrentTaskHandle();
+    windowStartUs = time_us_64();
+
+    while (true) {
+        windowWakeups++;
+        if (beforeTimers) beforeTimers(hookContext);
+        uint32_t untilNextMs = lv_timer_handler();
+        sleep(untilNextMs);
+    }
+}
+
+void RenderScheduler::requestRender() {
+    TaskHandle_t target = task;
+    if (target && target != xTaskGetCurrentTaskHandle()) {
+        xTaskNotifyGive(target);
+    }
+}
+
+void RenderScheduler::requestRenderFromISR(BaseType_t* higherPriorityTaskWoken) {
+    TaskHandle_t target = task;
+    if (target) {
+        vTaskNotifyGiveFromISR(target, higherPriorityTaskWoken);
+    }
+}
+
+RenderStats RenderScheduler::getStats() const {
+    return stats.read();
+}
+
+void RenderScheduler::setHooks(Hook beforeTimers, Hook frameDone, void* context) {
+    this->beforeTimers = beforeTimers;
+    this->frameDone = frameDone;
+    hookContext = context;
+}
+
+uint32_t RenderScheduler::tickMs() {
+    return static_cast<uint32_t>(time_us_64() / 1000);
+}
+
+void RenderScheduler::displayEventCallback(lv_event_t* e) {
+    auto* scheduler = static_cast<RenderScheduler*>(lv_event_get_user_data(e));
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_INVALIDATE_AREA:
+            lv_timer_resume(lv_display_get_refr_timer(scheduler->display));
+            scheduler->requestRender();
+            break;
+        case LV_EVENT_REFR_START:
+            scheduler->onRefreshStart();
+            break;
+        case LV_EVENT_REFR_READY:
+            scheduler->onRefreshReady();
+            break;
+        default:
+            break;
+    }
+}
+
+void RenderScheduler::onRefreshStart() {
+    frameStartUs = time_us_64();
+}
+
+void RenderScheduler::onRefreshReady() {
+    // Nothing left to draw; the next invalidation resumes the refresh timer
+    lv_timer_pause(lv_display_get_refr_timer(display));
+
+    lastFrameUs = static_cast<uint32_t>(time_us_64() - frameStartUs);
+    totalFrames++;
+    windowFrames++;
+    windowFrameUs += lastFrameUs;
+    if (lastFrameUs > windowMaxFrameUs) windowMaxFrameUs = lastFrameUs;
+
+    if (frameDone) frameDone(hookContext);
+}
+
+void RenderScheduler::sleep(uint32_t untilNextMs) {
+    if (untilNextMs == 0) {
+        taskYIELD();
+        accountWindow(time_us_64());
+        return;
+    }
+
+    uint32_t sleepMs = untilNextMs < UI_RENDER_MAX_SLEEP_MS ? untilNextMs : UI_RENDER_MAX_SLEEP_MS;
+    // Round up so a timer is never checked a tick early and immediately slept on again
+    TickType_t ticks = static_cast<TickType_t>((static_cast<uint64_t>(sleepMs) * configTICK_RATE_HZ + 999) / 1000);
+
+    uint64_t sleepStartUs = time_us_64();
+    ulTaskNotifyTake(pdTRUE, ticks);
+    uint64_t nowUs = time_us_64();
+    windowSleepUs += nowUs - sleepStartUs;
+    accountWindow(nowUs);
+}
+
+void RenderScheduler::accountWindow(uint64_t nowUs) {
+    uint64_t elapsedUs = nowUs - windowStartUs;
+    if (elapsedUs < static_cast<uint64_t>(RENDER_STATS_WINDOW_MS) * 1000) return;
+
+    RenderStats snapshot;
+    snapshot.lastFrameUs = lastFrameUs;
+    snapshot.maxFrameUs = windowMaxFrameUs;
+    snapshot.averageFrameUs = windowFrames ? static_cast<uint32_t>(windowFrameUs / windowFrames) : 0;
+    snapshot.frames = windowFrames;
+    snapshot.wakeups = windowWakeups;
+    snapshot.idlePercent = 100.0f * static_cast<float>(windowSleepUs) / static_cast<float>(elapsedUs);
+    snapshot.totalFrames = totalFrames;
+    stats.write(snapshot);
+
+    windowStartUs = nowUs;
+    windowSleepUs = 0;
+    windowFrameUs = 0;
+    windowMaxFrameUs = 0;
+    windowFrames = 0;
+    windowWakeups = 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lvgl.h"
+#include "types/render_stats.h"
+#include "library/seq_lock.h"
+
+// Event-driven LVGL loop. The LVGL tick comes from the microsecond timer, and
+// the calling task sleeps until the next LVGL timer is due or until something
+// asks for a render (an invalidated area, an input event). The display refresh
+// timer is paused once a frame is out and resumed on the next invalidation, so
+// a static screen costs no wakeups at all.
+class RenderScheduler {
+public:
+    using Hook = void (*)(void* context);
+
+    // Hooks the LVGL tick and the display's invalidate / refresh events; call
+    // after the display is created and before run()
+    void init(lv_display_t* display);
+
+    // Never returns; must be called from the task that owns LVGL
+    void run();
+
+    // Wake the render task early. Safe from any task, and from ISRs via the FromISR variant.
+    void requestRender();
+    void requestRenderFromISR(BaseType_t* higherPriorityTaskWoken);
+
+    RenderStats getStats() const;
+
+    // Both run on the render task: 'beforeTimers' on every wakeup ahead of the
+    // LVGL timers, 'frameDone' once a refresh has been fully flushed
+    void setHooks(Hook beforeTimers, Hook frameDone, void* context);
+
+private:
+    static uint32_t tickMs();
+    static void displayEventCallback(lv_event_t* e);
+    void onRefreshStart();
+    void onRefreshReady();
+    void sleep(uint32_t untilNextMs);
+    void accountWindow(uint64_t nowUs);
+
+    lv_display_t* display = nullptr;
+    volatile TaskHandle_t task = nullptr;
+    Hook beforeTimers = nullptr;
+    Hook frameDone = nullptr;
+    void* hookContext = nullptr;
+
+    uint64_t frameStartUs = 0;
+    uint32_t lastFrameUs = 0;
+    uint32_t totalFrames = 0;
+
+    // Current statistics window
+    uint64_t windowStartUs = 0;
+    uint64_t windowSleepUs = 0;
+    uint64_t windowFrameUs = 0;
+    uint32_t windowMaxFrameUs = 0;
+    uint16_t windowFrames = 0;
+    uint16_t windowWakeups = 0;
+
+    SeqLock<RenderStats> stats;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// Single-producer / single-consumer lock-free ring buffer.
+// The producer may be an ISR on one core and the consumer a task on the other;
+// head and tail are only ever written by one side each.
+template <typename T, size_t Capacity>
+class RingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer side. Returns false (and drops the item) when the buffer is full.
+    bool push(const T& item) {
+        uint32_t head = this->head.load(std::memory_order_relaxed);
+        uint32_t tail = this->tail.load(std::memory_order_acquire);
+        if (head - tail >= Capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        items[head & (Capacity - 1)] = item;
+        this->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when the buffer is empty.
+    bool pop(T& out) {
+        uint32_t tail = this->tail.load(std::memory_order_relaxed);
+        uint32_t head = this->head.load(std::memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+        out = items[tail & (Capacity - 1)];
+        this->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Drains everything and keeps only the newest item.
+    bool popLatest(T& out) {
+        bool any = false;
+        while (pop(out)) {
+            any = true;
+        }
+        return any;
+    }
+
+    size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    bool isEmpty() const { return size() == 0; }
+    uint32_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    T items[Capacity] = {};
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+    std::atomic<uint32_t> dropped{0};
+};
@@ -0,0 +1,143 @@
+#include "library/run_log.h"
+#include "library/frame_encoder.h"
+#include <string.h>
+
+namespace {
+
+size_t putVarint(uint8_t* out, int32_t value) {
+    uint32_t zigzag = (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    size_t length = 0;
+    while (zigzag >= 0x80) {
+        out[length++] = static_cast<uint8_t>(zigzag | 0x80);
+        zigzag >>= 7;
+    }
+    out[length++] = static_cast<uint8_t>(zigzag);
+    return length;
+}
+
+bool getVarint(const uint8_t* data, size_t limit, size_t* position, int32_t* value) {
+    uint32_t zigzag = 0;
+    for (int shift = 0; shift < 35 && *position < limit; shift += 7) {
+        uint8_t byte = data[(*position)++];
+        zigzag |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = static_cast<int32_t>(zigzag >> 1) ^ -static_cast<int32_t>(zigzag & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint16_t pageCrc(const RunLog::PageHeader& header, const uint8_t* body) {
+    uint16_t crc = FrameEncoder::crc16(reinterpret_cast<const uint8_t*>(&header), offsetof(RunLog::PageHeader, crc));
+    return FrameEncoder::crc16(body, header.length, crc);
+}
+
+}
+
+void RunLogPageWriter::begin(uint32_t runId, uint32_t firstSample, uint16_t samplePeriodMs, const RunInfo* info) {
+    this->runId = runId;
+    this->firstSample = firstSample;
+    this->samplePeriodMs = samplePeriodMs;
+    hasInfo = (info != nullptr);
+    if (hasInfo) this->info = *info;
+    previous = {};
+    sampleCount = 0;
+    used = 0;
+    capacity = CAPACITY - (hasInfo ? sizeof(RunInfo) : 0);
+}
+
+bool RunLogPageWriter::add(const RunSample& sample) {
+    if (sampleCount == UINT8_MAX) return false;
+
+    // Differences from the previous sample; the first one is against zero, i.e. absolute
+    uint8_t encoded[MAX_SAMPLE_BYTES];
+    size_t length = 0;
+    length += putVarint(encoded + length, sample.setpointDeciC - previous.setpointDeciC);
+    length += putVarint(encoded + length, sample.tempDeciC - previous.tempDeciC);
+    length += putVarint(encoded + length, sample.heaterPercent - previous.heaterPercent);
+    length += putVarint(encoded + length, sample.doorPercent - previous.doorPercent);
+    if (used + length > capacity) return false;
+
+    memcpy(samples + used, encoded, length);
+    used += length;
+    previous = sample;
+    sampleCount++;
+    return true;
+}
+
+void RunLogPageWriter::finish(const RunEnd* end, uint8_t* page) {
+    RunLog::PageHeader header = {};
+    header.magic = RunLog::PAGE_MAGIC;
+    header.flags = (hasInfo ? RunLog::FIRST_PAGE : 0) | (end ? RunLog::LAST_PAGE : 0);
+    header.sampleCount = sampleCount;
+    header.runId = runId;
+    header.firstSample = firstSample;
+    header.samplePeriodMs = samplePeriodMs;
+
+    memset(page, 0xFF, RunLog::PAGE_SIZE);
+    uint8_t* body = page + sizeof(header);
+    size_t length = 0;
+    if (hasInfo) {
+        memcpy(body + length, &info, sizeof(info));
+        length += sizeof(info);
+    }
+    if (end) {
+        memcpy(body + length, end, sizeof(*end));
+        length += sizeof(*end);
+    }
+    memcpy(body + length, samples, used);
+    length += used;
+
+    header.length = static_cast<uint16_t>(length);
+    header.crc = pageCrc(header, body);
+    memcpy(page, &header, sizeof(header));
+}
+
+bool RunLogPageReader::open(const uint8_t* page) {
+    memcpy(&header, page, sizeof(header));
+    if (header.magic != RunLog::PAGE_MAGIC) return false;
+    if (header.length > RunLog::PAGE_SIZE - sizeof(header)) return false;
+    if (header.crc != pageCrc(header, page + sizeof(header))) return false;
+
+    this->page = page + sizeof(header);
+    position = 0;
+    if (header.flags & RunLog::FIRST_PAGE) position += sizeof(RunInfo);
+    if (header.flags & RunLog::LAST_PAGE) position += sizeof(RunEnd);
+    limit = header.length;
+    decoded = 0;
+    previous = {};
+    return position <= limit;
+}
+
+bool RunLogPageReader::getInfo(RunInfo* info) const {
+    if (!(header.flags & RunLog::FIRST_PAGE)) return false;
+    memcpy(info, page, sizeof(*info));
+    info->curveName[sizeof(info->curveName) - 1] = '\0';
+    return true;
+}
+
+bool RunLogPageReader::getEnd(RunEnd* end) const {
+    if (!(header.flags & RunLog::LAST_PAGE)) return false;
+    size_t offset = (header.flags & RunLog::FIRST_PAGE) ? sizeof(RunInfo) : 0;
+    memcpy(end, page + offset, sizeof(*end));
+    return true;
+}
+
+bool RunLogPageReader::next(RunSample* sample) {
+    if (decoded >= header.sampleCount) return false;
+
+    int32_t setpoint, temp, heater, door;
+    if (!getVarint(page, limit, &position, &setpoint) || !getVarint(page, limit, &position, &temp) ||
+        !getVarint(page, limit, &position, &heater) || !getVarint(page, limit, &position, &door)) {
+        return false;
+    }
+
+    previous.setpointDeciC = static_cast<int16_t>(previous.setpointDeciC + setpoint);
+    previous.tempDeciC = static_cast<int16_t>(previous.tempDeciC + temp);
+    previous.heaterPercent = static_cast<uint8_t>(previous.heaterPercent + heater);
+    previous.doorPercent = static_cast<uint8_t>(previous.doorPercent + door);
+    decoded++;
+    *sample = previous;
+    return true;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// On-flash format of the reflow run log. The log is a ring of 256 byte pages,
+// each programmed once and decodable on its own:
+//
+//   PageHeader | RunInfo (first page of a run) | RunOutcome (last page) | samples
+//
+// The first sample of a page is stored absolute and the rest as differences
+// from the previous one, every field as a zigzag varint. A sample of a smooth
+// run is 4-5 bytes, so a page holds about 50 of them. Pages carry their run
+// id, the index of their first sample within the run and the sample period,
+// so their samples keep their place and time when the oldest pages of the run
+// have been overwritten. A page torn by a power cut fails its CRC and is
+// skipped. No Pico SDK dependencies.
+
+struct RunSample {
+    int16_t setpointDeciC;      // 0.1 °C
+    int16_t tempDeciC;          // 0.1 °C
+    uint8_t heaterPercent;
+    uint8_t doorPercent;
+};
+
+struct RunInfo {
+    char curveName[24];         // NUL-terminated
+};
+
+enum class RunOutcome : uint8_t {
+    INTERRUPTED,                // No last page: power was lost or the log was cut short
+    COMPLETE,
+    ABORTED
+};
+
+struct RunEnd {
+    RunOutcome outcome;
+    uint8_t reserved;
+    int16_t peakDeciC;
+};
+
+namespace RunLog {
+
+constexpr size_t PAGE_SIZE = 256;
+constexpr uint16_t PAGE_MAGIC = 0x3252;  // "R2", changed with the page layout
+
+enum PageFlags : uint8_t {
+    FIRST_PAGE = 0x01,          // RunInfo follows the header
+    LAST_PAGE = 0x02            // RunEnd follows the header (and RunInfo)
+};
+
+struct PageHeader {
+    uint16_t magic;
+    uint8_t flags;
+    uint8_t sampleCount;
+    uint32_t runId;
+    uint32_t firstSample;       // Index of the page's first sample within the run
+    uint16_t samplePeriodMs;
+    uint16_t length;            // Bytes after the header
+    uint16_t reserved;
+    uint16_t crc;               // CRC-16 of the header up to here and the rest of the page
+};
+
+}
+
+// Fills one page in RAM; the caller programs it once finish() has been called
+class RunLogPageWriter {
+public:
+    void begin(uint32_t runId, uint32_t firstSample, uint16_t samplePeriodMs, const RunInfo* info);
+    // False, and nothing is added, when the page is full
+    bool add(const RunSample& sample);
+    // Lays the page out in 'page' (RunLog::PAGE_SIZE bytes, the unused tail erased)
+    void finish(const RunEnd* end, uint8_t* page);
+
+    uint8_t getSampleCount() const { return sampleCount; }
+
+private:
+    static constexpr size_t MAX_SAMPLE_BYTES = 10;
+    static constexpr size_t CAPACITY = RunLog::PAGE_SIZE - sizeof(RunLog::PageHeader) - sizeof(RunEnd);
+
+    uint32_t runId;
+    uint32_t firstSample;
+    uint16_t samplePeriodMs;
+    bool hasInfo;
+    RunInfo info;
+    RunSample previous;
+    uint8_t sampleCount;
+    size_t used;
+    size_t capacity;
+    uint8_t samples[CAPACITY];
+};
+
+class RunLogPageReader {
+public:
+    // False if the page is erased, torn or not a run log page
+    bool open(const uint8_t* page);
+
+    const RunLog::PageHeader& getHeader() const { return header; }
+    bool getInfo(RunInfo* info) const;
+    bool getEnd(RunEnd* end) const;
+    // Samples in order; false after the last one
+    bool next(RunSample* sample);
+
+private:
+    const uint8_t* page;
+    RunLog::PageHeader header;
+    size_t position;
+    size_t limit;
+    uint8_t decoded;
+    RunSample previous;
+};
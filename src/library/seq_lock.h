@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+// Sequence lock for publishing a small POD snapshot from one writer to any
+// number of readers on either core. Readers never block the writer and never
+// allocate; they simply retry if a write overlapped their copy.
+// Writers must be serialised by the caller (e.g. a critical section).
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable type");
+
+public:
+    void write(const T& value) {
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);  // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&this->value, &value, sizeof(T));
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    T read() const {
+        T out;
+        while (!tryRead(out)) {
+        }
+        return out;
+    }
+
+    // Single attempt; returns false if a write was in progress or overlapped
+    bool tryRead(T& out) const {
+        uint32_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1) return false;
+        memcpy(&out, &value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    uint32_t getSequence() const { return sequence.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<uint32_t> sequence{0};
+    T value{};
+};
@@ -12,21 +12,37 @@ void SHT30::init()
 
 bool SHT30::readAll(float *temperature, float *humidity)
 {
-  uint8_t buffer[6];
-  if (!this->sendCommand(0x2C06))
-  { // Command to start a high repeatability measurement
+  if (!this->startMeasurement())
+  {
     printf("Failed to start measurement\n");
     return false;
   }
 
-  sleep_ms(500); // Delay for measurement to complete
+  sleep_ms(MEASUREMENT_TIME_MS); // Delay for measurement to complete
 
-  if (!this->readSensorData(buffer, 6))
+  if (!this->readMeasurement(temperature, humidity))
   {
     printf("Failed to read data\n");
     return false;
   }
 
+  return true;
+}
+
+bool SHT30::startMeasurement()
+{
+  // High repeatability, no clock stretching: the sensor NACKs reads until the result is ready
+  return this->sendCommand(0x2400);
+}
+
+bool SHT30::readMeasurement(float *temperature, float *humidity)
+{
+  uint8_t buffer[6];
+  if (!this->readSensorData(buffer, 6))
+  {
+    return false;
+  }
+
   // Process the raw data from the sensor
   uint16_t tempRaw = (buffer[0] << 8) | buffer[1];
   uint16_t humRaw = (buffer[3] << 8) | buffer[4];
@@ -11,6 +11,12 @@ public:
   void init();
   bool readAll(float *temperature, float *humidity);
 
+  // Non-blocking single shot: start, wait MEASUREMENT_TIME_MS elsewhere, then collect
+  bool startMeasurement();
+  bool readMeasurement(float *temperature, float *humidity);
+
+  static const uint32_t MEASUREMENT_TIME_MS = 20; // High repeatability takes up to 15ms
+
 private:
   i2c_inst_t *i2cPort;
   uint8_t address;
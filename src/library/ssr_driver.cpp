@@ -0,0 +1,138 @@
+#include "library/ssr_driver.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "ssr.pio.h"
+#include <math.h>
+
+SsrDriver::SsrDriver(PIO pio, uint pin) : burstPattern{}, pio(pio), pin(pin) {}
+
+void SsrDriver::init(uint32_t windowMs, uint16_t resolution, uint32_t mainsHz) {
+    this->mainsHz = mainsHz;
+
+    offset = pio_add_program(pio, &ssr_program);
+    sm = pio_claim_unused_sm(pio, true);
+    ssr_program_init(pio, sm, offset, 1.0f, pin);
+
+    // Streams the burst pattern round and round; the ring wrap on the read address
+    // and an endless transfer count mean the CPU never has to restart it
+    dmaChannel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(dmaChannel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_ring(&config, false, __builtin_ctz(sizeof(burstPattern)));
+    channel_config_set_dreq(&config, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(dmaChannel, &config, &pio->txf[sm], burstPattern, dma_encode_endless_transfer_count(), false);
+
+    setWindow(windowMs, resolution);
+}
+
+bool SsrDriver::setWindow(uint32_t windowMs, uint16_t resolution) {
+    if (windowMs == 0 || resolution == 0) return false;
+
+    uint32_t previousWindowMs = this->windowMs;
+    uint16_t previousResolution = this->resolution;
+    this->windowMs = windowMs;
+    this->resolution = resolution;
+    if (sm < 0 || mode != Mode::TIME_PROPORTIONAL) return true;
+
+    if (!program(windowMs * 1000, resolution)) {
+        this->windowMs = previousWindowMs;
+        this->resolution = previousResolution;
+        return false;
+    }
+    applyPower();
+    return true;
+}
+
+void SsrDriver::setMode(Mode newMode) {
+    if (sm < 0 || newMode == mode) return;
+    mode = newMode;
+
+    if (mode == Mode::BURST) {
+        program(1000000 / mainsHz, BURST_STEPS_PER_SLOT);
+    } else {
+        program(windowMs * 1000, resolution);
+    }
+    applyPower();
+}
+
+void SsrDriver::setPower(float percent) {
+    float clamped = fminf(fmaxf(percent, 0.0f), 100.0f);
+    if (clamped == power) return;
+
+    bool turningOff = (clamped == 0.0f);
+    power = clamped;
+    if (turningOff) {
+        off();
+    } else {
+        applyPower();
+    }
+}
+
+void SsrDriver::off() {
+    power = 0.0f;
+    if (sm < 0) return;
+
+    dma_channel_abort(dmaChannel);
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_mov_not(pio_x, pio_null));
+    pio_sm_exec(pio, sm, pio_encode_set(pio_pins, 0));
+    pio_sm_exec(pio, sm, pio_encode_jmp(offset));
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+bool SsrDriver::program(uint32_t periodUs, uint32_t steps) {
+    // Each step is ssr_step_cycles PIO cycles; the per-window overhead of a few cycles is ignored
+    float clkDiv = static_cast<float>(clock_get_hz(clk_sys)) * (periodUs / 1e6f) /
+                   (static_cast<float>(steps) * ssr_step_cycles);
+    if (clkDiv < 1.0f || clkDiv >= 65536.0f) return false;
+
+    dma_channel_abort(dmaChannel);
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_set_clkdiv(pio, sm, clkDiv);
+
+    // Window length goes into ISR through the FIFO, the output starts off
+    pio_sm_put(pio, sm, steps - 1);
+    pio_sm_exec(pio, sm, pio_encode_pull(false, false));
+    pio_sm_exec(pio, sm, pio_encode_mov(pio_isr, pio_osr));
+    pio_sm_exec(pio, sm, pio_encode_mov_not(pio_x, pio_null));
+    pio_sm_exec(pio, sm, pio_encode_set(pio_pins, 0));
+    pio_sm_exec(pio, sm, pio_encode_jmp(offset));
+    pio_sm_clkdiv_restart(pio, sm);
+    pio_sm_set_enabled(pio, sm, true);
+
+    programmedSteps = steps;
+    return true;
+}
+
+void SsrDriver::applyPower() {
+    if (sm < 0) return;
+
+    if (mode == Mode::BURST) {
+        uint32_t onSlots = static_cast<uint32_t>(lroundf(power * BURST_SLOTS / 100.0f));
+        // Rewriting the pattern in place while DMA streams it can mix old and new
+        // slots for one pass, which is harmless at this timescale
+        fillBurstPattern(onSlots);
+        if (!dma_channel_is_busy(dmaChannel)) {
+            dma_channel_set_read_addr(dmaChannel, burstPattern, true);
+        }
+        return;
+    }
+
+    // Only the newest value matters; anything still queued is stale
+    uint32_t onSteps = static_cast<uint32_t>(lroundf(power * programmedSteps / 100.0f));
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_put(pio, sm, encodeOnSteps(onSteps));
+}
+
+void SsrDriver::fillBurstPattern(uint32_t onSlots) {
+    // Bresenham spread: slot i is on when the running share of on-cycles crosses an integer
+    uint32_t full = encodeOnSteps(BURST_STEPS_PER_SLOT);
+    for (uint32_t i = 0; i < BURST_SLOTS; ++i) {
+        bool on = ((i + 1) * onSlots) / BURST_SLOTS != (i * onSlots) / BURST_SLOTS;
+        burstPattern[i] = on ? full : OFF;
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Hardware-timed output stage for a zero-cross SSR, run by a PIO state machine
+// so the delivered power does not depend on task scheduling.
+// - TIME_PROPORTIONAL: the pin is high for power% of a fixed window, quantised
+//   to 'resolution' steps. New values take effect at the next window boundary.
+// - BURST: whole mains cycles are switched on or off, with the on-cycles spread
+//   evenly over a repeating pattern that DMA streams into the state machine.
+//   Each slot is one mains cycle, so the SSR's own zero-cross switching lines up
+//   with the pattern and the load sees complete cycles only.
+class SsrDriver {
+public:
+    enum class Mode : uint8_t {
+        TIME_PROPORTIONAL,
+        BURST
+    };
+
+    static constexpr size_t BURST_SLOTS = 128;  // Pattern length in mains cycles
+
+    SsrDriver(PIO pio, uint pin);
+
+    void init(uint32_t windowMs, uint16_t resolution, uint32_t mainsHz);
+
+    // Returns false if the window cannot be timed with the PIO clock divider
+    bool setWindow(uint32_t windowMs, uint16_t resolution);
+    uint32_t getWindowMs() const { return windowMs; }
+    uint16_t getResolution() const { return resolution; }
+
+    void setMode(Mode mode);
+    Mode getMode() const { return mode; }
+
+    void setPower(float percent);
+    float getPower() const { return power; }
+
+    // Drops the output immediately instead of at the end of the window
+    void off();
+
+private:
+    static constexpr uint32_t BURST_STEPS_PER_SLOT = 4;
+    static constexpr uint32_t OFF = 0xFFFFFFFFu;
+
+    bool program(uint32_t periodUs, uint32_t steps);
+    void applyPower();
+    void fillBurstPattern(uint32_t onSlots);
+    static uint32_t encodeOnSteps(uint32_t steps) { return steps - 1; }  // 0 wraps to OFF
+
+    // DMA ring wrap needs the buffer aligned to its size
+    alignas(BURST_SLOTS * sizeof(uint32_t)) uint32_t burstPattern[BURST_SLOTS];
+
+    PIO pio;
+    uint pin;
+    int sm = -1;
+    uint offset = 0;
+    int dmaChannel = -1;
+
+    Mode mode = Mode::TIME_PROPORTIONAL;
+    uint32_t windowMs = 0;
+    uint16_t resolution = 0;
+    uint32_t mainsHz = 50;
+    uint32_t programmedSteps = 0;
+    float power = 0.0f;
+};
@@ -0,0 +1,157 @@
+#include "library/st7789_pio.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "st7789.pio.h"
+
+// Column / row address set and memory write
+static const uint8_t CMD_CASET = 0x2A;
+static const uint8_t CMD_RASET = 0x2B;
+static const uint8_t CMD_RAMWR = 0x2C;
+
+St7789Pio::St7789Pio(PIO pio, uint sckPin, uint mosiPin, uint dcPin, uint csPin)
+    : pio(pio), sckPin(sckPin), mosiPin(mosiPin), dcPin(dcPin), csPin(csPin), windowBlock{} {}
+
+void St7789Pio::init(uint32_t sckHz) {
+    // Two cycles per bit. Whole divider, rounded up: a fractional one dithers the
+    // SCK period, and its short cycles would run faster than sckHz allows
+    uint32_t bitClockHz = 2 * sckHz;
+    uint32_t clkDiv = (clock_get_hz(clk_sys) + bitClockHz - 1) / bitClockHz;
+    if (clkDiv < 1) clkDiv = 1;
+
+    offset = pio_add_program(pio, &st7789_program);
+    sm = pio_claim_unused_sm(pio, true);
+    st7789_program_init(pio, sm, offset, clkDiv, sckPin, mosiPin, dcPin);
+
+    // Pixel payload, triggered by the command block when it completes
+    pixelChannel = dma_claim_unused_channel(true);
+    dma_channel_config pixelConfig = dma_channel_get_default_config(pixelChannel);
+    channel_config_set_transfer_data_size(&pixelConfig, DMA_SIZE_8);
+    channel_config_set_read_increment(&pixelConfig, true);
+    channel_config_set_write_increment(&pixelConfig, false);
+    channel_config_set_dreq(&pixelConfig, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(pixelChannel, &pixelConfig, &pio->txf[sm], nullptr, 0, false);
+
+    // Address window + RAMWR header
+    commandChannel = dma_claim_unused_channel(true);
+    dma_channel_config commandConfig = dma_channel_get_default_config(commandChannel);
+    channel_config_set_transfer_data_size(&commandConfig, DMA_SIZE_8);
+    channel_config_set_read_increment(&commandConfig, true);
+    channel_config_set_write_increment(&commandConfig, false);
+    channel_config_set_dreq(&commandConfig, pio_get_dreq(pio, sm, true));
+    channel_config_set_chain_to(&commandConfig, pixelChannel);
+    dma_channel_configure(commandChannel, &commandConfig, &pio->txf[sm], windowBlock, 0, false);
+
+    // Completion is signalled on DMA_IRQ_1 of the calling core
+    dma_channel_set_irq1_enabled(pixelChannel, true);
+}
+
+void St7789Pio::writeCommand(uint8_t cmd, const uint8_t* data, size_t len) {
+    waitIdle();
+
+    uint8_t header[HEADER_SIZE];
+    encodeHeader(header, cmd, len);
+    for (size_t i = 0; i < HEADER_SIZE; ++i) {
+        putByte(header[i]);
+    }
+    for (size_t i = 0; i < len; ++i) {
+        putByte(data[i]);
+    }
+    waitIdle();
+}
+
+void St7789Pio::startWrite(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, const uint8_t* pixels, size_t len) {
+    // No need to wait for the previous tail to leave the state machine - the FIFO keeps the order
+    while (busy) {
+        tight_loop_contents();
+    }
+    busy = true;
+
+    size_t blockSize = encodeWindow(windowBlock, x0, y0, x1, y1, len);
+    dma_channel_set_read_addr(pixelChannel, pixels, false);
+    dma_channel_set_trans_count(pixelChannel, len, false);
+    dma_channel_set_read_addr(commandChannel, windowBlock, false);
+    dma_channel_set_trans_count(commandChannel, blockSize, true);
+}
+
+void St7789Pio::fill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color) {
+    waitIdle();
+
+    size_t pixelCount = static_cast<size_t>(x1 - x0 + 1) * (y1 - y0 + 1);
+    uint8_t block[WINDOW_BLOCK_SIZE];
+    size_t blockSize = encodeWindow(block, x0, y0, x1, y1, pixelCount * 2);
+    for (size_t i = 0; i < blockSize; ++i) {
+        putByte(block[i]);
+    }
+    for (size_t i = 0; i < pixelCount; ++i) {
+        putByte(static_cast<uint8_t>(color >> 8));
+        putByte(static_cast<uint8_t>(color & 0xFF));
+    }
+    waitIdle();
+}
+
+bool St7789Pio::handleDmaIrq() {
+    if (pixelChannel < 0 || !dma_channel_get_irq1_status(pixelChannel)) return false;
+    dma_channel_acknowledge_irq1(pixelChannel);
+    // The state machine still shifts out the tail and releases CS on its own;
+    // the pixel buffer is no longer needed, which is what LVGL cares about
+    busy = false;
+    return true;
+}
+
+bool St7789Pio::isBusy() const {
+    return busy;
+}
+
+void St7789Pio::abort() {
+    dma_channel_abort(commandChannel);
+    dma_channel_abort(pixelChannel);
+    busy = false;
+
+    // Drop whatever is queued and restart the program with CS released
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_set(pio_pins, 0b11));
+    pio_sm_exec(pio, sm, pio_encode_jmp(offset));
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+void St7789Pio::waitIdle() const {
+    while (busy) {
+        tight_loop_contents();
+    }
+    // Idle means nothing queued and the program parked on its first pull with CS high
+    while (!pio_sm_is_tx_fifo_empty(pio, sm) || pio_sm_get_pc(pio, sm) != offset) {
+        tight_loop_contents();
+    }
+}
+
+size_t St7789Pio::encodeHeader(uint8_t* out, uint8_t cmd, size_t dataBytes) {
+    uint32_t bits = static_cast<uint32_t>(dataBytes) * 8;
+    out[0] = cmd;
+    out[1] = static_cast<uint8_t>(bits >> 16);
+    out[2] = static_cast<uint8_t>(bits >> 8);
+    out[3] = static_cast<uint8_t>(bits);
+    return HEADER_SIZE;
+}
+
+void St7789Pio::putByte(uint8_t value) {
+    // The program reads the top byte of each FIFO word
+    pio_sm_put_blocking(pio, sm, static_cast<uint32_t>(value) << 24);
+}
+
+size_t St7789Pio::encodeWindow(uint8_t* out, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, size_t pixelBytes) {
+    size_t n = 0;
+    n += encodeHeader(out + n, CMD_CASET, 4);
+    out[n++] = static_cast<uint8_t>(x0 >> 8);
+    out[n++] = static_cast<uint8_t>(x0 & 0xFF);
+    out[n++] = static_cast<uint8_t>(x1 >> 8);
+    out[n++] = static_cast<uint8_t>(x1 & 0xFF);
+    n += encodeHeader(out + n, CMD_RASET, 4);
+    out[n++] = static_cast<uint8_t>(y0 >> 8);
+    out[n++] = static_cast<uint8_t>(y0 & 0xFF);
+    out[n++] = static_cast<uint8_t>(y1 >> 8);
+    out[n++] = static_cast<uint8_t>(y1 & 0xFF);
+    n += encodeHeader(out + n, CMD_RAMWR, pixelBytes);
+    return n;
+}
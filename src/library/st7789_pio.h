@@ -0,0 +1,54 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// ST7789 write-only driver on a PIO state machine. The program sequences DC and
+// CS itself, so a whole transaction (command, parameters, pixel payload) is a
+// single byte stream. A flush is one DMA chain: a small command block with the
+// CASET / RASET / RAMWR headers, chained into the pixel transfer.
+// The CS pin must be the GPIO right after the DC pin.
+class St7789Pio {
+public:
+    St7789Pio(PIO pio, uint sckPin, uint mosiPin, uint dcPin, uint csPin);
+
+    // 'sckHz' is an upper bound; SCK runs at the nearest whole division of clk_sys at or below it
+    void init(uint32_t sckHz);
+
+    // Blocking command with optional parameters; returns once the bytes are on the wire
+    void writeCommand(uint8_t cmd, const uint8_t* data = nullptr, size_t len = 0);
+
+    // Starts an asynchronous RAMWR of 'len' bytes into the window; completion is
+    // signalled on DMA_IRQ_1 and reported by handleDmaIrq()
+    void startWrite(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, const uint8_t* pixels, size_t len);
+
+    // Blocking fill of the window with a single RGB565 colour
+    void fill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
+
+    // True if the IRQ was for this driver's transfer (and it has been acknowledged)
+    bool handleDmaIrq();
+    bool isBusy() const;
+    void abort();
+    void waitIdle() const;
+
+private:
+    static constexpr size_t HEADER_SIZE = 4;
+    static constexpr size_t WINDOW_BLOCK_SIZE = 3 * HEADER_SIZE + 8;  // CASET + 4, RASET + 4, RAMWR
+
+    static size_t encodeHeader(uint8_t* out, uint8_t cmd, size_t dataBytes);
+    void putByte(uint8_t value);
+    size_t encodeWindow(uint8_t* out, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, size_t pixelBytes);
+
+    PIO pio;
+    uint sckPin;
+    uint mosiPin;
+    uint dcPin;
+    uint csPin;
+    int sm = -1;
+    uint offset = 0;
+    int commandChannel = -1;
+    int pixelChannel = -1;
+    volatile bool busy = false;
+
+    uint8_t windowBlock[WINDOW_BLOCK_SIZE];
+};
@@ -0,0 +1,173 @@
+#include "library/temp_history.h"
+#include "constants.h"
+
+TempHistory::TempHistory() : samples{}, nextSeq(0) {
+    resetWindow(windows[static_cast<size_t>(TempWindow::DERIVATIVE)], TEMP_WINDOW_DERIVATIVE_MS);
+    resetWindow(windows[static_cast<size_t>(TempWindow::RATE)], TEMP_WINDOW_RATE_MS);
+    resetWindow(windows[static_cast<size_t>(TempWindow::TREND)], TEMP_WINDOW_TREND_MS);
+}
+
+void TempHistory::push(const TempReading& reading) {
+    uint32_t seq = nextSeq;
+
+    for (Window& window : windows) {
+        // Drop samples that have aged out, and the one the ring is about to overwrite
+        while (window.count > 0) {
+            const TempReading& oldest = sample(window.startSeq);
+            bool expired = static_cast<int32_t>(reading.timestamp - oldest.timestamp) > static_cast<int32_t>(window.windowMs);
+            bool overwritten = seq - window.startSeq >= CAPACITY;
+            if (!expired && !overwritten) break;
+            removeOldest(window);
+        }
+    }
+
+    samples[seq % CAPACITY] = reading;
+    nextSeq = seq + 1;
+
+    for (Window& window : windows) {
+        addToWindow(window, seq);
+    }
+}
+
+void TempHistory::clear() {
+    nextSeq = 0;
+    for (Window& window : windows) {
+        resetWindow(window, window.windowMs);
+    }
+}
+
+void TempHistory::setWindow(TempWindow which, uint32_t windowMs) {
+    Window& window = windows[static_cast<size_t>(which)];
+    resetWindow(window, windowMs);
+    if (isEmpty()) return;
+
+    // Walk back from the newest sample to find where the new window starts
+    uint32_t newest = nextSeq - 1;
+    uint32_t first = newest;
+    uint32_t oldestHeld = nextSeq - size();
+    while (first > oldestHeld &&
+           static_cast<int32_t>(sample(newest).timestamp - sample(first - 1).timestamp) <= static_cast<int32_t>(windowMs)) {
+        first--;
+    }
+
+    for (uint32_t seq = first; seq <= newest; ++seq) {
+        addToWindow(window, seq);
+    }
+}
+
+uint32_t TempHistory::getWindow(TempWindow which) const {
+    return windows[static_cast<size_t>(which)].windowMs;
+}
+
+bool TempHistory::getStats(TempWindow which, TempWindowStats& out) const {
+    const Window& window = windows[static_cast<size_t>(which)];
+    out = {};
+    if (window.count == 0) return false;
+
+    double n = static_cast<double>(window.count);
+    out.count = window.count;
+    out.spanMs = sample(nextSeq - 1).timestamp - sample(window.startSeq).timestamp;
+    out.mean = static_cast<float>(window.sumX / n);
+    out.min = samples[window.minQueue.front()].currentTemp;
+    out.max = samples[window.maxQueue.front()].currentTemp;
+
+    if (window.count > 1) {
+        double variance = (window.sumXX - window.sumX * window.sumX / n) / (n - 1.0);
+        out.variance = static_cast<float>(variance > 0.0 ? variance : 0.0);
+
+        double denominator = n * window.sumTT - window.sumT * window.sumT;
+        if (denominator > 1e-9) {
+            out.slope = static_cast<float>((n * window.sumTX - window.sumT * window.sumX) / denominator);
+        }
+    }
+    return true;
+}
+
+size_t TempHistory::size() const {
+    return nextSeq < CAPACITY ? nextSeq : CAPACITY;
+}
+
+const TempReading& TempHistory::at(size_t index) const {
+    return sample(nextSeq - size() + static_cast<uint32_t>(index));
+}
+
+const TempReading& TempHistory::latest() const {
+    return sample(nextSeq - 1);
+}
+
+size_t TempHistory::copyRecent(TempReading* out, size_t maxCount) const {
+    size_t count = size() < maxCount ? size() : maxCount;
+    uint32_t first = nextSeq - static_cast<uint32_t>(count);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = sample(first + static_cast<uint32_t>(i));
+    }
+    return count;
+}
+
+void TempHistory::resetWindow(Window& window, uint32_t windowMs) {
+    window.windowMs = windowMs;
+    window.startSeq = nextSeq;
+    window.count = 0;
+    window.originMs = 0;
+    window.sumX = window.sumXX = window.sumT = window.sumTT = window.sumTX = 0.0;
+    window.minQueue.clear();
+    window.maxQueue.clear();
+}
+
+void TempHistory::addToWindow(Window& window, uint32_t seq) {
+    const TempReading& reading = sample(seq);
+    if (window.count == 0) {
+        window.startSeq = seq;
+        window.originMs = reading.timestamp;
+    }
+    rebase(window, reading.timestamp);
+
+    // Newest sample sits at t = 0, so it adds nothing to the t sums
+    double x = reading.currentTemp;
+    window.count++;
+    window.sumX += x;
+    window.sumXX += x * x;
+
+    uint16_t index = static_cast<uint16_t>(seq % CAPACITY);
+    while (!window.minQueue.isEmpty() && samples[window.minQueue.back()].currentTemp >= reading.currentTemp) {
+        window.minQueue.popBack();
+    }
+    window.minQueue.pushBack(index);
+    while (!window.maxQueue.isEmpty() && samples[window.maxQueue.back()].currentTemp <= reading.currentTemp) {
+        window.maxQueue.popBack();
+    }
+    window.maxQueue.pushBack(index);
+}
+
+void TempHistory::removeOldest(Window& window) {
+    const TempReading& reading = sample(window.startSeq);
+    double t = static_cast<int32_t>(reading.timestamp - window.originMs) / 1000.0;
+    double x = reading.currentTemp;
+
+    window.count--;
+    window.sumX -= x;
+    window.sumXX -= x * x;
+    window.sumT -= t;
+    window.sumTT -= t * t;
+    window.sumTX -= t * x;
+
+    uint16_t index = static_cast<uint16_t>(window.startSeq % CAPACITY);
+    if (!window.minQueue.isEmpty() && window.minQueue.front() == index) window.minQueue.popFront();
+    if (!window.maxQueue.isEmpty() && window.maxQueue.front() == index) window.maxQueue.popFront();
+
+    window.startSeq++;
+    if (window.count == 0) {
+        window.sumX = window.sumXX = window.sumT = window.sumTT = window.sumTX = 0.0;
+    }
+}
+
+void TempHistory::rebase(Window& window, uint32_t originMs) {
+    // Shift the time origin in O(1) so t stays small and the sums keep their precision:
+    // sum(t - c) = sumT - n*c, sum((t - c)^2) = sumTT - 2c*sumT + n*c^2, sum((t - c)x) = sumTX - c*sumX
+    double c = static_cast<int32_t>(originMs - window.originMs) / 1000.0;
+    double n = static_cast<double>(window.count);
+    window.sumTT = window.sumTT - 2.0 * c * window.sumT + n * c * c;
+    window.sumTX = window.sumTX - c * window.sumX;
+    window.sumT = window.sumT - n * c;
+    window.originMs = originMs;
+}
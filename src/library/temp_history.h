@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "types/temp_reading.h"
+
+// Fixed-capacity history of timestamped readings with incrementally maintained
+// statistics over several sliding time windows. Pushing a sample updates every
+// window in amortised O(1); querying a window is O(1). Not thread-safe - the
+// owner serialises push() against readers.
+class TempHistory {
+public:
+    static constexpr size_t CAPACITY = 1024;
+    static constexpr size_t MAX_WINDOWS = static_cast<size_t>(TempWindow::COUNT);
+
+    TempHistory();
+
+    void push(const TempReading& reading);
+    void clear();
+
+    // Resizing a window rebuilds it from the samples still held in the ring
+    void setWindow(TempWindow window, uint32_t windowMs);
+    uint32_t getWindow(TempWindow window) const;
+    bool getStats(TempWindow window, TempWindowStats& out) const;
+
+    size_t size() const;
+    bool isEmpty() const { return size() == 0; }
+    const TempReading& at(size_t index) const;  // 0 = oldest
+    const TempReading& latest() const;
+
+    // Copies up to maxCount of the newest samples, oldest first
+    size_t copyRecent(TempReading* out, size_t maxCount) const;
+
+private:
+    // Ring of sample indices used as a monotonic queue for sliding min/max
+    struct IndexQueue {
+        uint16_t items[CAPACITY];
+        uint16_t head;
+        uint16_t count;
+
+        void clear() { head = 0; count = 0; }
+        bool isEmpty() const { return count == 0; }
+        uint16_t front() const { return items[head]; }
+        uint16_t back() const { return items[(head + count - 1) % CAPACITY]; }
+        void popFront() { head = (head + 1) % CAPACITY; count--; }
+        void popBack() { count--; }
+        void pushBack(uint16_t index) { items[(head + count) % CAPACITY] = index; count++; }
+    };
+
+    struct Window {
+        uint32_t windowMs;
+        uint32_t startSeq;   // Sequence number of the oldest sample in the window
+        uint32_t count;
+        uint32_t originMs;   // Time origin for the t sums, rebased on every push
+        double sumX;
+        double sumXX;
+        double sumT;
+        double sumTT;
+        double sumTX;
+        IndexQueue minQueue;
+        IndexQueue maxQueue;
+    };
+
+    void resetWindow(Window& window, uint32_t windowMs);
+    void addToWindow(Window& window, uint32_t seq);
+    void removeOldest(Window& window);
+    void rebase(Window& window, uint32_t originMs);
+    const TempReading& sample(uint32_t seq) const { return samples[seq % CAPACITY]; }
+
+    TempReading samples[CAPACITY];
+    uint32_t nextSeq;    // Sequence number the next push will get
+    Window windows[MAX_WINDOWS];
+};
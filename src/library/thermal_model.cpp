@@ -0,0 +1,106 @@
+#include "library/thermal_model.h"
+#include <math.h>
+
+ThermalModel::ThermalModel() : summary{}, valid(false) {}
+
+void ThermalModel::setSummary(const ThermalCalibrationSummary& newSummary) {
+    summary = newSummary;
+
+    // An uncalibrated table is all zeros; without a usable full-power rate there is nothing to plan with
+    valid = false;
+    for (size_t t = 0; t < ThermalCalibrationSummary::NUM_TEMP_POINTS; ++t) {
+        if (summary.heatingRates[t][ThermalCalibrationSummary::NUM_POWER_LEVELS - 1] > 0.0f) {
+            valid = true;
+        }
+    }
+}
+
+float ThermalModel::heatingRate(float temp, float powerPercent) const {
+    Curve curve;
+    buildCurve(summary.heatingRates, temp, curve);
+    return evaluate(curve, powerPercent);
+}
+
+float ThermalModel::coolingRate(float temp, float doorPercent) const {
+    Curve curve;
+    buildCurve(summary.coolingRates, temp, curve);
+    return evaluate(curve, doorPercent);
+}
+
+float ThermalModel::powerForRate(float temp, float rate) const {
+    Curve curve;
+    buildCurve(summary.heatingRates, temp, curve);
+    return invert(curve, rate);
+}
+
+float ThermalModel::doorForCoolingRate(float temp, float rate) const {
+    Curve curve;
+    buildCurve(summary.coolingRates, temp, curve);
+    return invert(curve, rate);
+}
+
+ThermalModel::Plan ThermalModel::plan(float setpoint, float rampRate, float horizonSeconds) const {
+    Plan result = {0.0f, 0.0f, 0.0f};
+    if (!valid) return result;
+
+    float temp = setpoint + rampRate * horizonSeconds * 0.5f;
+
+    // With the heater off and the door shut the oven drifts at the 0 % heating rate.
+    // Anything above that needs heat, anything below needs the door.
+    float passiveRate = heatingRate(temp, 0.0f);
+    if (rampRate >= passiveRate) {
+        result.heaterPower = powerForRate(temp, rampRate);
+        result.expectedRate = heatingRate(temp, result.heaterPower);
+    } else {
+        result.doorPercent = doorForCoolingRate(temp, -rampRate);
+        result.expectedRate = -coolingRate(temp, result.doorPercent);
+    }
+    return result;
+}
+
+void ThermalModel::buildCurve(const float (&table)[ThermalCalibrationSummary::NUM_TEMP_POINTS]
+                                                  [ThermalCalibrationSummary::NUM_POWER_LEVELS],
+                              float temp, Curve& out) {
+    const float* points = ThermalCalibrationSummary::TEMP_POINTS;
+    const size_t last = ThermalCalibrationSummary::NUM_TEMP_POINTS - 1;
+
+    // Linear in temperature between calibration points, held flat outside them
+    size_t lower = 0;
+    float fraction = 0.0f;
+    if (temp >= points[last]) {
+        lower = last;
+    } else if (temp > points[0]) {
+        while (lower < last - 1 && temp > points[lower + 1]) lower++;
+        fraction = (temp - points[lower]) / (points[lower + 1] - points[lower]);
+    }
+    size_t upper = (lower < last) ? lower + 1 : last;
+
+    for (size_t i = 0; i < ThermalCalibrationSummary::NUM_POWER_LEVELS; ++i) {
+        out[i + 1] = table[lower][i] + (table[upper][i] - table[lower][i]) * fraction;
+    }
+    out[0] = 2.0f * out[1] - out[2];
+
+    // Measured rates are noisy; keep the curve non-decreasing so the inverse is unique
+    for (size_t i = 1; i < CURVE_POINTS; ++i) {
+        if (out[i] < out[i - 1]) out[i] = out[i - 1];
+    }
+}
+
+float ThermalModel::evaluate(const Curve& curve, float percent) {
+    float position = fminf(fmaxf(percent, 0.0f), 100.0f) / 10.0f;
+    size_t index = static_cast<size_t>(position);
+    if (index >= CURVE_POINTS - 1) return curve[CURVE_POINTS - 1];
+    float fraction = position - static_cast<float>(index);
+    return curve[index] + (curve[index + 1] - curve[index]) * fraction;
+}
+
+float ThermalModel::invert(const Curve& curve, float rate) {
+    if (rate <= curve[0]) return 0.0f;
+    if (rate >= curve[CURVE_POINTS - 1]) return 100.0f;
+
+    size_t index = 0;
+    while (index < CURVE_POINTS - 2 && rate > curve[index + 1]) index++;
+    float span = curve[index + 1] - curve[index];
+    float fraction = (span > 0.0f) ? (rate - curve[index]) / span : 0.0f;
+    return (static_cast<float>(index) + fraction) * 10.0f;
+}
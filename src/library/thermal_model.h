@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stddef.h>
+#include "types/calibration_data.h"
+
+// Oven model built from the calibration tables: heating rate as a function of
+// temperature and heater power, cooling rate as a function of temperature and
+// door opening. Used to pick the actuator settings that produce a requested
+// ramp rate before any error has built up. Rates are in °C/s, cooling rates
+// are positive when the oven is losing heat. No Pico SDK or FreeRTOS
+// dependencies, so it builds and runs on the host.
+class ThermalModel {
+public:
+    struct Plan {
+        float heaterPower;   // 0-100 %
+        float doorPercent;   // 0-100 %
+        float expectedRate;  // °C/s the model predicts for these settings
+    };
+
+    ThermalModel();
+
+    void setSummary(const ThermalCalibrationSummary& summary);
+    bool isValid() const { return valid; }
+
+    float heatingRate(float temp, float powerPercent) const;
+    float coolingRate(float temp, float doorPercent) const;
+
+    // Inverse lookups, clamped to 0-100 %
+    float powerForRate(float temp, float rate) const;
+    float doorForCoolingRate(float temp, float rate) const;
+
+    // Actuator settings that follow a ramp of 'rampRate' °C/s from 'setpoint',
+    // evaluated at the temperature the oven will pass through halfway along the horizon
+    Plan plan(float setpoint, float rampRate, float horizonSeconds) const;
+
+private:
+    // Rates at 0 %, 10 %, ... 100 %; the 0 % point is extrapolated from the first two levels
+    static constexpr size_t CURVE_POINTS = ThermalCalibrationSummary::NUM_POWER_LEVELS + 1;
+    typedef float Curve[CURVE_POINTS];
+
+    static void buildCurve(const float (&table)[ThermalCalibrationSummary::NUM_TEMP_POINTS]
+                                             [ThermalCalibrationSummary::NUM_POWER_LEVELS],
+                           float temp, Curve& out);
+    static float evaluate(const Curve& curve, float percent);
+    static float invert(const Curve& curve, float rate);
+
+    ThermalCalibrationSummary summary;
+    bool valid;
+};
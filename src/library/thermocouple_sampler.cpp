@@ -0,0 +1,130 @@
+#include "library/thermocouple_sampler.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+
+ThermocoupleSampler::ThermocoupleSampler(spi_inst_t* spiPort, uint csPin) : spiPort(spiPort), csPin(csPin) {}
+
+void ThermocoupleSampler::init(uint32_t sampleRateHz) {
+    txChannel = dma_claim_unused_channel(true);
+    rxChannel = dma_claim_unused_channel(true);
+
+    // TX: clock out dummy zero bytes, the MAX31855 ignores MOSI
+    dma_channel_config txConfig = dma_channel_get_default_config(txChannel);
+    channel_config_set_transfer_data_size(&txConfig, DMA_SIZE_8);
+    channel_config_set_read_increment(&txConfig, false);
+    channel_config_set_write_increment(&txConfig, false);
+    channel_config_set_dreq(&txConfig, spi_get_dreq(spiPort, true));
+    dma_channel_configure(txChannel, &txConfig, &spi_get_hw(spiPort)->dr, &txDummy, sizeof(rxBuffer), false);
+
+    // RX: collect the 4-byte frame
+    dma_channel_config rxConfig = dma_channel_get_default_config(rxChannel);
+    channel_config_set_transfer_data_size(&rxConfig, DMA_SIZE_8);
+    channel_config_set_read_increment(&rxConfig, false);
+    channel_config_set_write_increment(&rxConfig, true);
+    channel_config_set_dreq(&rxConfig, spi_get_dreq(spiPort, false));
+    dma_channel_configure(rxChannel, &rxConfig, rxBuffer, &spi_get_hw(spiPort)->dr, sizeof(rxBuffer), false);
+
+    // Completion is signalled on DMA_IRQ_0 of the calling core
+    dma_channel_set_irq0_enabled(rxChannel, true);
+
+    // Own alarm pool so the timer IRQ lands on this core, not the default pool's core
+    alarmPool = alarm_pool_create_with_unused_hardware_alarm(4);
+    setSampleRate(sampleRateHz);
+}
+
+void ThermocoupleSampler::setSampleRate(uint32_t rateHz) {
+    if (rateHz == 0 || !alarmPool) return;
+
+    if (sampleRateHz != 0) {
+        cancel_repeating_timer(&timer);
+    }
+    sampleRateHz = rateHz;
+
+    // Negative delay: period is measured start-to-start, so the rate does not drift
+    int64_t periodUs = 1000000 / static_cast<int64_t>(rateHz);
+    alarm_pool_add_repeating_timer_us(alarmPool, -periodUs, timerCallback, this, &timer);
+}
+
+uint32_t ThermocoupleSampler::getSampleRate() const {
+    return sampleRateHz;
+}
+
+void ThermocoupleSampler::setNotifyTask(TaskHandle_t task) {
+    notifyTask = task;
+}
+
+bool ThermocoupleSampler::read(ThermocoupleFrame& frame) {
+    return frames.pop(frame);
+}
+
+bool ThermocoupleSampler::readLatest(ThermocoupleFrame& frame) {
+    return frames.popLatest(frame);
+}
+
+bool ThermocoupleSampler::timerCallback(repeating_timer_t* rt) {
+    static_cast<ThermocoupleSampler*>(rt->user_data)->startTransfer();
+    return true;
+}
+
+void ThermocoupleSampler::startTransfer() {
+    if (transferBusy) {
+        // Previous frame has not completed yet, skip this slot
+        overrunCount = overrunCount + 1;
+        return;
+    }
+    transferBusy = true;
+    transferStartUs = time_us_32();
+
+    gpio_put(csPin, 0);
+    dma_channel_set_write_addr(rxChannel, rxBuffer, false);
+    dma_channel_set_read_addr(txChannel, &txDummy, false);
+    dma_channel_set_trans_count(rxChannel, sizeof(rxBuffer), false);
+    dma_channel_set_trans_count(txChannel, sizeof(rxBuffer), false);
+    dma_start_channel_mask((1u << txChannel) | (1u << rxChannel));
+}
+
+void ThermocoupleSampler::handleDmaIrq() {
+    if (rxChannel < 0 || !dma_channel_get_irq0_status(rxChannel)) return;
+    dma_channel_acknowledge_irq0(rxChannel);
+
+    gpio_put(csPin, 1);
+
+    ThermocoupleFrame frame;
+    frame.raw = (static_cast<uint32_t>(rxBuffer[0]) << 24) | (static_cast<uint32_t>(rxBuffer[1]) << 16) |
+                (static_cast<uint32_t>(rxBuffer[2]) << 8) | rxBuffer[3];
+    frame.timestampUs = transferStartUs;
+    frames.push(frame);
+    transferBusy = false;
+
+    if (notifyTask) {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(notifyTask, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+}
+
+uint32_t ThermocoupleSampler::getOverrunCount() const {
+    return overrunCount;
+}
+
+uint32_t ThermocoupleSampler::getDroppedCount() const {
+    return frames.getDroppedCount();
+}
+
+bool ThermocoupleSampler::hasFault(uint32_t raw) {
+    // D16 is the summary fault bit, D2..D0 are SCV / SCG / OC
+    return (raw & 0x00010007) != 0;
+}
+
+SensorError ThermocoupleSampler::decodeFault(uint32_t raw) {
+    if (raw & 0x01) return SensorError::THERMOCOUPLE_OPEN;
+    if (raw & 0x02) return SensorError::THERMOCOUPLE_SHORT_GND;
+    if (raw & 0x04) return SensorError::THERMOCOUPLE_SHORT_VCC;
+    if (raw & 0x00010000) return SensorError::THERMOCOUPLE_FAULT;
+    return SensorError::NONE;
+}
+
+float ThermocoupleSampler::toCelsius(uint32_t raw) {
+    // D31..D18: signed 14-bit thermocouple temperature in 0.25°C steps
+    return static_cast<float>(static_cast<int32_t>(raw) >> 18) * 0.25f;
+}
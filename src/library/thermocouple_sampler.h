@@ -0,0 +1,65 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "pico/time.h"
+#include "hardware/spi.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "types/sensors.h"
+#include "library/ring_buffer.h"
+
+// Timer-paced, DMA-driven acquisition of MAX31855 4-byte frames.
+// A dedicated hardware alarm kicks off each transfer, the DMA completion IRQ
+// releases chip select and pushes the frame into a lock-free ring buffer, so no
+// task ever blocks on the SPI bus.
+class ThermocoupleSampler {
+public:
+    ThermocoupleSampler(spi_inst_t* spiPort, uint csPin);
+
+    // Must be called from the core that should service the timer and DMA IRQs.
+    void init(uint32_t sampleRateHz);
+    void setSampleRate(uint32_t sampleRateHz);
+    uint32_t getSampleRate() const;
+
+    // Task to notify (vTaskNotifyGiveFromISR) whenever a frame completes
+    void setNotifyTask(TaskHandle_t task);
+
+    // Consumer side - single consumer only
+    bool read(ThermocoupleFrame& frame);
+    bool readLatest(ThermocoupleFrame& frame);
+
+    // Called from the shared DMA IRQ dispatcher
+    void handleDmaIrq();
+
+    uint32_t getOverrunCount() const;
+    uint32_t getDroppedCount() const;
+
+    // MAX31855 frame decoding
+    static bool hasFault(uint32_t raw);
+    static SensorError decodeFault(uint32_t raw);
+    static float toCelsius(uint32_t raw);
+
+private:
+    static bool timerCallback(repeating_timer_t* rt);
+    void startTransfer();
+
+    static constexpr size_t FRAME_BUFFER_SIZE = 16;
+
+    spi_inst_t* spiPort;
+    uint csPin;
+    int txChannel = -1;
+    int rxChannel = -1;
+    uint32_t sampleRateHz = 0;
+
+    alarm_pool_t* alarmPool = nullptr;
+    repeating_timer_t timer = {};
+    TaskHandle_t notifyTask = nullptr;
+
+    uint8_t txDummy = 0;
+    uint8_t rxBuffer[4] = {};
+    uint32_t transferStartUs = 0;
+    volatile bool transferBusy = false;
+    volatile uint32_t overrunCount = 0;
+
+    RingBuffer<ThermocoupleFrame, FRAME_BUFFER_SIZE> frames;
+};
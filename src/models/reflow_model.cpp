@@ -1,12 +1,27 @@
 #include "reflow_model.h"
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<ReflowCurve>::value, "curves are copied and placed in flash as plain data");
+
+static const char* const STEP_LABEL_NAMES[] = {"", "Preheat", "Soak", "Ramp Up", "Reflow", "Cooldown"};
+static_assert(sizeof(STEP_LABEL_NAMES) / sizeof(STEP_LABEL_NAMES[0]) == static_cast<size_t>(StepLabel::COOLDOWN) + 1,
+              "one name per StepLabel");
+
+// Stands in until a curve is selected
+static constexpr ReflowCurve NO_CURVE = {};
+
+const char* getStepLabelName(StepLabel label) {
+    size_t index = static_cast<size_t>(label);
+    return index < sizeof(STEP_LABEL_NAMES) / sizeof(STEP_LABEL_NAMES[0]) ? STEP_LABEL_NAMES[index] : "";
+}
 
 void ReflowModel::setActiveCurve(const ReflowCurve& curve) {
-    activeCurve = curve;
+    activeCurve = &curve;
     currentStepIndex = 0;
 }
 
 const ReflowCurve& ReflowModel::getActiveCurve() const {
-    return activeCurve;
+    return activeCurve ? *activeCurve : NO_CURVE;
 }
 
 void ReflowModel::resetProgress() {
@@ -14,7 +29,7 @@ void ReflowModel::resetProgress() {
 }
 
 void ReflowModel::advanceStep() {
-    if (currentStepIndex < (int)activeCurve.steps.size() - 1)
+    if (currentStepIndex < (int)getActiveCurve().stepCount - 1)
         currentStepIndex++;
 }
 
@@ -23,9 +38,11 @@ int ReflowModel::getCurrentStepIndex() const {
 }
 
 const ReflowStep& ReflowModel::getCurrentStep() const {
-    return activeCurve.steps.at(currentStepIndex);
+    // NO_CURVE's first step is a zeroed NONE step
+    const ReflowCurve& curve = getActiveCurve();
+    return currentStepIndex < curve.stepCount ? curve.steps[currentStepIndex] : NO_CURVE.steps[0];
 }
 
 bool ReflowModel::isComplete() const {
-    return currentStepIndex >= static_cast<int>(activeCurve.steps.size());
+    return currentStepIndex >= static_cast<int>(getActiveCurve().stepCount);
 }
@@ -1,24 +1,67 @@
 #pragma once
 
-#include <vector>
-#include <string>
+#include <stddef.h>
 #include <stdint.h>
+#include "library/array_view.h"
+
+// Step names are ids into a fixed table rather than strings
+enum class StepLabel : uint8_t {
+    NONE,                      // Uploaded profiles carry no step names
+    PREHEAT,
+    SOAK,
+    RAMP_UP,
+    REFLOW,
+    COOLDOWN
+};
+
+const char* getStepLabelName(StepLabel label);
 
 struct ReflowStep {
-    std::string label;         // e.g., "Preheat", "Soak"
+    StepLabel label;
     float targetTempC;
     uint32_t durationMs;
 };
 
+// Fixed-capacity and trivially copyable: no heap behind it, so the built-in
+// curves are constant data in flash (see makeReflowCurve) and copying one is
+// a memcpy.
 struct ReflowCurve {
-    std::string name;
+    static constexpr size_t NAME_SIZE = 32;
+    static constexpr size_t MAX_STEPS = 16;
+    static constexpr float DEFAULT_LIQUIDUS_C = 217.0f;    // SAC305
+
+    char name[NAME_SIZE];                // NUL-terminated
     float minimumStartTempC;             // Minimum oven temp to begin reflow
-    std::vector<ReflowStep> steps;
+    float liquidusTempC;                 // Solder liquidus, for time-above-liquidus checks
+    uint8_t stepCount;
+    ReflowStep steps[MAX_STEPS];
+
+    constexpr ArrayView<ReflowStep> getSteps() const { return ArrayView<ReflowStep>(steps, stepCount); }
 };
 
+// Builds a curve in a constant expression; a name or step list that does not fit fails to compile
+template <size_t NameSize, size_t StepCount>
+constexpr ReflowCurve makeReflowCurve(const char (&name)[NameSize], float minimumStartTempC,
+                                      const ReflowStep (&steps)[StepCount],
+                                      float liquidusTempC = ReflowCurve::DEFAULT_LIQUIDUS_C) {
+    static_assert(NameSize <= ReflowCurve::NAME_SIZE, "curve name too long");
+    static_assert(StepCount > 0 && StepCount <= ReflowCurve::MAX_STEPS, "a curve has 1..MAX_STEPS steps");
+
+    ReflowCurve curve = {};
+    for (size_t i = 0; i < NameSize; ++i) curve.name[i] = name[i];
+    curve.minimumStartTempC = minimumStartTempC;
+    curve.liquidusTempC = liquidusTempC;
+    curve.stepCount = static_cast<uint8_t>(StepCount);
+    for (size_t i = 0; i < StepCount; ++i) curve.steps[i] = steps[i];
+    return curve;
+}
+
 class ReflowModel {
 public:
+    // Keeps a reference, not a copy: the curve must outlive the selection,
+    // so a temporary is refused at compile time
     void setActiveCurve(const ReflowCurve& curve);
+    void setActiveCurve(const ReflowCurve&&) = delete;
     const ReflowCurve& getActiveCurve() const;
 
     void resetProgress();
@@ -28,6 +71,6 @@ public:
     bool isComplete() const;
 
 private:
-    ReflowCurve activeCurve;
+    const ReflowCurve* activeCurve = nullptr;
     int currentStepIndex = 0;
 };
@@ -3,9 +3,11 @@
 #include "services/calibration_service.h"
 #include "services/temperature_control_service.h"
 #include "services/sensor_service.h"
+#include "services/settings_service.h"
+#include "services/flash_service.h"
 #include "hardware/flash.h"
-#include "hardware/sync.h"
 #include "pico/time.h"
+#include "hardware/regs/addressmap.h"
 #include "constants.h"
 #include <string.h>
 #include <math.h>
@@ -332,20 +334,35 @@ bool CalibrationService::runDoorCalibration() {
 }
 
 bool CalibrationService::saveCalibrationData() {
-    uint32_t ints = save_and_disable_interrupts();
-    flash_range_erase(CALIBRATION_FLASH_OFFSET, FLASH_SECTOR_SIZE);
-    flash_range_program(CALIBRATION_FLASH_OFFSET, reinterpret_cast<const uint8_t*>(&data), sizeof(CalibrationData));
-    restore_interrupts(ints);
-    return true;
+    return SettingsService::getInstance().save(SettingsKey::CALIBRATION, &data, sizeof(data));
 }
 
 bool CalibrationService::loadCalibrationData() {
-    const CalibrationData* fromFlash = reinterpret_cast<const CalibrationData*>(XIP_BASE + CALIBRATION_FLASH_OFFSET);
-    if (fromFlash->isCalibrated) {
-        data = *fromFlash;
-        return true;
+    if (SettingsService::getInstance().load(SettingsKey::CALIBRATION, &data, sizeof(data))) {
+        return data.isCalibrated;
+    }
+
+    // Older firmware kept a raw CalibrationData at the start of the settings
+    // region. The store opens its first sector at the other end of the region,
+    // so the blob stays intact until its copy has been written and read back;
+    // only then is it erased, so it can never be imported a second time.
+    const uint8_t* region = reinterpret_cast<const uint8_t*>(XIP_BASE + SETTINGS_FLASH_OFFSET);
+    uint32_t magic;
+    memcpy(&magic, region, sizeof(magic));
+    if (magic == SETTINGS_MAGIC || region[offsetof(CalibrationData, isCalibrated)] != 1) return false;
+
+    static_assert(sizeof(CalibrationData) <= FLASH_SECTOR_SIZE, "legacy calibration blob fits sector 0");
+    CalibrationData legacy;
+    memcpy(&legacy, region, sizeof(legacy));
+    data = legacy;
+
+    CalibrationData stored;
+    if (saveCalibrationData() &&
+        SettingsService::getInstance().load(SettingsKey::CALIBRATION, &stored, sizeof(stored)) &&
+        memcmp(&stored, &legacy, sizeof(stored)) == 0) {
+        FlashService::getInstance().erase(SETTINGS_FLASH_OFFSET, FLASH_SECTOR_SIZE);
     }
-    return false;
+    return true;
 }
 
 void CalibrationService::updateProgress(const char* label, float progressVal, float current, uint32_t remaining) {
@@ -53,8 +53,8 @@ private:
     static constexpr float MIN_TEMP_DIFF_FOR_WARNING = 5.0f;    // 5°C difference triggers warning
 
     // Temperature points for multi-point calibration
-    static constexpr float TEMP_POINTS[] = {25.0f, 100.0f, 200.0f};  // °C
-    static constexpr size_t NUM_TEMP_POINTS = sizeof(TEMP_POINTS) / sizeof(TEMP_POINTS[0]);
+    static constexpr const float (&TEMP_POINTS)[ThermalCalibrationSummary::NUM_TEMP_POINTS] = ThermalCalibrationSummary::TEMP_POINTS;  // °C
+    static constexpr size_t NUM_TEMP_POINTS = ThermalCalibrationSummary::NUM_TEMP_POINTS;
 
     CalibrationData data;
     CalibrationState state;
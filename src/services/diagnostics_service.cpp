@@ -0,0 +1,151 @@
+#include "services/diagnostics_service.h"
+#include "services/temperature_control_service.h"
+#include "library/message.pb.h"
+#include "pb_encode.h"
+#include "pico/stdlib.h"
+#include <string.h>
+
+DiagnosticsService& DiagnosticsService::getInstance() {
+    static DiagnosticsService instance;
+    return instance;
+}
+
+DiagnosticsService::DiagnosticsService()
+    : previousCount(0),
+      previousSampleUs(0),
+      taskHandle(nullptr) {
+    snapshot = {};
+}
+
+void DiagnosticsService::init() {
+    // Keep each idle task on its own core, so its share of the window is that core's idle time
+    for (BaseType_t core = 0; core < configNUMBER_OF_CORES; ++core) {
+        vTaskCoreAffinitySet(xTaskGetIdleTaskHandleForCore(core), 1u << core);
+    }
+
+    xTaskCreate(diagnosticsTaskWrapper, "Diagnostics", 1024, this, 1, &taskHandle);
+}
+
+void DiagnosticsService::diagnosticsTaskWrapper(void* pvParameters) {
+    static_cast<DiagnosticsService*>(pvParameters)->diagnosticsTask();
+}
+
+void DiagnosticsService::diagnosticsTask() {
+    TickType_t lastWakeTime = xTaskGetTickCount();
+    const TickType_t period = pdMS_TO_TICKS(DIAGNOSTICS_PERIOD_MS);
+
+    while (true) {
+        vTaskDelayUntil(&lastWakeTime, period);
+        sample();
+    }
+}
+
+void DiagnosticsService::sample() {
+    UBaseType_t count = uxTaskGetSystemState(taskStatus, MAX_SAMPLED_TASKS, nullptr);
+    uint64_t nowUs = time_us_64();
+    uint64_t windowUs = nowUs - previousSampleUs;
+
+    TaskHandle_t idleTasks[configNUMBER_OF_CORES];
+    for (BaseType_t core = 0; core < configNUMBER_OF_CORES; ++core) {
+        idleTasks[core] = xTaskGetIdleTaskHandleForCore(core);
+    }
+
+    snapshot.uptimeMs = static_cast<uint32_t>(nowUs / 1000);
+    snapshot.taskCount = 0;
+    snapshot.tasksTruncated = (count == 0 || count > DIAGNOSTICS_MAX_TASKS);
+
+    RunTimeMark current[MAX_SAMPLED_TASKS];
+    for (UBaseType_t i = 0; i < count; ++i) {
+        const TaskStatus_t& status = taskStatus[i];
+
+        // A task created since the last sample has run for all of its counter
+        configRUN_TIME_COUNTER_TYPE runTime = status.ulRunTimeCounter;
+        for (size_t j = 0; j < previousCount; ++j) {
+            if (previous[j].handle == status.xHandle) {
+                runTime -= previous[j].runTime;
+                break;
+            }
+        }
+        current[i] = {status.xHandle, status.ulRunTimeCounter};
+
+        uint64_t permille = windowUs ? runTime * 1000 / windowUs : 0;
+        if (permille > 1000) permille = 1000;
+
+        for (BaseType_t core = 0; core < configNUMBER_OF_CORES; ++core) {
+            if (status.xHandle == idleTasks[core]) {
+                snapshot.coreLoadPermille[core] = static_cast<uint16_t>(1000 - permille);
+            }
+        }
+
+        TaskDiagnostics task = {};
+        strncpy(task.name, status.pcTaskName, sizeof(task.name) - 1);
+        task.cpuPermille = static_cast<uint16_t>(permille);
+        task.coreAffinity = static_cast<uint8_t>(status.uxCoreAffinityMask & ((1u << configNUMBER_OF_CORES) - 1));
+        task.priority = static_cast<uint8_t>(status.uxCurrentPriority);
+        task.stackHighWater = status.usStackHighWaterMark * sizeof(StackType_t);
+
+        // Keep the busiest tasks, sorted by CPU share
+        size_t slot = snapshot.taskCount;
+        while (slot > 0 && snapshot.tasks[slot - 1].cpuPermille < task.cpuPermille) slot--;
+        if (slot >= DIAGNOSTICS_MAX_TASKS) continue;
+        size_t last = snapshot.taskCount < DIAGNOSTICS_MAX_TASKS ? snapshot.taskCount : DIAGNOSTICS_MAX_TASKS - 1;
+        memmove(&snapshot.tasks[slot + 1], &snapshot.tasks[slot], (last - slot) * sizeof(TaskDiagnostics));
+        snapshot.tasks[slot] = task;
+        if (snapshot.taskCount < DIAGNOSTICS_MAX_TASKS) snapshot.taskCount++;
+    }
+
+    memcpy(previous, current, count * sizeof(RunTimeMark));
+    previousCount = count;
+    previousSampleUs = nowUs;
+
+    snapshot.heapFreeBytes = xPortGetFreeHeapSize();
+    snapshot.heapMinFreeBytes = xPortGetMinimumEverFreeHeapSize();
+    snapshot.controlLoop = TemperatureControlService::getInstance().getLoopTrace();
+    snapshot.sequence++;
+
+    published.write(snapshot);
+}
+
+DiagnosticsSnapshot DiagnosticsService::getSnapshot() const {
+    return published.read();
+}
+
+uint32_t DiagnosticsService::getSequence() const {
+    return published.getSequence();
+}
+
+bool DiagnosticsService::encode(pb_ostream_t* stream) const {
+    DiagnosticsSnapshot source = getSnapshot();
+
+    oven_Diagnostics message = oven_Diagnostics_init_zero;
+    message.uptime_ms = source.uptimeMs;
+    message.core_load_permille_count = 2;
+    message.core_load_permille[0] = source.coreLoadPermille[0];
+    message.core_load_permille[1] = source.coreLoadPermille[1];
+
+    message.tasks_count = source.taskCount;
+    for (uint8_t i = 0; i < source.taskCount; ++i) {
+        const TaskDiagnostics& task = source.tasks[i];
+        oven_TaskStats& out = message.tasks[i];
+        memcpy(out.name, task.name, sizeof(out.name));
+        out.name[sizeof(out.name) - 1] = '\0';
+        out.cpu_permille = task.cpuPermille;
+        out.core_affinity = task.coreAffinity;
+        out.stack_high_water = task.stackHighWater;
+        out.priority = task.priority;
+    }
+
+    message.heap_free_bytes = source.heapFreeBytes;
+    message.heap_min_free_bytes = source.heapMinFreeBytes;
+    const LoopTrace& loop = source.controlLoop;
+    message.control_period_min_us = loop.periodMinUs;
+    message.control_period_max_us = loop.periodMaxUs;
+    message.control_period_mean_us = loop.periodMeanUs();
+    message.control_exec_max_us = loop.execution.maxUs;
+    message.control_overruns = loop.deadlineMisses;
+    message.control_lateness_p99_us = loop.lateness.percentileUs(99.0f);
+    message.control_lateness_max_us = loop.lateness.maxUs;
+    message.control_exec_p99_us = loop.execution.percentileUs(99.0f);
+
+    return pb_encode(stream, oven_Diagnostics_fields, &message);
+}
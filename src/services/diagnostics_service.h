@@ -0,0 +1,53 @@
+#pragma once
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pb.h"
+#include "types/diagnostics.h"
+#include "library/seq_lock.h"
+#include "constants.h"
+
+// Samples the scheduler's run-time counters once per DIAGNOSTICS_PERIOD_MS and
+// publishes per-task CPU share, per-core load, stack and heap low-water marks
+// and the control loop timing as one snapshot. Readers on either core get a
+// consistent copy without blocking the sampler.
+class DiagnosticsService {
+public:
+    static DiagnosticsService& getInstance();
+
+    void init();
+
+    DiagnosticsSnapshot getSnapshot() const;
+    // Changes whenever a new snapshot is published; cheap enough to poll from a binding
+    uint32_t getSequence() const;
+
+    // Latest snapshot as a Diagnostics protobuf message. Builds the ~560 byte
+    // message struct on the caller's stack.
+    bool encode(pb_ostream_t* stream) const;
+
+private:
+    // uxTaskGetSystemState() fails outright if the array cannot hold every task,
+    // so it is sized above DIAGNOSTICS_MAX_TASKS; the busiest tasks are reported
+    static constexpr size_t MAX_SAMPLED_TASKS = 24;
+
+    DiagnosticsService();
+    static void diagnosticsTaskWrapper(void* pvParameters);
+    void diagnosticsTask();
+    void sample();
+
+    // Run-time counter of each task at the previous sample, matched by handle
+    struct RunTimeMark {
+        TaskHandle_t handle;
+        configRUN_TIME_COUNTER_TYPE runTime;
+    };
+
+    // Diagnostics task only
+    TaskStatus_t taskStatus[MAX_SAMPLED_TASKS];
+    RunTimeMark previous[MAX_SAMPLED_TASKS];
+    size_t previousCount;
+    uint64_t previousSampleUs;
+    DiagnosticsSnapshot snapshot;
+
+    SeqLock<DiagnosticsSnapshot> published;
+    TaskHandle_t taskHandle;
+};
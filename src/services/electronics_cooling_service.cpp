@@ -34,6 +34,10 @@ void ElectronicsCoolingService::init() {
     }, "ElectronicsCoolinTask", 1024, this, 1, nullptr);
 }
 
+int ElectronicsCoolingService::getFanSpeed() const {
+    return currentFanSpeed;
+}
+
 uint ElectronicsCoolingService::calculatePWMWrapValue(uint frequency)
 {
   return (SYSTEM_CLOCK / (frequency * CLOCK_DIV)) - 1;
@@ -43,7 +47,7 @@ void ElectronicsCoolingService::electronicsCoolingTask() {
     const TickType_t xDelay = pdMS_TO_TICKS(100); // Smooth ramp
     while (1)
     {
-        const SensorState& sensorState = SensorService::getInstance().getState();
+        SensorState sensorState = SensorService::getInstance().getState();
         float ssrTemp = sensorState.ssrTemp;
 
         // Set target fan speed based on SSR temp
@@ -14,6 +14,7 @@ public:
     static ElectronicsCoolingService& getInstance();
 
     void init();
+    int getFanSpeed() const;  // Current duty in percent
 
 private:
     ElectronicsCoolingService();
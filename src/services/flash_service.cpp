@@ -0,0 +1,185 @@
+#include "services/flash_service.h"
+#include "hardware/flash.h"
+#include "pico/flash.h"
+
+static_assert(FLASH_SECTOR_ERASE_US <= FLASH_WINDOW_BUDGET_US, "a sector erase must fit in one window");
+static_assert(FLASH_WINDOW_BUDGET_US + FLASH_WINDOW_MARGIN_US < HEATER_CONTROL_PERIOD_MS * 1000,
+              "a flash window must fit between two control iterations");
+
+FlashService& FlashService::getInstance() {
+    static FlashService instance;
+    return instance;
+}
+
+FlashService::FlashService()
+    : batchMutex(xSemaphoreCreateMutex()),
+      batchDone(xSemaphoreCreateBinary()),
+      pending(nullptr),
+      pendingCount(0),
+      cursor{0, 0},
+      pendingOk(false),
+      windowRunning(false),
+      cancelRequested(false),
+      controlLoopAttached(false),
+      maxBlackoutUs(0),
+      windowCount(0) {}
+
+bool FlashService::execute(const Operation* operations, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (!isAligned(operations[i])) return false;
+    }
+    if (count == 0) return true;
+
+    xSemaphoreTake(batchMutex, portMAX_DELAY);
+
+    if (!controlLoopAttached) {
+        bool ok = true;
+        Window window;
+        Cursor position = {0, 0};
+        while (ok && position.index < count) {
+            planWindow(operations, count, position, FLASH_WINDOW_BUDGET_US, &window);
+            ok = runPlanned(window);
+            position = window.end;
+        }
+        xSemaphoreGive(batchMutex);
+        return ok;
+    }
+
+    taskENTER_CRITICAL();
+    pending = operations;
+    pendingCount = count;
+    cursor = {0, 0};
+    pendingOk = true;
+    cancelRequested = false;
+    taskEXIT_CRITICAL();
+
+    bool ok;
+    if (xSemaphoreTake(batchDone, pdMS_TO_TICKS(FLASH_OP_TIMEOUT_MS)) == pdTRUE) {
+        ok = pendingOk;
+    } else {
+        // Withdraw the batch; a window already on its way is bounded, so wait for it
+        taskENTER_CRITICAL();
+        bool finished = (pending == nullptr);
+        bool running = windowRunning;
+        if (!finished && !running) pending = nullptr;
+        if (running) cancelRequested = true;
+        taskEXIT_CRITICAL();
+
+        if (finished || running) xSemaphoreTake(batchDone, portMAX_DELAY);
+        ok = finished && pendingOk;
+    }
+
+    xSemaphoreGive(batchMutex);
+    return ok;
+}
+
+bool FlashService::erase(uint32_t offset, size_t length) {
+    Operation operation = {Operation::Type::ERASE, offset, nullptr, length};
+    return execute(&operation, 1);
+}
+
+bool FlashService::program(uint32_t offset, const uint8_t* data, size_t length) {
+    Operation operation = {Operation::Type::PROGRAM, offset, data, length};
+    return execute(&operation, 1);
+}
+
+void FlashService::attachControlLoop() {
+    controlLoopAttached = true;
+}
+
+void FlashService::runWindow(uint32_t slackUs, SsrDriver& heater) {
+    if (slackUs <= FLASH_WINDOW_MARGIN_US) return;
+    uint32_t budgetUs = slackUs - FLASH_WINDOW_MARGIN_US;
+    if (budgetUs > FLASH_WINDOW_BUDGET_US) budgetUs = FLASH_WINDOW_BUDGET_US;
+
+    Window window;
+    taskENTER_CRITICAL();
+    bool planned = pending && planWindow(pending, pendingCount, cursor, budgetUs, &window);
+    windowRunning = planned;
+    taskEXIT_CRITICAL();
+    if (!planned) return;
+
+    // An erase can take longer than a control period; don't leave the heater on across it
+    float power = heater.getPower();
+    if (window.erases) heater.off();
+    bool ok = runPlanned(window);
+    if (window.erases) heater.setPower(power);
+
+    taskENTER_CRITICAL();
+    windowRunning = false;
+    cursor = window.end;
+    if (!ok) pendingOk = false;
+    bool finished = !ok || cancelRequested || cursor.index >= pendingCount;
+    if (finished) pending = nullptr;
+    taskEXIT_CRITICAL();
+
+    if (finished) xSemaphoreGive(batchDone);
+}
+
+bool FlashService::isAligned(const Operation& operation) {
+    size_t unit = unitSize(operation);
+    if (operation.length == 0 || operation.offset % unit != 0 || operation.length % unit != 0) return false;
+    return operation.type == Operation::Type::ERASE || operation.data != nullptr;
+}
+
+uint32_t FlashService::unitCostUs(const Operation& operation) {
+    return operation.type == Operation::Type::ERASE ? FLASH_SECTOR_ERASE_US : FLASH_PAGE_PROGRAM_US;
+}
+
+size_t FlashService::unitSize(const Operation& operation) {
+    return operation.type == Operation::Type::ERASE ? FLASH_SECTOR_SIZE : FLASH_PAGE_SIZE;
+}
+
+bool FlashService::planWindow(const Operation* operations, size_t count, Cursor from, uint32_t budgetUs,
+                              Window* window) {
+    window->operations = operations;
+    window->begin = from;
+    window->erases = false;
+
+    uint32_t costUs = 0;
+    Cursor position = from;
+    while (position.index < count) {
+        const Operation& operation = operations[position.index];
+        uint32_t unitUs = unitCostUs(operation);
+        if (costUs + unitUs > budgetUs) break;
+
+        costUs += unitUs;
+        if (operation.type == Operation::Type::ERASE) window->erases = true;
+        position.done += unitSize(operation);
+        if (position.done >= operation.length) {
+            position.index++;
+            position.done = 0;
+        }
+    }
+
+    window->end = position;
+    return costUs > 0;
+}
+
+bool FlashService::runPlanned(Window& window) {
+    uint64_t startUs = time_us_64();
+    int result = flash_safe_execute(flashWindow, &window, FLASH_LOCKOUT_TIMEOUT_MS);
+    uint32_t blackoutUs = static_cast<uint32_t>(time_us_64() - startUs);
+
+    if (blackoutUs > maxBlackoutUs) maxBlackoutUs = blackoutUs;
+    windowCount++;
+    return result == PICO_OK;
+}
+
+void FlashService::flashWindow(void* param) {
+    // The other core is parked and interrupts are off; contiguous units of one operation go in one call
+    const Window& window = *static_cast<const Window*>(param);
+    Cursor position = window.begin;
+    while (position.index < window.end.index || (position.index == window.end.index && position.done < window.end.done)) {
+        const Operation& operation = window.operations[position.index];
+        size_t stop = (position.index == window.end.index) ? window.end.done : operation.length;
+
+        if (operation.type == Operation::Type::ERASE) {
+            flash_range_erase(operation.offset + position.done, stop - position.done);
+        } else {
+            flash_range_program(operation.offset + position.done, operation.data + position.done, stop - position.done);
+        }
+        position.index++;
+        position.done = 0;
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "library/ssr_driver.h"
+#include "constants.h"
+
+// Serialises flash erase / program for the whole firmware. Both cores run
+// from XIP flash, so while the flash is busy the other core is parked in RAM
+// with interrupts off (flash_safe_execute() from pico_flash, which uses a
+// lockout task on the other core under FreeRTOS SMP).
+//
+// A batch is split into windows of at most FLASH_WINDOW_BUDGET_US of planned
+// flash time. Once the control loop is running the windows are run by the
+// control task itself, right after an iteration and only if the window fits
+// in the time left before its next release, so a flash write never delays a
+// control iteration and nothing else drives the SSR meanwhile. The PIO keeps
+// firing the SSR at the power the loop just set; during an erase, whose
+// worst case exceeds a control period, the SSR is held off instead.
+// Before the control loop starts, windows run directly on the caller.
+class FlashService {
+public:
+    struct Operation {
+        enum class Type : uint8_t {
+            ERASE,      // 'length' a multiple of FLASH_SECTOR_SIZE
+            PROGRAM     // 'length' a multiple of FLASH_PAGE_SIZE
+        };
+        Type type;
+        uint32_t offset;        // From the start of flash, aligned to the unit above
+        const uint8_t* data;    // PROGRAM only; must stay valid until execute() returns
+        size_t length;
+    };
+
+    static FlashService& getInstance();
+
+    // Runs the operations in order and blocks until they are done. Returns false
+    // on a misaligned operation, if the other core could not be parked, or if
+    // the batch was not scheduled within FLASH_OP_TIMEOUT_MS. Must not be called
+    // from the control task.
+    bool execute(const Operation* operations, size_t count);
+    bool erase(uint32_t offset, size_t length);
+    bool program(uint32_t offset, const uint8_t* data, size_t length);
+
+    // Control task only. From now on batches wait for runWindow().
+    void attachControlLoop();
+    // Control task only, after an iteration: runs the next window of the
+    // pending batch if it fits in 'slackUs', the time until the next release.
+    void runWindow(uint32_t slackUs, SsrDriver& heater);
+
+    uint32_t getMaxBlackoutUs() const { return maxBlackoutUs; }
+    uint32_t getWindowCount() const { return windowCount; }
+
+private:
+    // Position within a batch: operation index and bytes of it already done
+    struct Cursor {
+        size_t index;
+        size_t done;
+    };
+
+    struct Window {
+        const Operation* operations;
+        Cursor begin;
+        Cursor end;
+        bool erases;
+    };
+
+    FlashService();
+    static bool isAligned(const Operation& operation);
+    static uint32_t unitCostUs(const Operation& operation);
+    static size_t unitSize(const Operation& operation);
+    // Units from 'from' that fit in 'budgetUs'; false if not even one fits
+    static bool planWindow(const Operation* operations, size_t count, Cursor from, uint32_t budgetUs,
+                           Window* window);
+    bool runPlanned(Window& window);
+    static void flashWindow(void* param);
+
+    SemaphoreHandle_t batchMutex;   // One batch at a time
+    SemaphoreHandle_t batchDone;    // Given by the control task when it is through with a batch
+
+    // Pending batch, guarded by a critical section
+    const Operation* pending;
+    size_t pendingCount;
+    Cursor cursor;
+    bool pendingOk;
+    bool windowRunning;
+    bool cancelRequested;
+
+    volatile bool controlLoopAttached;
+    volatile uint32_t maxBlackoutUs;
+    volatile uint32_t windowCount;
+};
@@ -3,15 +3,16 @@
 #include "isr_handlers.h"
 #include "services/ui_view_service.h"
 #include "services/buzzer_service.h"
+#include "hardware/irq.h"
 #include <cstdio>
 
-QueueHandle_t InteractionService::interactionQueue = nullptr;
 TimerHandle_t InteractionService::debounceTimer = nullptr;
 TimerHandle_t InteractionService::longPressTimer = nullptr;
 
 volatile bool InteractionService::buttonState = false;
 volatile bool InteractionService::longPressHandled = false;
-volatile int32_t InteractionService::encoderPosition = 0;
+QuadratureEncoder InteractionService::encoder(ENCODER_PIO, ENCODER_DC_GPIO);
+int32_t InteractionService::detentOrigin = 0;
 
 UIViewService* InteractionService::uiService = nullptr;
 
@@ -23,16 +24,13 @@ InteractionService& InteractionService::getInstance() {
 void InteractionService::init() {
     uiService = &UIViewService::getInstance();
 
-    interactionQueue = xQueueCreate(10, sizeof(Interaction));
-
-    // Encoder pin setup
-    gpio_init(ENCODER_CLK_GPIO);
-    gpio_init(ENCODER_DC_GPIO);
-    gpio_set_dir(ENCODER_CLK_GPIO, GPIO_IN);
-    gpio_set_dir(ENCODER_DC_GPIO, GPIO_IN);
-
-    gpio_set_irq_enabled(ENCODER_CLK_GPIO, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true); // ✅ REQUIRED
-    gpio_set_irq_enabled(ENCODER_DC_GPIO, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);  // optional, only if needed
+    // Encoder: DC is channel A, CLK (the next GPIO) channel B. No GPIO edge interrupts.
+    encoder.init(ENCODER_PIO_CLOCK_HZ);
+    detentOrigin = encoder.getCount();
+    uiService->setEncoderSource(takeEncoderDetents, nullptr);
+    irq_set_exclusive_handler(encoder.getIrq(), encoderMovedISR);
+    irq_set_enabled(encoder.getIrq(), true);
+    encoder.arm();
 
     // Button pin setup (encoder switch only)
     debounceTimer = xTimerCreate("DebounceTimer", pdMS_TO_TICKS(DEBOUNCE_TIME_MS), pdFALSE, nullptr, debounceTimerCallback);
@@ -42,70 +40,33 @@ void InteractionService::init() {
     gpio_set_dir(ENCODER_SW_GPIO, GPIO_IN);
     gpio_pull_up(ENCODER_SW_GPIO); // Assuming active low button
     gpio_set_irq_enabled(ENCODER_SW_GPIO, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
-
-    xTaskCreate(interactionTask, "Interaction", 2048, this, 1, &taskHandle);
-}
-
-void InteractionService::handleInteraction(Interaction interaction) {
-    if (!uiService) return;
-
-    switch (interaction) {
-        case Interaction::ENTER:
-            printf("ENTER COMMAND\n");
-            uiService->handleEncoderPress();
-            break;
-        case Interaction::BACK:
-            printf("BACK COMMAND\n");
-            uiService->handleEncoderLongPress();
-            break;
-        case Interaction::UP:
-            printf("UP COMMAND\n");
-            uiService->handleEncoderUp();
-            break;
-        case Interaction::DOWN:
-            printf("DOWN COMMAND\n");
-            uiService->handleEncoderDown();
-            break;
-        default: break;
-    }
 }
 
 void InteractionService::gpioISR(uint gpio, uint32_t events) {
-    // Handle encoder
-    if (gpio == ENCODER_CLK_GPIO) {
-        static int32_t last_level_a = -1;
-        static int32_t lastEncoderPosition = 0;
-        int level_a = gpio_get(ENCODER_CLK_GPIO);
-        int level_b = gpio_get(ENCODER_DC_GPIO);
-
-        if (level_a != last_level_a) {
-            last_level_a = level_a;
-            if (level_a == 1) {
-                encoderPosition += (level_b == 1 ? 1 : -1);
-            } else {
-                encoderPosition += (level_b == 0 ? 1 : -1);
-            }
-
-            Interaction action = Interaction::NONE;
-            if (encoderPosition > lastEncoderPosition) {
-                action = Interaction::UP;
-            } else if (encoderPosition < lastEncoderPosition) {
-                action = Interaction::DOWN;
-            }
-            lastEncoderPosition = encoderPosition;
-
-            if (action != Interaction::NONE) {
-                xQueueSendFromISR(interactionQueue, &action, NULL);
-            }
-        }
-    }
     // Handle encoder button
-    else if (gpio == ENCODER_SW_GPIO) {
+    if (gpio == ENCODER_SW_GPIO) {
         BaseType_t higherPriorityTaskWoken = pdFALSE;
         xTimerResetFromISR(debounceTimer, &higherPriorityTaskWoken);
     }
 }
 
+void InteractionService::encoderMovedISR() {
+    // One interrupt per frame at most; takeEncoderDetents() re-arms it
+    encoder.disarm();
+    if (uiService) uiService->postEncoderMovedFromISR();
+}
+
+int32_t InteractionService::takeEncoderDetents(void* context) {
+    // Re-arm before reading, so movement after the read raises a new interrupt
+    encoder.arm();
+
+    // The state machine counts down for what the UI calls up
+    int32_t counts = detentOrigin - encoder.getCount();
+    int32_t detents = counts / ENCODER_COUNTS_PER_DETENT;
+    detentOrigin -= detents * ENCODER_COUNTS_PER_DETENT;
+    return detents;
+}
+
 void InteractionService::debounceTimerCallback(TimerHandle_t xTimer) {
     auto& instance = getInstance();
     bool currentLevel = gpio_get(ENCODER_SW_GPIO) == 0; // Assuming active low
@@ -117,9 +78,8 @@ void InteractionService::debounceTimerCallback(TimerHandle_t xTimer) {
             instance.longPressHandled = false;
         } else {
             xTimerStop(instance.longPressTimer, 0);
-            if (!instance.longPressHandled) {
-                Interaction action = Interaction::ENTER;
-                xQueueSend(instance.interactionQueue, &action, 0);
+            if (!instance.longPressHandled && uiService) {
+                uiService->postEncoderPress();
             }
         }
     }
@@ -128,17 +88,5 @@ void InteractionService::debounceTimerCallback(TimerHandle_t xTimer) {
 void InteractionService::longPressTimerCallback(TimerHandle_t xTimer) {
     auto& instance = getInstance();
     instance.longPressHandled = true;
-    Interaction action = Interaction::BACK;
-    xQueueSend(instance.interactionQueue, &action, 0);
-}
-
-void InteractionService::interactionTask(void* params) {
-    auto* instance = static_cast<InteractionService*>(params);
-    Interaction interaction = Interaction::NONE;
-
-    while (true) {
-        if (xQueueReceive(instance->interactionQueue, &interaction, portMAX_DELAY) == pdPASS) {
-            instance->handleInteraction(interaction);
-        }
-    }
+    if (uiService) uiService->postEncoderLongPress();
 }
@@ -3,32 +3,27 @@
 #include "core/service.h"
 #include "FreeRTOS.h"
 #include "task.h"
-#include "queue.h"
 #include "timers.h"
 #include "pico/stdlib.h"
+#include "library/quadrature_encoder.h"
 #include <cstdint>
 
 class UIViewService; // Forward declaration
 
-// Interaction types
-enum class Interaction {
-    NONE,
-    ENTER,
-    BACK,
-    UP,
-    DOWN,
-};
-
+// Encoder and button front end. The encoder is decoded by a PIO state machine
+// that raises at most one interrupt per UI frame; the UI reads the detents
+// straight from its count. Presses go into the UI's input pipeline from the
+// debounce timers. Nothing is queued per event.
 class InteractionService : public Service {
 public:
     static InteractionService& getInstance();
 
     // Initialization and control
     void init();
-    void handleInteraction(Interaction interaction);
 
     // ISR handlers
     void gpioISR(uint gpio, uint32_t events);
+    static void encoderMovedISR();
     static void debounceTimerCallback(TimerHandle_t xTimer);
     static void longPressTimerCallback(TimerHandle_t xTimer);
 
@@ -38,17 +33,16 @@ private:
     InteractionService(const InteractionService&) = delete;
     InteractionService& operator=(const InteractionService&) = delete;
 
-    // Task entry points
-    static void interactionTask(void* params);
+    // Polled by the UI on the frame after a movement interrupt
+    static int32_t takeEncoderDetents(void* context);
 
     // Static member variables
-    static QueueHandle_t interactionQueue;
     static TimerHandle_t debounceTimer;
     static TimerHandle_t longPressTimer;
     static volatile bool buttonState;
     static volatile bool longPressHandled;
-    static volatile int32_t encoderPosition;
+    static QuadratureEncoder encoder;
+    static int32_t detentOrigin;  // Count at the last whole detent handed to the UI
     static UIViewService* uiService;
-    TaskHandle_t taskHandle = nullptr;
 };
 
@@ -0,0 +1,161 @@
+#include "services/profile_service.h"
+#include "services/flash_service.h"
+#include "hardware/flash.h"
+#include "pb_decode.h"
+#include <string.h>
+#include <stdio.h>
+
+static_assert(PROFILE_STORE_FLASH_OFFSET >= RUN_LOG_FLASH_OFFSET + RUN_LOG_FLASH_SIZE, "the profile store overlaps the run log");
+static_assert(PROFILE_STORE_SECTORS <= ProfileStore::MAX_SECTORS, "too many profile store sectors");
+static_assert(ProfileStore::SECTOR_SIZE == FLASH_SECTOR_SIZE, "profile store sector size");
+static_assert(ProfileStore::SLOT_SIZE == FLASH_PAGE_SIZE, "profile store page size");
+static_assert(StoredProfile::MAX_POINTS <= ReflowCurve::MAX_STEPS, "a stored profile must fit in a ReflowCurve");
+static_assert(StoredProfile::NAME_SIZE == ReflowCurve::NAME_SIZE, "profile and curve names are the same size");
+
+ProfileService& ProfileService::getInstance() {
+    static ProfileService instance;
+    return instance;
+}
+
+ProfileService::ProfileService()
+    : store(reinterpret_cast<const uint8_t*>(XIP_BASE + PROFILE_STORE_FLASH_OFFSET), PROFILE_STORE_FLASH_OFFSET,
+            PROFILE_STORE_SECTORS, {eraseFlash, programFlash, nullptr}),
+      mutex(xSemaphoreCreateMutex()) {
+    store.mount();
+}
+
+size_t ProfileService::getCount() {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    size_t count = store.getCount();
+    xSemaphoreGive(mutex);
+    return count;
+}
+
+bool ProfileService::copy(size_t index, StoredProfile* profile) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    const StoredProfile* stored = store.get(index);
+    if (stored) *profile = *stored;
+    xSemaphoreGive(mutex);
+    return stored != nullptr;
+}
+
+bool ProfileService::copyByHash(uint32_t nameHash, StoredProfile* profile) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    const StoredProfile* stored = store.findByHash(nameHash);
+    if (stored) *profile = *stored;
+    xSemaphoreGive(mutex);
+    return stored != nullptr;
+}
+
+bool ProfileService::copyByName(const char* name, StoredProfile* profile) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    const StoredProfile* stored = store.findByName(name);
+    if (stored) *profile = *stored;
+    xSemaphoreGive(mutex);
+    return stored != nullptr;
+}
+
+void ProfileService::toCurve(const StoredProfile& profile, ReflowCurve* curve) {
+    *curve = ReflowCurve{};
+    memcpy(curve->name, profile.name, sizeof(curve->name));
+    curve->minimumStartTempC = PROFILE_MIN_START_TEMP_C;
+    curve->liquidusTempC = ReflowCurve::DEFAULT_LIQUIDUS_C;
+    curve->stepCount = profile.pointCount;
+
+    uint32_t previousMs = 0;
+    for (size_t i = 0; i < profile.pointCount; ++i) {
+        const ProfilePoint& point = profile.points[i];
+        curve->steps[i] = {StepLabel::NONE, point.tempC, point.timeMs - previousMs};
+        previousMs = point.timeMs;
+    }
+}
+
+oven_ProfileUploadResult ProfileService::upload(const uint8_t* payload, size_t length) {
+    oven_ProfileUploadResult result = oven_ProfileUploadResult_init_zero;
+
+    xSemaphoreTake(mutex, portMAX_DELAY);
+
+    memset(&incoming, 0, sizeof(incoming));
+    DecodeState state = {&incoming, 0, 0};
+    oven_ReflowCurve message = oven_ReflowCurve_init_zero;
+    message.name.funcs.decode = decodeName;
+    message.name.arg = &state;
+    message.temp_points.funcs.decode = decodeTemp;
+    message.temp_points.arg = &state;
+    message.time_points_ms.funcs.decode = decodeTime;
+    message.time_points_ms.arg = &state;
+
+    pb_istream_t stream = pb_istream_from_buffer(payload, length);
+    bool decoded = pb_decode(&stream, oven_ReflowCurve_fields, &message)
+        && incoming.name[0] != '\0'
+        && state.temps == state.times;
+
+    for (size_t i = 0; decoded && i < state.temps; ++i) {
+        float temp = incoming.points[i].tempC;
+        if (!(temp >= 0.0f && temp <= PROFILE_MAX_TEMP_C)) decoded = false;
+    }
+
+    if (!decoded) {
+        result.status = oven_ProfileUploadResult_Status_INVALID;
+    } else if (state.temps == 0) {
+        result.status = store.remove(incoming.name)
+            ? oven_ProfileUploadResult_Status_OK : oven_ProfileUploadResult_Status_NOT_FOUND;
+    } else {
+        incoming.pointCount = static_cast<uint8_t>(state.temps);
+        switch (store.store(incoming)) {
+            case ProfileStore::Result::OK: result.status = oven_ProfileUploadResult_Status_OK; break;
+            case ProfileStore::Result::FULL: result.status = oven_ProfileUploadResult_Status_FULL; break;
+            case ProfileStore::Result::FLASH_ERROR: result.status = oven_ProfileUploadResult_Status_FLASH_ERROR; break;
+            default: result.status = oven_ProfileUploadResult_Status_INVALID; break;
+        }
+    }
+
+    if (incoming.name[0] != '\0') result.name_hash = ProfileStore::hashName(incoming.name);
+    result.profile_count = store.getCount();
+
+    // 'incoming' belongs to the next upload as soon as the mutex is given back
+    char name[StoredProfile::NAME_SIZE];
+    memcpy(name, incoming.name, sizeof(name));
+
+    xSemaphoreGive(mutex);
+
+    if (result.status == oven_ProfileUploadResult_Status_FLASH_ERROR) {
+        printf("Profiles: storing \"%s\" failed\n", name);
+    }
+    return result;
+}
+
+bool ProfileService::decodeName(pb_istream_t* stream, const pb_field_t*, void** arg) {
+    StoredProfile* profile = static_cast<DecodeState*>(*arg)->profile;
+    size_t length = stream->bytes_left;
+    if (length >= sizeof(profile->name)) return false;
+    if (!pb_read(stream, reinterpret_cast<pb_byte_t*>(profile->name), length)) return false;
+    profile->name[length] = '\0';
+    return true;
+}
+
+bool ProfileService::decodeTemp(pb_istream_t* stream, const pb_field_t*, void** arg) {
+    DecodeState* state = static_cast<DecodeState*>(*arg);
+    float value;
+    if (state->temps >= StoredProfile::MAX_POINTS || !pb_decode_fixed32(stream, &value)) return false;
+    state->profile->points[state->temps++].tempC = value;
+    return true;
+}
+
+bool ProfileService::decodeTime(pb_istream_t* stream, const pb_field_t*, void** arg) {
+    DecodeState* state = static_cast<DecodeState*>(*arg);
+    uint64_t value;
+    if (state->times >= StoredProfile::MAX_POINTS || !pb_decode_varint(stream, &value)) return false;
+    // A negative int32 comes through as a huge varint
+    if (value > INT32_MAX) return false;
+    state->profile->points[state->times++].timeMs = static_cast<uint32_t>(value);
+    return true;
+}
+
+bool ProfileService::eraseFlash(uint32_t offset, size_t length, void*) {
+    return FlashService::getInstance().erase(offset, length);
+}
+
+bool ProfileService::programFlash(uint32_t offset, const uint8_t* data, size_t length, void*) {
+    return FlashService::getInstance().program(offset, data, length);
+}
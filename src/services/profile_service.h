@@ -0,0 +1,50 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "library/profile_store.h"
+#include "library/message.pb.h"
+#include "models/reflow_model.h"
+#include "constants.h"
+
+// Reflow profiles uploaded by the host, kept in a ProfileStore at
+// PROFILE_STORE_FLASH_OFFSET. Uploads arrive as ReflowCurve messages (see
+// TelemetryService) and are decoded straight into the page to be programmed.
+// Lookups copy the profile out of flash under the mutex, since an upload can
+// erase the sector it sits in at any time; the catalogue itself costs no RAM.
+// All flash writes go through FlashService.
+class ProfileService {
+public:
+    static ProfileService& getInstance();
+
+    // In name order. The copies are false, and 'profile' untouched, if there is no such profile.
+    size_t getCount();
+    bool copy(size_t index, StoredProfile* profile);
+    bool copyByHash(uint32_t nameHash, StoredProfile* profile);
+    bool copyByName(const char* name, StoredProfile* profile);
+
+    // For ReflowEngine::start(); each point becomes a step ending at it
+    static void toCurve(const StoredProfile& profile, ReflowCurve* curve);
+
+    // Decodes a ReflowCurve message and stores, replaces or (with no points) removes that profile
+    oven_ProfileUploadResult upload(const uint8_t* payload, size_t length);
+
+private:
+    struct DecodeState {
+        StoredProfile* profile;
+        size_t temps;
+        size_t times;
+    };
+
+    ProfileService();
+    static bool decodeName(pb_istream_t* stream, const pb_field_t* field, void** arg);
+    static bool decodeTemp(pb_istream_t* stream, const pb_field_t* field, void** arg);
+    static bool decodeTime(pb_istream_t* stream, const pb_field_t* field, void** arg);
+    static bool eraseFlash(uint32_t offset, size_t length, void* context);
+    static bool programFlash(uint32_t offset, const uint8_t* data, size_t length, void* context);
+
+    ProfileStore store;
+    StoredProfile incoming;     // Guarded by mutex
+    SemaphoreHandle_t mutex;
+};
@@ -0,0 +1,95 @@
+#include "services/reflow_engine.h"
+#include "services/temperature_control_service.h"
+#include "constants.h"
+
+ReflowEngine& ReflowEngine::getInstance() {
+    static ReflowEngine instance;
+    return instance;
+}
+
+ReflowEngine::ReflowEngine()
+    : sequencer({setTarget, stopHeating, nullptr}),
+      taskHandle(nullptr) {
+    progress.write(ReflowProgress{});
+}
+
+void ReflowEngine::init() {
+    xTaskCreate(engineTaskWrapper, "ReflowEngine", 1024, this, 2, &taskHandle);
+    // Keep profile timing on the control core, away from LVGL rendering
+    vTaskCoreAffinitySet(taskHandle, (1 << 1));
+}
+
+bool ReflowEngine::start(const ReflowCurve& newCurve) {
+    float startTemp = TemperatureControlService::getInstance().getTemperature();
+
+    // The engine task on the other core sees the new table, start time and run state together
+    taskENTER_CRITICAL();
+    bool started = sequencer.start(newCurve, startTemp, to_ms_since_boot(get_absolute_time()));
+    taskEXIT_CRITICAL();
+    if (!started) return false;
+
+    publish(sequencer.makeProgress(ReflowRunState::RUNNING, 0));
+    if (taskHandle) {
+        xTaskNotifyGive(taskHandle);
+    }
+    return true;
+}
+
+void ReflowEngine::abort() {
+    if (!sequencer.isRunning()) return;
+    sequencer.abort();
+    if (taskHandle) {
+        xTaskNotifyGive(taskHandle);
+    }
+}
+
+bool ReflowEngine::isRunning() const {
+    return sequencer.isRunning();
+}
+
+ReflowProgress ReflowEngine::getProgress() const {
+    return progress.read();
+}
+
+const ReflowCurve& ReflowEngine::getCurve() const {
+    return sequencer.getCurve();
+}
+
+void ReflowEngine::engineTaskWrapper(void* pvParameters) {
+    static_cast<ReflowEngine*>(pvParameters)->engineTask();
+}
+
+void ReflowEngine::engineTask() {
+    const TickType_t period = pdMS_TO_TICKS(HEATER_CONTROL_PERIOD_MS);
+    TickType_t nextWake = xTaskGetTickCount() + period;
+
+    while (true) {
+        // Wake on the period, or early when start()/abort() need attention
+        TickType_t now = xTaskGetTickCount();
+        TickType_t wait = (static_cast<int32_t>(nextWake - now) > 0) ? nextWake - now : 0;
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        if (static_cast<int32_t>(xTaskGetTickCount() - nextWake) >= 0) {
+            nextWake += period;
+        }
+
+        if (sequencer.isRunning()) {
+            publish(sequencer.update(to_ms_since_boot(get_absolute_time())));
+        }
+    }
+}
+
+void ReflowEngine::setTarget(float temp, float rampRate, void*) {
+    TemperatureControlService::getInstance().setTargetTemperature(temp, rampRate);
+}
+
+void ReflowEngine::stopHeating(void*) {
+    TemperatureControlService::getInstance().stopHeating();
+}
+
+void ReflowEngine::publish(const ReflowProgress& snapshot) {
+    // start() on the UI core and the engine task can both publish
+    taskENTER_CRITICAL();
+    progress.write(snapshot);
+    taskEXIT_CRITICAL();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "models/reflow_model.h"
+#include "types/reflow_progress.h"
+#include "library/reflow_sequencer.h"
+#include "library/seq_lock.h"
+#include "constants.h"
+
+// Runs a reflow profile on the control core. The run itself is a
+// ReflowSequencer: the curve is turned into a ProfileTable once at start; from
+// then on every tick is a constant-time lookup of the setpoint and a lookahead
+// ramp rate for the feed-forward, fed straight to TemperatureControlService.
+// This service adds the task, the cross-core locking and the published
+// progress. Nothing here depends on the UI task, which only reads the
+// published progress.
+class ReflowEngine {
+public:
+    static ReflowEngine& getInstance();
+
+    void init();
+
+    // The first step ramps from the current oven temperature. Returns false if a
+    // profile is already running or the curve does not fit the segment table.
+    bool start(const ReflowCurve& curve);
+    void abort();
+
+    bool isRunning() const;
+    ReflowProgress getProgress() const;
+    // Valid while a run is active or until the next start()
+    const ReflowCurve& getCurve() const;
+
+private:
+    ReflowEngine();
+    static void engineTaskWrapper(void* pvParameters);
+    void engineTask();
+    void publish(const ReflowProgress& snapshot);
+    static void setTarget(float temp, float rampRate, void* context);
+    static void stopHeating(void* context);
+
+    ReflowSequencer sequencer;
+    SeqLock<ReflowProgress> progress;
+    TaskHandle_t taskHandle;
+};
@@ -0,0 +1,272 @@
+#include "services/run_recorder_service.h"
+#include "services/flash_service.h"
+#include "services/reflow_engine.h"
+#include "services/sensor_service.h"
+#include "services/temperature_control_service.h"
+#include "services/door_service.h"
+#include "services/telemetry_service.h"
+#include "library/message.pb.h"
+#include "pb_encode.h"
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+
+static_assert(RUN_LOG_FLASH_OFFSET % FLASH_SECTOR_SIZE == 0 && RUN_LOG_FLASH_SIZE % FLASH_SECTOR_SIZE == 0,
+              "the run log must be made of whole sectors");
+static_assert(RUN_LOG_FLASH_OFFSET >= SETTINGS_FLASH_OFFSET + SETTINGS_FLASH_SECTORS * FLASH_SECTOR_SIZE,
+              "the run log overlaps the settings store");
+static_assert(RunLog::PAGE_SIZE == FLASH_PAGE_SIZE, "run log page size");
+
+static int16_t toDeciC(float celsius) {
+    float deci = roundf(celsius * 10.0f);
+    if (deci > INT16_MAX) return INT16_MAX;
+    if (deci < INT16_MIN) return INT16_MIN;
+    return static_cast<int16_t>(deci);
+}
+
+static bool isErased(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+RunRecorderService& RunRecorderService::getInstance() {
+    static RunRecorderService instance;
+    return instance;
+}
+
+RunRecorderService::RunRecorderService()
+    : writePage(0),
+      runId(0),
+      sampleIndex(0),
+      runPeriodMs(RUN_LOG_SAMPLE_PERIOD_MS),
+      peakDeciC(0),
+      lastRunId(0),
+      samplePeriodMs(RUN_LOG_SAMPLE_PERIOD_MS),
+      recording(false),
+      exportRequested(false),
+      taskHandle(nullptr) {}
+
+void RunRecorderService::init() {
+    mount();
+    xTaskCreate(recorderTaskWrapper, "RunRecorder", 1024, this, 1, &taskHandle);
+}
+
+void RunRecorderService::setSamplePeriod(uint32_t periodMs) {
+    if (periodMs == 0 || periodMs > UINT16_MAX) return;
+    samplePeriodMs = periodMs;
+}
+
+uint32_t RunRecorderService::getSamplePeriod() const {
+    return samplePeriodMs;
+}
+
+void RunRecorderService::requestExport() {
+    exportRequested = true;
+}
+
+bool RunRecorderService::isRecording() const {
+    return recording;
+}
+
+uint32_t RunRecorderService::getLastRunId() const {
+    return lastRunId;
+}
+
+const uint8_t* RunRecorderService::pageAt(uint32_t page) const {
+    return reinterpret_cast<const uint8_t*>(XIP_BASE + RUN_LOG_FLASH_OFFSET) + page * RunLog::PAGE_SIZE;
+}
+
+void RunRecorderService::mount() {
+    // The newest page is the one with the highest run id and, within that run, the highest first sample
+    bool found = false;
+    uint32_t newestRun = 0;
+    uint32_t newestSample = 0;
+    uint32_t newestPage = 0;
+
+    RunLogPageReader reader;
+    for (uint32_t page = 0; page < PAGE_COUNT; ++page) {
+        if (!reader.open(pageAt(page))) continue;
+
+        const RunLog::PageHeader& header = reader.getHeader();
+        if (!found || header.runId > newestRun || (header.runId == newestRun && header.firstSample >= newestSample)) {
+            found = true;
+            newestRun = header.runId;
+            newestSample = header.firstSample;
+            newestPage = page;
+        }
+    }
+
+    writePage = found ? (newestPage + 1) % PAGE_COUNT : 0;
+    lastRunId = newestRun;
+}
+
+void RunRecorderService::recorderTaskWrapper(void* pvParameters) {
+    static_cast<RunRecorderService*>(pvParameters)->recorderTask();
+}
+
+void RunRecorderService::recorderTask() {
+    ReflowEngine& engine = ReflowEngine::getInstance();
+    TickType_t lastWakeTime = xTaskGetTickCount();
+
+    while (true) {
+        if (!recording) {
+            if (engine.isRunning()) {
+                startRun();
+                lastWakeTime = xTaskGetTickCount();
+                recordSample();
+                continue;
+            }
+            if (exportRequested) {
+                exportRequested = false;
+                exportLog();
+            }
+            vTaskDelay(pdMS_TO_TICKS(IDLE_POLL_MS));
+            continue;
+        }
+
+        vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(runPeriodMs));
+
+        switch (engine.getProgress().runState) {
+            case ReflowRunState::RUNNING: recordSample(); break;
+            case ReflowRunState::COMPLETE: finishRun(RunOutcome::COMPLETE); break;
+            default: finishRun(RunOutcome::ABORTED); break;
+        }
+    }
+}
+
+void RunRecorderService::startRun() {
+    runId = lastRunId + 1;
+    lastRunId = runId;
+    sampleIndex = 0;
+    runPeriodMs = samplePeriodMs;
+    peakDeciC = INT16_MIN;
+
+    // The engine only replaces its curve on start(), which needs the run to have ended
+    RunInfo info = {};
+    strncpy(info.curveName, ReflowEngine::getInstance().getCurve().name, sizeof(info.curveName) - 1);
+
+    writer.begin(runId, 0, static_cast<uint16_t>(runPeriodMs), &info);
+    recording = true;
+}
+
+void RunRecorderService::recordSample() {
+    RunSample sample;
+    sample.setpointDeciC = toDeciC(ReflowEngine::getInstance().getProgress().setpoint);
+    sample.tempDeciC = toDeciC(SensorService::getInstance().getState().currentTemp);
+    sample.heaterPercent = TemperatureControlService::getInstance().getHeaterPower();
+    sample.doorPercent = DoorService::getInstance().getPosition();
+    if (sample.tempDeciC > peakDeciC) peakDeciC = sample.tempDeciC;
+
+    if (!writer.add(sample)) {
+        // A page that fails to program is lost; the run carries on in the next one
+        if (!programPage(nullptr)) printf("RunRecorder: run %lu page lost\n", static_cast<unsigned long>(runId));
+        writer.begin(runId, sampleIndex, static_cast<uint16_t>(runPeriodMs), nullptr);
+        writer.add(sample);
+    }
+    sampleIndex++;
+}
+
+void RunRecorderService::finishRun(RunOutcome outcome) {
+    RunEnd end = {outcome, 0, peakDeciC};
+    if (!programPage(&end)) printf("RunRecorder: run %lu last page lost\n", static_cast<unsigned long>(runId));
+    recording = false;
+}
+
+bool RunRecorderService::programPage(const RunEnd* end) {
+    writer.finish(end, pageBuffer);
+
+    // Step over pages a power cut left half-written; a sector is erased as the ring enters it
+    while (writePage % PAGES_PER_SECTOR != 0 && !isErased(pageAt(writePage), RunLog::PAGE_SIZE)) {
+        writePage = (writePage + 1) % PAGE_COUNT;
+    }
+
+    // Erase and program go in one batch, so entering a sector costs a single blackout
+    uint32_t offset = RUN_LOG_FLASH_OFFSET + writePage * RunLog::PAGE_SIZE;
+    FlashService::Operation batch[2];
+    size_t count = 0;
+    if (writePage % PAGES_PER_SECTOR == 0 && !isErased(pageAt(writePage), FLASH_SECTOR_SIZE)) {
+        batch[count++] = {FlashService::Operation::Type::ERASE, offset, nullptr, FLASH_SECTOR_SIZE};
+    }
+    batch[count++] = {FlashService::Operation::Type::PROGRAM, offset, pageBuffer, RunLog::PAGE_SIZE};
+
+    const uint8_t* mapped = pageAt(writePage);
+    writePage = (writePage + 1) % PAGE_COUNT;
+    return FlashService::getInstance().execute(batch, count)
+        && memcmp(mapped, pageBuffer, RunLog::PAGE_SIZE) == 0;
+}
+
+void RunRecorderService::exportLog() {
+    TelemetryService& telemetry = TelemetryService::getInstance();
+    uint8_t payload[oven_RunLogSummary_size > oven_RunLogSample_size ? oven_RunLogSummary_size : oven_RunLogSample_size];
+
+    // Accumulated over the pages of the run being replayed
+    bool inRun = false;
+    oven_RunLogSummary summary = oven_RunLogSummary_init_zero;
+    int16_t peak = INT16_MIN;
+
+    auto sendSummary = [&]() {
+        if (!inRun) return;
+        summary.peak_temp = (peak != INT16_MIN) ? peak / 10.0f : 0.0f;
+        pb_ostream_t stream = pb_ostream_from_buffer(payload, sizeof(payload));
+        if (pb_encode(&stream, oven_RunLogSummary_fields, &summary)) {
+            telemetry.sendFrame(TelemetryService::FrameType::RUN_LOG_SUMMARY, payload, stream.bytes_written);
+        }
+        inRun = false;
+    };
+
+    // Oldest first: the ring continues after the page written last
+    RunLogPageReader reader;
+    for (uint32_t i = 0; i < PAGE_COUNT; ++i) {
+        if (ReflowEngine::getInstance().isRunning()) return;
+
+        uint32_t page = (writePage + i) % PAGE_COUNT;
+        if (!reader.open(pageAt(page))) continue;
+        const RunLog::PageHeader& header = reader.getHeader();
+
+        if (!inRun || header.runId != summary.run_id) {
+            sendSummary();
+            summary = oven_RunLogSummary_init_zero;
+            summary.run_id = header.runId;
+            peak = INT16_MIN;
+            inRun = true;
+        }
+
+        // Every page has the period, so a run whose first page was overwritten keeps its timing
+        summary.sample_period_ms = header.samplePeriodMs;
+        RunInfo info;
+        if (reader.getInfo(&info)) {
+            strncpy(summary.curve_name, info.curveName, sizeof(summary.curve_name) - 1);
+        }
+
+        oven_RunLogSample message = oven_RunLogSample_init_zero;
+        message.run_id = header.runId;
+        message.sample_index = header.firstSample;
+        RunSample sample;
+        while (reader.next(&sample)) {
+            message.time_ms = message.sample_index * summary.sample_period_ms;
+            message.target_temp = sample.setpointDeciC / 10.0f;
+            message.current_temp = sample.tempDeciC / 10.0f;
+            message.ssr_power_percent = sample.heaterPercent;
+            message.door_percent_open = sample.doorPercent;
+            if (sample.tempDeciC > peak) peak = sample.tempDeciC;
+
+            pb_ostream_t stream = pb_ostream_from_buffer(payload, sizeof(payload));
+            if (pb_encode(&stream, oven_RunLogSample_fields, &message)) {
+                telemetry.sendFrame(TelemetryService::FrameType::RUN_LOG_SAMPLE, payload, stream.bytes_written);
+            }
+            message.sample_index++;
+            summary.sample_count++;
+        }
+
+        RunEnd end;
+        if (reader.getEnd(&end)) {
+            summary.outcome = end.outcome == RunOutcome::COMPLETE
+                ? oven_RunLogSummary_Outcome_COMPLETE : oven_RunLogSummary_Outcome_ABORTED;
+            if (end.peakDeciC > peak) peak = end.peakDeciC;
+            sendSummary();
+        }
+    }
+    sendSummary();
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hardware/flash.h"
+#include "library/run_log.h"
+#include "constants.h"
+
+// Records every reflow run to a ring of flash pages at RUN_LOG_FLASH_OFFSET:
+// setpoint, oven temperature, heater power and door position once per sample
+// period. A page is programmed (through FlashService) when it fills up and
+// when the run ends, so a power cut costs at most the page in progress. When
+// the ring wraps, the oldest sector is erased and the oldest runs go with it.
+//
+// requestExport() replays the whole log over TelemetryService, oldest first,
+// as RunLogSample frames with a RunLogSummary after each run.
+class RunRecorderService {
+public:
+    static RunRecorderService& getInstance();
+
+    void init();
+
+    // Takes effect from the next run
+    void setSamplePeriod(uint32_t periodMs);
+    uint32_t getSamplePeriod() const;
+
+    // The export starts once no run is being recorded
+    void requestExport();
+
+    bool isRecording() const;
+    uint32_t getLastRunId() const;
+
+private:
+    static constexpr uint32_t PAGE_COUNT = RUN_LOG_FLASH_SIZE / RunLog::PAGE_SIZE;
+    static constexpr uint32_t PAGES_PER_SECTOR = FLASH_SECTOR_SIZE / RunLog::PAGE_SIZE;
+    static constexpr uint32_t IDLE_POLL_MS = 100;
+
+    RunRecorderService();
+    static void recorderTaskWrapper(void* pvParameters);
+    void recorderTask();
+
+    void mount();
+    const uint8_t* pageAt(uint32_t page) const;
+    void startRun();
+    void recordSample();
+    void finishRun(RunOutcome outcome);
+    bool programPage(const RunEnd* end);
+    void exportLog();
+
+    // Recorder task only
+    RunLogPageWriter writer;
+    uint8_t pageBuffer[RunLog::PAGE_SIZE];
+    uint32_t writePage;         // Next page of the ring to program
+    uint32_t runId;
+    uint32_t sampleIndex;
+    uint32_t runPeriodMs;
+    int16_t peakDeciC;
+
+    volatile uint32_t lastRunId;
+    volatile uint32_t samplePeriodMs;
+    volatile bool recording;
+    volatile bool exportRequested;
+    TaskHandle_t taskHandle;
+};
@@ -11,8 +11,16 @@ SensorService& SensorService::getInstance() {
     return instance;
 }
 
-SensorService::SensorService() : sht30(AMBIENT_TEMP_I2C_PORT, SHT30_I2C_ADDR), ssrTempSensor(SSR_TEMP_GPIO) {
+SensorService::SensorService()
+    : historyMutex(xSemaphoreCreateMutex()),
+      sht30(AMBIENT_TEMP_I2C_PORT, SHT30_I2C_ADDR),
+      ssrTempSensor(SSR_TEMP_GPIO),
+      ssrTempAddress{},
+      thermocouple(THERMOCOUPLE_SPI_PORT, THERMOCOUPLE_CS_GPIO),
+      thermocoupleTaskHandle(nullptr) {
     state = {};
+    ambientPipeline = {PipelineStage::IDLE, AMBIENT_SAMPLE_INTERVAL_MS, 0, 0};
+    ssrPipeline = {PipelineStage::IDLE, SSR_TEMP_SAMPLE_INTERVAL_MS, 0, 0};
 }
 
 void SensorService::init() {
@@ -21,53 +29,195 @@ void SensorService::init() {
     gpio_set_function(AMBIENT_TEMP_I2C_SDA_GPIO, GPIO_FUNC_I2C);
     gpio_set_function(AMBIENT_TEMP_I2C_SCL_GPIO, GPIO_FUNC_I2C);
 
+    // Init SPI for the thermocouple (mode 0, MSB first)
+    spi_init(THERMOCOUPLE_SPI_PORT, THERMOCOUPLE_SPI_BAUDRATE);
+    spi_set_format(THERMOCOUPLE_SPI_PORT, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    gpio_set_function(THERMOCOUPLE_SPI_MISO_GPIO, GPIO_FUNC_SPI);
+    gpio_set_function(THERMOCOUPLE_SPI_CLK_GPIO, GPIO_FUNC_SPI);
+
     // Init SPI chip selects
     gpio_init(THERMOCOUPLE_CS_GPIO);
     gpio_set_dir(THERMOCOUPLE_CS_GPIO, GPIO_OUT);
     gpio_put(THERMOCOUPLE_CS_GPIO, 1);
 
     sht30.init();
+    ssrTempSensor.init();
+    ssrTempSensor.single_device_read_rom(ssrTempAddress);
+
+    xTaskCreate([](void* arg) {
+        static_cast<SensorService*>(arg)->thermocoupleTask();
+    }, "Thermocouple", 512, this, 2, &thermocoupleTaskHandle);
 
     xTaskCreate([](void* arg) {
         static_cast<SensorService*>(arg)->sensorTask();
     }, "SensorTask", 1024, this, 1, nullptr);
+
+    // Timer and DMA IRQs are serviced on the calling (control) core
+    thermocouple.setNotifyTask(thermocoupleTaskHandle);
+    thermocouple.init(THERMOCOUPLE_SAMPLE_RATE_HZ);
 }
 
-void SensorService::sensorTask() {
+void SensorService::thermocoupleTask() {
     while (true) {
-        SensorState newState = {};
-        uint8_t data[4];
+        // Woken by the DMA completion IRQ for every frame
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(THERMOCOUPLE_TIMEOUT_MS)) == 0) {
+            updateState([](SensorState& s) {
+                s.hasError = true;
+                s.lastError = SensorError::THERMOCOUPLE_TIMEOUT;
+            });
+            continue;
+        }
 
-        // Read thermocouple
-        gpio_put(THERMOCOUPLE_CS_GPIO, 0);
-        spi_read_blocking(THERMOCOUPLE_SPI_PORT, 0, data, 4);
-        gpio_put(THERMOCOUPLE_CS_GPIO, 1);
+        ThermocoupleFrame frame;
+        if (!thermocouple.readLatest(frame)) {
+            continue;
+        }
 
-        if (data[3] & 0x07) {
-            newState.hasError = true;
-            newState.lastError = "Thermocouple error";
+        SensorError fault = ThermocoupleSampler::decodeFault(frame.raw);
+        if (fault != SensorError::NONE) {
+            updateState([fault](SensorState& s) {
+                s.hasError = true;
+                s.lastError = fault;
+            });
         } else {
-            uint16_t raw = (data[0] << 8) | data[1];
-            raw >>= 2;
-            newState.currentTemp = raw * 0.25f;
+            float temp = ThermocoupleSampler::toCelsius(frame.raw);
+            uint32_t timestamp = frame.timestampUs / 1000;
+            updateState([temp, timestamp](SensorState& s) {
+                s.currentTemp = temp;
+                s.currentTempTimestamp = timestamp;
+                s.hasError = false;
+                s.lastError = SensorError::NONE;
+            });
+            recordTemperature({temp, timestamp});
+        }
+    }
+}
+
+void SensorService::recordTemperature(const TempReading& reading) {
+    xSemaphoreTake(historyMutex, portMAX_DELAY);
+    history.push(reading);
+    for (size_t i = 0; i < TempHistory::MAX_WINDOWS; ++i) {
+        TempWindowStats stats;
+        history.getStats(static_cast<TempWindow>(i), stats);
+        windowStats[i].write(stats);
+    }
+    xSemaphoreGive(historyMutex);
+}
+
+TempWindowStats SensorService::getTemperatureStats(TempWindow window) const {
+    return windowStats[static_cast<size_t>(window)].read();
+}
+
+void SensorService::setTemperatureWindow(TempWindow window, uint32_t windowMs) {
+    xSemaphoreTake(historyMutex, portMAX_DELAY);
+    history.setWindow(window, windowMs);
+    TempWindowStats stats;
+    history.getStats(window, stats);
+    windowStats[static_cast<size_t>(window)].write(stats);
+    xSemaphoreGive(historyMutex);
+}
+
+size_t SensorService::copyTemperatureHistory(TempReading* out, size_t maxCount) const {
+    xSemaphoreTake(historyMutex, portMAX_DELAY);
+    size_t count = history.copyRecent(out, maxCount);
+    xSemaphoreGive(historyMutex);
+    return count;
+}
+
+void SensorService::sensorTask() {
+    while (true) {
+        uint32_t now = to_ms_since_boot(get_absolute_time());
+        stepAmbientPipeline(now);
+        stepSsrPipeline(now);
+
+        // Sleep until whichever pipeline needs attention next
+        uint32_t nextMs = ambientPipeline.nextActionMs;
+        if (static_cast<int32_t>(ssrPipeline.nextActionMs - nextMs) < 0) {
+            nextMs = ssrPipeline.nextActionMs;
         }
+        now = to_ms_since_boot(get_absolute_time());
+        int32_t waitMs = static_cast<int32_t>(nextMs - now);
+        vTaskDelay(pdMS_TO_TICKS(waitMs > 0 ? waitMs : 1));
+    }
+}
+
+void SensorService::stepAmbientPipeline(uint32_t nowMs) {
+    if (static_cast<int32_t>(nowMs - ambientPipeline.nextActionMs) < 0) return;
 
-        float temp, humidity;
-        if (sht30.readAll(&temp, &humidity)) {
-            newState.ambientTemp = temp;
-            newState.ambientHumidity = humidity;
+    if (ambientPipeline.stage == PipelineStage::IDLE) {
+        ambientPipeline.startedAtMs = nowMs;
+        if (sht30.startMeasurement()) {
+            ambientPipeline.stage = PipelineStage::CONVERTING;
+            ambientPipeline.nextActionMs = nowMs + SHT30::MEASUREMENT_TIME_MS;
+        } else {
+            completePipeline(ambientPipeline, nowMs);
         }
+        return;
+    }
+
+    float temp, humidity;
+    if (sht30.readMeasurement(&temp, &humidity)) {
+        updateState([temp, humidity](SensorState& s) {
+            s.ambientTemp = temp;
+            s.ambientHumidity = humidity;
+        });
+    }
+    completePipeline(ambientPipeline, nowMs);
+}
+
+void SensorService::stepSsrPipeline(uint32_t nowMs) {
+    if (static_cast<int32_t>(nowMs - ssrPipeline.nextActionMs) < 0) return;
+
+    if (ssrPipeline.stage == PipelineStage::IDLE) {
+        ssrPipeline.startedAtMs = nowMs;
+        // wait=false returns the conversion time for this device's resolution
+        int conversionMs = ssrTempSensor.convert_temperature(ssrTempAddress, false, false);
+        ssrPipeline.stage = PipelineStage::CONVERTING;
+        ssrPipeline.nextActionMs = nowMs + (conversionMs > 0 ? conversionMs : 0);
+        return;
+    }
 
-        rom_address_t address{};
-        ssrTempSensor.single_device_read_rom(address);
-        ssrTempSensor.convert_temperature(address, true, false);
-        newState.ssrTemp = ssrTempSensor.temperature(address);
+    float temp = ssrTempSensor.temperature(ssrTempAddress);
+    if (temp != One_wire::invalid_conversion) {
+        updateState([temp](SensorState& s) { s.ssrTemp = temp; });
+    }
+    completePipeline(ssrPipeline, nowMs);
+}
 
-        state = newState;
-        vTaskDelay(pdMS_TO_TICKS(500));
+void SensorService::completePipeline(SensorPipeline& pipeline, uint32_t nowMs) {
+    pipeline.stage = PipelineStage::IDLE;
+    pipeline.nextActionMs = pipeline.startedAtMs + pipeline.intervalMs;
+    // Never schedule in the past if a conversion overran its slot
+    if (static_cast<int32_t>(pipeline.nextActionMs - nowMs) < 0) {
+        pipeline.nextActionMs = nowMs;
     }
 }
 
-const SensorState& SensorService::getState() const {
-    return state;
+void SensorService::setAmbientSampleInterval(uint32_t intervalMs) {
+    ambientPipeline.intervalMs = intervalMs;
+}
+
+void SensorService::setSsrSampleInterval(uint32_t intervalMs) {
+    ssrPipeline.intervalMs = intervalMs;
+}
+
+void SensorService::thermocoupleDmaISR() {
+    thermocouple.handleDmaIrq();
+}
+
+void SensorService::setThermocoupleSampleRate(uint32_t sampleRateHz) {
+    thermocouple.setSampleRate(sampleRateHz);
+}
+
+uint32_t SensorService::getThermocoupleSampleRate() const {
+    return thermocouple.getSampleRate();
+}
+
+TempReading SensorService::getLatestThermocoupleReading() const {
+    SensorState current = snapshot.read();
+    return {current.currentTemp, current.currentTempTimestamp};
+}
+
+SensorState SensorService::getState() const {
+    return snapshot.read();
 }
@@ -1,23 +1,85 @@
 #pragma once
 
 #include "library/sht30.h"
+#include "library/thermocouple_sampler.h"
+#include "library/seq_lock.h"
+#include "library/temp_history.h"
 #include "one_wire.h"
 #include "types/sensors.h"
+#include "types/temp_reading.h"
 #include "pico/types.h"
-#include <string>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
 
 class SensorService {
 public:
     static SensorService& getInstance();
 
     void init();
-    const SensorState& getState() const;
+    // Consistent copy of the latest readings, safe from either core
+    SensorState getState() const;
+    TempReading getLatestThermocoupleReading() const;
+
+    // Thermocouple history: O(1) windowed statistics and raw samples for charts
+    TempWindowStats getTemperatureStats(TempWindow window) const;
+    void setTemperatureWindow(TempWindow window, uint32_t windowMs);
+    size_t copyTemperatureHistory(TempReading* out, size_t maxCount) const;
+
+    // Per-sensor update rates
+    void setThermocoupleSampleRate(uint32_t sampleRateHz);
+    uint32_t getThermocoupleSampleRate() const;
+    void setAmbientSampleInterval(uint32_t intervalMs);
+    void setSsrSampleInterval(uint32_t intervalMs);
+
+    // Called from the shared DMA IRQ dispatcher
+    void thermocoupleDmaISR();
 
 private:
     SensorService();
     void sensorTask();
+    void thermocoupleTask();
+    void recordTemperature(const TempReading& reading);
+
+    // Each slow sensor is a two-stage state machine: start a conversion, then
+    // come back once it is due and collect the result. Nothing ever sleeps.
+    enum class PipelineStage {
+        IDLE,
+        CONVERTING
+    };
+
+    struct SensorPipeline {
+        PipelineStage stage;
+        uint32_t intervalMs;
+        uint32_t startedAtMs;
+        uint32_t nextActionMs;
+    };
+
+    void stepAmbientPipeline(uint32_t nowMs);
+    void stepSsrPipeline(uint32_t nowMs);
+    static void completePipeline(SensorPipeline& pipeline, uint32_t nowMs);
+
+    // Writers mutate the working copy inside a critical section and republish it
+    template <typename Mutator>
+    void updateState(Mutator mutate) {
+        taskENTER_CRITICAL();
+        mutate(state);
+        snapshot.write(state);
+        taskEXIT_CRITICAL();
+    }
 
     SensorState state;
+    SeqLock<SensorState> snapshot;
+
+    TempHistory history;
+    SemaphoreHandle_t historyMutex;
+    SeqLock<TempWindowStats> windowStats[TempHistory::MAX_WINDOWS];
     SHT30 sht30;
     One_wire ssrTempSensor;
+    rom_address_t ssrTempAddress;
+    ThermocoupleSampler thermocouple;
+    TaskHandle_t thermocoupleTaskHandle;
+
+    SensorPipeline ambientPipeline;
+    SensorPipeline ssrPipeline;
 };
@@ -0,0 +1,43 @@
+#include "services/settings_service.h"
+#include "services/flash_service.h"
+#include "hardware/flash.h"
+#include <stdio.h>
+
+SettingsService& SettingsService::getInstance() {
+    static SettingsService instance;
+    return instance;
+}
+
+SettingsService::SettingsService()
+    : store(reinterpret_cast<const uint8_t*>(XIP_BASE + SETTINGS_FLASH_OFFSET), SETTINGS_FLASH_OFFSET,
+            SETTINGS_FLASH_SECTORS, SETTINGS_MAGIC, {executeFlash, nullptr}),
+      mutex(xSemaphoreCreateMutex()) {
+    static_assert(FlashKvStore::SECTOR_SIZE == FLASH_SECTOR_SIZE, "settings store sector size");
+    static_assert(FlashKvStore::PAGE_SIZE == FLASH_PAGE_SIZE, "settings store page size");
+    store.mount();
+}
+
+bool SettingsService::load(SettingsKey key, void* value, size_t length) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    bool found = store.read(static_cast<uint16_t>(key), value, length);
+    xSemaphoreGive(mutex);
+    return found;
+}
+
+bool SettingsService::save(SettingsKey key, const void* value, size_t length) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    bool saved = store.write(static_cast<uint16_t>(key), value, length);
+    xSemaphoreGive(mutex);
+    if (!saved) printf("Settings: saving key %u failed\n", static_cast<unsigned>(key));
+    return saved;
+}
+
+bool SettingsService::executeFlash(const FlashKvStore::FlashOp* operations, size_t count, void*) {
+    FlashService::Operation batch[FlashKvStore::MAX_BATCH_ERASES + 1];
+    if (count > sizeof(batch) / sizeof(batch[0])) return false;
+    for (size_t i = 0; i < count; ++i) {
+        batch[i] = {operations[i].erase ? FlashService::Operation::Type::ERASE : FlashService::Operation::Type::PROGRAM,
+                    operations[i].offset, operations[i].data, operations[i].length};
+    }
+    return FlashService::getInstance().execute(batch, count);
+}
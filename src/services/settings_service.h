@@ -0,0 +1,33 @@
+#pragma once
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "library/flash_kv_store.h"
+#include "constants.h"
+
+// Keys of the persistent settings. Values are stored as raw structs, so a
+// struct whose layout changes needs a new key (old records then just age out).
+enum class SettingsKey : uint16_t {
+    CALIBRATION = 1     // CalibrationData
+};
+
+// Persistent settings in the FlashKvStore at SETTINGS_FLASH_OFFSET. A save is
+// one append of a CRC-protected record; the previous value stays valid until
+// the new one is completely written, so a power cut loses at most the save in
+// progress. Safe to call from any task but the control task, which runs the
+// flash writes (see FlashService).
+class SettingsService {
+public:
+    static SettingsService& getInstance();
+
+    // False if the key was never saved or was saved with a different size
+    bool load(SettingsKey key, void* value, size_t length);
+    bool save(SettingsKey key, const void* value, size_t length);
+
+private:
+    SettingsService();
+    static bool executeFlash(const FlashKvStore::FlashOp* operations, size_t count, void* context);
+
+    FlashKvStore store;
+    SemaphoreHandle_t mutex;
+};
@@ -0,0 +1,253 @@
+#include "services/telemetry_service.h"
+#include "services/sensor_service.h"
+#include "services/temperature_control_service.h"
+#include "services/reflow_engine.h"
+#include "services/door_service.h"
+#include "services/electronics_cooling_service.h"
+#include "services/diagnostics_service.h"
+#include "services/profile_service.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "pb_encode.h"
+#include <string.h>
+
+TelemetryService& TelemetryService::getInstance() {
+    static TelemetryService instance;
+    return instance;
+}
+
+TelemetryService::TelemetryService()
+    : nextBuffer(0),
+      sequence(0),
+      dmaChannel(-1),
+      txMutex(nullptr),
+      rxDecoder(rxFrame, sizeof(rxFrame)),
+      rateHz(TELEMETRY_RATE_HZ),
+      framesSent(0),
+      framesDropped(0),
+      framesReceived(0),
+      taskHandle(nullptr),
+      rxTaskHandle(nullptr) {
+    stageName[0] = '\0';
+}
+
+void TelemetryService::init() {
+    // stdio already owns the pins and the UART; only the line rate changes
+    uart_set_baudrate(TELEMETRY_UART, TELEMETRY_BAUDRATE);
+
+    dmaChannel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(dmaChannel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, uart_get_dreq(TELEMETRY_UART, true));
+    dma_channel_configure(dmaChannel, &config, &uart_get_hw(TELEMETRY_UART)->dr, nullptr, 0, false);
+
+    txMutex = xSemaphoreCreateMutex();
+    xTaskCreate(telemetryTaskWrapper, "Telemetry", 1024, this, 1, &taskHandle);
+
+    // The task exists before the interrupt can notify it
+    xTaskCreate(rxTaskWrapper, "TelemetryRx", 1024, this, 1, &rxTaskHandle);
+    irq_set_exclusive_handler(UART_IRQ_NUM(TELEMETRY_UART), uartRxISR);
+    uart_set_irqs_enabled(TELEMETRY_UART, true, false);
+    irq_set_enabled(UART_IRQ_NUM(TELEMETRY_UART), true);
+}
+
+void TelemetryService::setRate(uint32_t hz) {
+    bool resume = (rateHz == 0 && hz > 0);
+    rateHz = hz;
+    if (resume && taskHandle) xTaskNotifyGive(taskHandle);
+}
+
+uint32_t TelemetryService::getRate() const {
+    return rateHz;
+}
+
+uint32_t TelemetryService::getFramesSent() const {
+    return framesSent;
+}
+
+uint32_t TelemetryService::getFramesDropped() const {
+    return framesDropped;
+}
+
+uint32_t TelemetryService::getFramesReceived() const {
+    return framesReceived;
+}
+
+uint32_t TelemetryService::getReceiveErrors() const {
+    return rxDecoder.getErrorCount();
+}
+
+bool TelemetryService::sendFrame(FrameType type, const uint8_t* data, size_t length) {
+    if (dmaChannel < 0 || length > MAX_PAYLOAD) return false;
+
+    xSemaphoreTake(txMutex, portMAX_DELAY);
+
+    // The other buffer may still be on the wire; this one finished before it started
+    uint8_t* frame = txBuffers[nextBuffer];
+    size_t frameLength = FrameEncoder::encode(static_cast<uint8_t>(type), sequence++, data, length,
+                                              frame, sizeof(txBuffers[0]));
+
+    TickType_t start = xTaskGetTickCount();
+    while (dma_channel_is_busy(dmaChannel)) {
+        if (xTaskGetTickCount() - start >= pdMS_TO_TICKS(TELEMETRY_TX_TIMEOUT_MS)) {
+            framesDropped++;
+            xSemaphoreGive(txMutex);
+            return false;
+        }
+        vTaskDelay(1);
+    }
+
+    dma_channel_transfer_from_buffer_now(dmaChannel, frame, frameLength);
+    nextBuffer ^= 1;
+    framesSent++;
+
+    xSemaphoreGive(txMutex);
+    return true;
+}
+
+void TelemetryService::telemetryTaskWrapper(void* pvParameters) {
+    static_cast<TelemetryService*>(pvParameters)->telemetryTask();
+}
+
+void TelemetryService::telemetryTask() {
+    TickType_t lastWakeTime = xTaskGetTickCount();
+    uint32_t diagnosticsSequence = DiagnosticsService::getInstance().getSequence();
+
+    while (true) {
+        uint32_t hz = rateHz;
+        if (hz == 0) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            lastWakeTime = xTaskGetTickCount();
+            continue;
+        }
+
+        TickType_t period = pdMS_TO_TICKS(1000 / hz);
+        vTaskDelayUntil(&lastWakeTime, period ? period : 1);
+
+        pb_ostream_t stream = pb_ostream_from_buffer(payload, sizeof(payload));
+        if (encodeStatus(&stream)) {
+            sendFrame(FrameType::SYSTEM_STATUS, payload, stream.bytes_written);
+        }
+
+        uint32_t published = DiagnosticsService::getInstance().getSequence();
+        if (published != diagnosticsSequence) {
+            diagnosticsSequence = published;
+            stream = pb_ostream_from_buffer(payload, sizeof(payload));
+            if (DiagnosticsService::getInstance().encode(&stream)) {
+                sendFrame(FrameType::DIAGNOSTICS, payload, stream.bytes_written);
+            }
+        }
+    }
+}
+
+void TelemetryService::uartRxISR() {
+    TelemetryService& instance = getInstance();
+
+    // Bytes that do not fit are dropped; the frame they belong to then fails its CRC
+    bool delimiter = false;
+    while (uart_is_readable(TELEMETRY_UART)) {
+        uint8_t value = static_cast<uint8_t>(uart_get_hw(TELEMETRY_UART)->dr);
+        instance.rxBytes.push(value);
+        if (value == 0) delimiter = true;
+    }
+
+    // Only a delimiter can complete a frame
+    if (delimiter && instance.rxTaskHandle) {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(instance.rxTaskHandle, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+}
+
+void TelemetryService::rxTaskWrapper(void* pvParameters) {
+    static_cast<TelemetryService*>(pvParameters)->rxTask();
+}
+
+void TelemetryService::rxTask() {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        uint8_t value;
+        while (rxBytes.pop(value)) {
+            if (rxDecoder.push(value)) handleFrame();
+        }
+    }
+}
+
+void TelemetryService::handleFrame() {
+    framesReceived++;
+
+    switch (static_cast<FrameType>(rxDecoder.getType())) {
+        case FrameType::PROFILE_UPLOAD: {
+            oven_ProfileUploadResult result = ProfileService::getInstance().upload(
+                rxDecoder.getPayload(), rxDecoder.getPayloadLength());
+            pb_ostream_t stream = pb_ostream_from_buffer(rxReply, sizeof(rxReply));
+            if (pb_encode(&stream, oven_ProfileUploadResult_fields, &result)) {
+                sendFrame(FrameType::PROFILE_UPLOAD_RESULT, rxReply, stream.bytes_written);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+bool TelemetryService::encodeStatus(pb_ostream_t* stream) {
+    SensorState sensors = SensorService::getInstance().getState();
+    TemperatureControlService& control = TemperatureControlService::getInstance();
+    TemperatureState temperature = control.getState();
+    ReflowEngine& engine = ReflowEngine::getInstance();
+    ReflowProgress progress = engine.getProgress();
+    DoorService& door = DoorService::getInstance();
+
+    oven_SystemStatus message = oven_SystemStatus_init_zero;
+    message.current_temp = sensors.currentTemp;
+    message.ambient_temp = sensors.ambientTemp;
+    message.target_temp = temperature.targetTemp;
+    message.ssr_temp = sensors.ssrTemp;
+
+    message.reflow_active = (progress.runState == ReflowRunState::RUNNING);
+    message.door_open = !door.isFullyClosed();
+    message.servo_powered = door.isServoEnabled();
+
+    message.time_elapsed_ms = static_cast<int32_t>(progress.elapsedMs);
+    message.time_remaining_ms = progress.totalMs > progress.elapsedMs
+        ? static_cast<int32_t>(progress.totalMs - progress.elapsedMs) : 0;
+
+    message.ssr_power_percent = control.getHeaterPower();
+    message.fan_speed_percent = ElectronicsCoolingService::getInstance().getFanSpeed();
+
+    switch (progress.runState) {
+        case ReflowRunState::RUNNING: {
+            // The engine only replaces its curve on start(), which needs the run to have ended
+            const ReflowCurve& curve = engine.getCurve();
+            const char* label = progress.stepIndex < curve.stepCount
+                ? getStepLabelName(curve.steps[progress.stepIndex].label) : "";
+            strncpy(stageName, label, sizeof(stageName) - 1);
+            stageName[sizeof(stageName) - 1] = '\0';
+            break;
+        }
+        case ReflowRunState::COMPLETE: strcpy(stageName, "Complete"); break;
+        case ReflowRunState::ABORTED: strcpy(stageName, "Aborted"); break;
+        default: strcpy(stageName, "Idle"); break;
+    }
+    message.current_stage.funcs.encode = encodeStageName;
+    message.current_stage.arg = stageName;
+
+    message.door_percent_open = door.getPosition();
+    message.door_fully_open = door.isFullyOpen();
+    message.door_fully_closed = door.isFullyClosed();
+
+    // A sensor fault cuts the heater; there is no ShutdownReason for it yet
+    message.emergency_shutdown = temperature.hasError;
+
+    return pb_encode(stream, oven_SystemStatus_fields, &message);
+}
+
+bool TelemetryService::encodeStageName(pb_ostream_t* stream, const pb_field_t* field, void* const* arg) {
+    const char* name = static_cast<const char*>(*arg);
+    if (!pb_encode_tag_for_field(stream, field)) return false;
+    return pb_encode_string(stream, reinterpret_cast<const pb_byte_t*>(name), strlen(name));
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "hardware/uart.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "pb.h"
+#include "library/frame_encoder.h"
+#include "library/ring_buffer.h"
+#include "library/message.pb.h"
+#include "constants.h"
+
+// Binary live feed on TELEMETRY_UART. Every TELEMETRY_RATE_HZ tick a
+// SystemStatus message is encoded with nanopb, framed by FrameEncoder
+// (sequence number, CRC, COBS) and handed to DMA, so the CPU cost per frame
+// is the encode alone. A Diagnostics frame follows whenever
+// DiagnosticsService publishes a new snapshot.
+//
+// The UART is shared with stdio. Text never contains 0x00, so a receiver
+// skips it while hunting for frame delimiters; a frame that a printf lands in
+// the middle of fails its CRC and shows up as a sequence gap.
+//
+// The host talks back in the same framing. The RX interrupt only copies
+// bytes into a ring; a task decodes them and answers each ProfileUpload (a
+// ReflowCurve, see ProfileService) with a ProfileUploadResult. Storing a
+// profile can wait for a flash erase, so the host sends one upload at a time
+// and waits for its result.
+class TelemetryService {
+public:
+    enum class FrameType : uint8_t {
+        SYSTEM_STATUS = 1,
+        DIAGNOSTICS = 2,
+        RUN_LOG_SAMPLE = 3,
+        RUN_LOG_SUMMARY = 4,
+        PROFILE_UPLOAD_RESULT = 5,
+
+        // Host to oven
+        PROFILE_UPLOAD = 16
+    };
+
+    static TelemetryService& getInstance();
+
+    void init();
+
+    // Frames per second of SystemStatus; 0 stops the periodic feed
+    void setRate(uint32_t hz);
+    uint32_t getRate() const;
+
+    // Frames one already encoded message and starts its DMA transfer. Safe from
+    // any task. Returns false (and the frame is dropped, its sequence number
+    // skipped) if the previous frame is still on the wire after
+    // TELEMETRY_TX_TIMEOUT_MS.
+    bool sendFrame(FrameType type, const uint8_t* payload, size_t length);
+
+    uint32_t getFramesSent() const;
+    uint32_t getFramesDropped() const;
+    uint32_t getFramesReceived() const;
+    // Frames that failed their CRC or overran a buffer
+    uint32_t getReceiveErrors() const;
+
+private:
+    static constexpr size_t MAX_PAYLOAD = OVEN_MESSAGE_PB_H_MAX_SIZE;
+    static constexpr size_t MAX_FRAME = FrameEncoder::maxEncodedSize(MAX_PAYLOAD);
+    static constexpr size_t STAGE_NAME_MAX = 24;
+    static constexpr size_t MAX_RX_PAYLOAD = 256;
+
+    TelemetryService();
+    static void telemetryTaskWrapper(void* pvParameters);
+    void telemetryTask();
+    bool encodeStatus(pb_ostream_t* stream);
+    static bool encodeStageName(pb_ostream_t* stream, const pb_field_t* field, void* const* arg);
+    static void uartRxISR();
+    static void rxTaskWrapper(void* pvParameters);
+    void rxTask();
+    void handleFrame();
+
+    // Telemetry task only
+    uint8_t payload[MAX_PAYLOAD];
+    char stageName[STAGE_NAME_MAX];
+
+    // Guarded by txMutex; one buffer is on the wire while the next is encoded
+    uint8_t txBuffers[2][MAX_FRAME];
+    uint8_t nextBuffer;
+    uint16_t sequence;
+    int dmaChannel;
+    SemaphoreHandle_t txMutex;
+
+    // RX task only
+    uint8_t rxFrame[MAX_RX_PAYLOAD + FrameEncoder::HEADER_SIZE + FrameEncoder::CRC_SIZE];
+    FrameDecoder rxDecoder;
+    uint8_t rxReply[oven_ProfileUploadResult_size];
+
+    // Filled by the RX interrupt, drained by the RX task
+    RingBuffer<uint8_t, TELEMETRY_RX_BUFFER_SIZE> rxBytes;
+
+    volatile uint32_t rateHz;
+    volatile uint32_t framesSent;
+    volatile uint32_t framesDropped;
+    volatile uint32_t framesReceived;
+    TaskHandle_t taskHandle;
+    TaskHandle_t rxTaskHandle;
+};
@@ -5,7 +5,9 @@
 #include "hardware/clocks.h"
 #include "servo.pio.h"
 #include "services/sensor_service.h"
-#include <algorithm>
+#include "services/calibration_service.h"
+#include "services/reflow_engine.h"
+#include "services/flash_service.h"
 
 TemperatureControlService& TemperatureControlService::getInstance() {
     static TemperatureControlService instance;
@@ -13,22 +15,32 @@ TemperatureControlService& TemperatureControlService::getInstance() {
 }
 
 TemperatureControlService::TemperatureControlService()
-    : targetTemp(0.0f), currentTemp(0.0f),
-      heaterPower(0), coolingPower(0),
-      lastCoolingChangeTime(0),
+    : targetTemp(0.0f), targetRampRate(0.0f), currentTemp(0.0f),
+      heater(pio0, HEATER_SSR_GPIO),
+      controlLoop({applyHeaterPower, applyDoorPosition, this}),
+      pendingGains{REFLOW_PID_PROPORTIONAL_GAIN, REFLOW_PID_INTEGRAL_GAIN, REFLOW_PID_DERIVATIVE_GAIN},
+      gainsPending(false),
+      stopPending(false),
+      modelCalibrationTime(0),
+      loopTracer(HEATER_CONTROL_PERIOD_MS * 1000u),
+      overrunAction(CONTROL_OVERRUN_ACTION),
+      halted(false),
       taskHandle(nullptr) {
     state = {};
 }
 
 void TemperatureControlService::init() {
-    // Initialize heaters
-    gpio_init(HEATER_SSR_GPIO);
-    gpio_set_dir(HEATER_SSR_GPIO, GPIO_OUT);
-    gpio_put(HEATER_SSR_GPIO, 0);
+    // Initialize heaters - the SSR is driven by a PIO state machine and starts off
+    heater.init(HEATER_SSR_WINDOW_MS, HEATER_SSR_RESOLUTION, MAINS_FREQUENCY_HZ);
+    if (HEATER_SSR_BURST_FIRE) {
+        heater.setMode(SsrDriver::Mode::BURST);
+    }
 
     // Initialize to closed position
     setDoorPosition(0);
 
+    loopTracer.setOverrunHandler(onOverrun, this);
+
     xTaskCreate(controlTaskWrapper, "TempCtrl", 1024, this, 1, &taskHandle);
 }
 
@@ -39,67 +51,132 @@ void TemperatureControlService::controlTaskWrapper(void* pvParameters) {
 void TemperatureControlService::controlTask() {
     TickType_t lastWakeTime = xTaskGetTickCount();
     const TickType_t period = pdMS_TO_TICKS(HEATER_CONTROL_PERIOD_MS);
+    FlashService& flash = FlashService::getInstance();
+    flash.attachControlLoop();
 
     while (true) {
-        const SensorState& sensorState = SensorService::getInstance().getState();
+        loopTracer.begin(time_us_64());
+
+        SensorState sensorState = SensorService::getInstance().getState();
         currentTemp = sensorState.currentTemp;
+        state.currentTemp = currentTemp;
+        state.hasError = sensorState.hasError;
+        state.lastError = sensorState.hasError ? sensorErrorToString(sensorState.lastError) : nullptr;
 
-        updateHeaterControl();
-        updateCoolingControl();
+        updateControl();
+        loopTracer.end(time_us_64());
+        loopTraceSnapshot.write(loopTracer.getTrace());
+
+        // Flash writes go in the part of the period the loop would sleep through anyway
+        flash.runWindow(loopTracer.slackUs(time_us_64()), heater);
 
         vTaskDelayUntil(&lastWakeTime, period);
     }
 }
 
-void TemperatureControlService::updateHeaterControl() {
-    if (state.hasError || targetTemp == 0.0f) {
-        setHeaterPower(0);
-        return;
+void TemperatureControlService::onOverrun(const LoopTracer::Overrun& overrun, void* context) {
+    auto* service = static_cast<TemperatureControlService*>(context);
+    ControlOverrunAction action = service->overrunAction;
+
+    if (overrun.consecutive < CONTROL_OVERRUN_LIMIT) return;
+
+    if (action == ControlOverrunAction::STOP_HEATING) {
+        // The heater keeps the last power for as long as the loop is stuck; stop the run
+        // instead. The stop takes effect at the start of the next iteration
+        ReflowEngine::getInstance().abort();
+        service->stopHeating();
+    } else if (action == ControlOverrunAction::HALT) {
+        // Leave the SSR off and the door open. Both go straight to the hardware, past
+        // the door rate limit, and the PIO state machines hold them while this core
+        // sits in panic(). The latch keeps any path that could still run from turning
+        // them back on. Not an assert: NDEBUG builds would compile it out.
+        service->halted = true;
+        service->heater.off();
+        service->setDoorPosition(100);
+        panic("TempCtrl: control loop overran %lu periods in a row",
+              static_cast<unsigned long>(overrun.consecutive));
     }
+}
 
-    float error = targetTemp - currentTemp;
-    float power = error * TEMPERATURE_CONTROL_KP;
-    power = std::clamp(power, 0.0f, 100.0f);
-    setHeaterPower(static_cast<uint8_t>(power));
+LoopTrace TemperatureControlService::getLoopTrace() const {
+    return loopTraceSnapshot.read();
+}
 
-    state.isHeating = (power > 0);
+void TemperatureControlService::setOverrunAction(ControlOverrunAction action) {
+    overrunAction = action;
 }
 
-void TemperatureControlService::updateCoolingControl() {
-    if (state.hasError || targetTemp == 0.0f) {
-        setCoolingPower(0);
-        return;
-    }
+void TemperatureControlService::refreshCalibration() {
+    // Reload the model whenever a calibration run has produced new tables
+    const CalibrationService& calibration = CalibrationService::getInstance();
+    if (!calibration.isCalibrated()) return;
 
-    float error = currentTemp - targetTemp;
+    const CalibrationData& data = calibration.getCalibrationData();
+    OvenController& controller = controlLoop.getController();
+    if (data.lastCalibrationTime != modelCalibrationTime || !controller.hasModel()) {
+        controller.setCalibration(data.thermalSummary);
+        modelCalibrationTime = data.lastCalibrationTime;
+    }
+}
 
-    if (error <= 0.0f) {
-        setCoolingPower(0);
+void TemperatureControlService::updateControl() {
+    if (halted) {
+        heater.off();
+        setDoorPosition(100);
         return;
     }
 
-    uint8_t power = static_cast<uint8_t>((error / 50.0f) * 100.0f);
-    power = std::clamp<uint8_t>(power, 0, 100);
-    setCoolingPower(power);
+    // Gains, targets and stops requested by other tasks are applied here so the controller is only touched by this task
+    taskENTER_CRITICAL();
+    bool applyGains = gainsPending;
+    PidController::Gains gains = pendingGains;
+    gainsPending = false;
+    bool stop = stopPending;
+    stopPending = false;
+    float target = targetTemp;
+    float rampRate = targetRampRate;
+    taskEXIT_CRITICAL();
+    if (applyGains) {
+        controlLoop.getController().setGains(gains.kp, gains.ki, gains.kd);
+    }
+    if (stop) {
+        controlLoop.stopHeating(to_ms_since_boot(get_absolute_time()));
+    }
+    refreshCalibration();
+
+    // Derivative on measurement from the least-squares slope of the last second of samples
+    TempWindowStats derivativeStats = SensorService::getInstance().getTemperatureStats(TempWindow::DERIVATIVE);
+
+    OvenControlLoop::Measurement measurement;
+    measurement.temperature = currentTemp;
+    measurement.temperatureRate = derivativeStats.slope;
+    measurement.hasRate = derivativeStats.count > 1;
+    measurement.sensorFault = state.hasError;
+    controlLoop.update(to_ms_since_boot(get_absolute_time()), target, rampRate, measurement);
+    state.isHeating = (controlLoop.getHeaterPower() > 0);
 }
 
 void TemperatureControlService::setHeaterPower(uint8_t power) {
-    heaterPower = power;
-    state.output = static_cast<float>(power);
-    gpio_put(HEATER_SSR_GPIO, (power > 50));
+    if (halted) return;
+    controlLoop.setHeaterPower(power);
 }
 
 void TemperatureControlService::setCoolingPower(uint8_t power) {
-    uint32_t now = to_ms_since_boot(get_absolute_time());
-    if ((now - lastCoolingChangeTime) < MIN_COOLING_CHANGE_INTERVAL) return;
+    if (halted) return;
+    controlLoop.setCoolingPower(to_ms_since_boot(get_absolute_time()), power);
+}
 
-    power = std::clamp<uint8_t>(power, 0, 100);
-    coolingPower = power;
-    state.coolingPower = power;
-    state.isCooling = (power > 0);
-    lastCoolingChangeTime = now;
+void TemperatureControlService::applyHeaterPower(uint8_t percent, void* context) {
+    auto* service = static_cast<TemperatureControlService*>(context);
+    service->state.output = static_cast<float>(percent);
+    service->heater.setPower(static_cast<float>(percent));
+}
 
-    setDoorPosition(power);
+void TemperatureControlService::applyDoorPosition(uint8_t percent, void* context) {
+    auto* service = static_cast<TemperatureControlService*>(context);
+    service->state.coolingPower = percent;
+    service->state.isCooling = (percent > 0);
+    service->setDoorPosition(percent);
 }
 
 void TemperatureControlService::setDoorPosition(uint8_t percent) {
@@ -114,22 +191,48 @@ bool TemperatureControlService::isDoorFullyClosed() const {
     return DoorService::getInstance().isFullyClosed();
 }
 
-void TemperatureControlService::setTargetTemperature(float temp) {
+void TemperatureControlService::setTargetTemperature(float temp, float rampRate) {
+    taskENTER_CRITICAL();
     targetTemp = temp;
+    targetRampRate = rampRate;
+    taskEXIT_CRITICAL();
+    state.targetTemp = temp;
+}
+
+void TemperatureControlService::setPidGains(float kp, float ki, float kd) {
+    taskENTER_CRITICAL();
+    pendingGains = {kp, ki, kd};
+    gainsPending = true;
+    taskEXIT_CRITICAL();
+}
+
+PidController::Gains TemperatureControlService::getPidGains() const {
+    taskENTER_CRITICAL();
+    PidController::Gains gains = pendingGains;
+    taskEXIT_CRITICAL();
+    return gains;
 }
 
 void TemperatureControlService::stopHeating() {
+    // Applied by the next iteration; the SSR and door are only driven from the control task
+    taskENTER_CRITICAL();
     targetTemp = 0.0f;
-    setHeaterPower(0);
-    setCoolingPower(100); // Open vents for maximum cooling
+    targetRampRate = 0.0f;
+    stopPending = true;
+    taskEXIT_CRITICAL();
+    state.targetTemp = 0.0f;
 }
 
 float TemperatureControlService::getTemperature() const {
     return currentTemp;
 }
 
+uint8_t TemperatureControlService::getHeaterPower() const {
+    return controlLoop.getHeaterPower();
+}
+
 uint8_t TemperatureControlService::getCoolingPower() const {
-    return coolingPower;
+    return controlLoop.getCoolingPower();
 }
 
 TemperatureState TemperatureControlService::getState() const {
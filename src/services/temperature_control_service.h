@@ -5,6 +5,11 @@
 #include "task.h"
 #include "types/temperature_state.h"
 #include "types/temp_reading.h"
+#include "types/diagnostics.h"
+#include "library/seq_lock.h"
+#include "library/loop_tracer.h"
+#include "library/oven_control_loop.h"
+#include "library/ssr_driver.h"
 #include "constants.h"
 
 class TemperatureControlService {
@@ -12,7 +17,8 @@ public:
     static TemperatureControlService& getInstance();
 
     void init();
-    void setTargetTemperature(float temp);
+    // rampRate (°C/s) is the slope the setpoint is following; it drives the model feed-forward
+    void setTargetTemperature(float temp, float rampRate = 0.0f);
     void stopHeating();
 
     float getTemperature() const;
@@ -23,25 +29,48 @@ public:
     void setHeaterPower(uint8_t power);
     void setCoolingPower(uint8_t power);
 
+    // Bumpless PID retuning while the loop is running
+    void setPidGains(float kp, float ki, float kd);
+    PidController::Gains getPidGains() const;
+
     void setDoorPosition(uint8_t percent);
     bool isDoorFullyOpen() const;
     bool isDoorFullyClosed() const;
 
+    // Per-iteration timing of the control loop since boot (lateness, execution
+    // time, deadline misses); published after every iteration
+    LoopTrace getLoopTrace() const;
+    void setOverrunAction(ControlOverrunAction action);
+
 private:
     TemperatureControlService();
     static void controlTaskWrapper(void* pvParameters);
     void controlTask();
-    void updateHeaterControl();
-    void updateCoolingControl();
+    void updateControl();
+    void refreshCalibration();
     float applyCalibration(float rawTemp, size_t thermocoupleIndex);
+    static void onOverrun(const LoopTracer::Overrun& overrun, void* context);
+    static void applyHeaterPower(uint8_t percent, void* context);
+    static void applyDoorPosition(uint8_t percent, void* context);
 
     TemperatureState state;
+    SsrDriver heater;
+    OvenControlLoop controlLoop;
+    PidController::Gains pendingGains;
+    bool gainsPending;
+    bool stopPending;
+
+    uint32_t modelCalibrationTime;
 
     float targetTemp;
+    float targetRampRate;
     float currentTemp;
-    uint8_t heaterPower;
-    uint8_t coolingPower;
-    uint32_t lastCoolingChangeTime;
+
+    // Control task only, except the snapshot
+    LoopTracer loopTracer;
+    SeqLock<LoopTrace> loopTraceSnapshot;
+    volatile ControlOverrunAction overrunAction;
+    volatile bool halted;       // Latched by a HALT overrun; holds the heater off and the door open
 
     TaskHandle_t taskHandle;
 };
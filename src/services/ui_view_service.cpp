@@ -3,7 +3,6 @@
 #include "ui_view_service.h"
 #include "constants.h"
 #include "hardware/gpio.h"
-#include "hardware/spi.h"
 #include "hardware/pwm.h"
 #include "lvgl.h"
 
@@ -12,13 +11,18 @@ UIViewService& UIViewService::getInstance() {
     return instance;
 }
 
-UIViewService::UIViewService() : display(nullptr), uiTaskHandle(nullptr) {}
+UIViewService::UIViewService()
+    : display(nullptr),
+      uiTaskHandle(nullptr),
+      lcd(DISPLAY_PIO, DISPLAY_SPI_CLK_GPIO, DISPLAY_SPI_MOSI_GPIO, DISPLAY_SPI_DC_GPIO, DISPLAY_SPI_CS_GPIO) {}
 
 void UIViewService::init() {
     lv_init();                             // Initialize LVGL core system
-    initSPI();                             // Configure SPI GPIOs and start SPI peripheral
+    initDisplayBus();                      // Reset line and PIO write path
     initBacklight();                       // Setup PWM for backlight control
     initDisplay();                         // Initialize ST7789 display and bind to LVGL
+    renderer.init(display);                // Real-clock tick, render on demand
+    renderer.setHooks(beforeFrame, frameFlushed, this);
 
     rootView = std::make_unique<RootView>();
     rootView->init(display);
@@ -27,22 +31,13 @@ void UIViewService::init() {
     xTaskCreate(uiTask, "LVGL Update", 8192, this, tskIDLE_PRIORITY + 1, &uiTaskHandle);
 }
 
-void UIViewService::initSPI() {
-    spi_init(DISPLAY_SPI_PORT, DISPLAY_SPI_FREQ);
-    gpio_set_function(DISPLAY_SPI_CLK_GPIO, GPIO_FUNC_SPI);
-    gpio_set_function(DISPLAY_SPI_MOSI_GPIO, GPIO_FUNC_SPI);
-
-    gpio_init(DISPLAY_SPI_CS_GPIO);
-    gpio_set_dir(DISPLAY_SPI_CS_GPIO, GPIO_OUT);
-    gpio_put(DISPLAY_SPI_CS_GPIO, 1); // Deselect display
-
-    gpio_init(DISPLAY_SPI_DC_GPIO);
-    gpio_set_dir(DISPLAY_SPI_DC_GPIO, GPIO_OUT);
-    gpio_put(DISPLAY_SPI_DC_GPIO, 0); // Default to command mode
-
+void UIViewService::initDisplayBus() {
     gpio_init(DISPLAY_SPI_RST_GPIO);
     gpio_set_dir(DISPLAY_SPI_RST_GPIO, GPIO_OUT);
     gpio_put(DISPLAY_SPI_RST_GPIO, 1); // Display not in reset
+
+    // SCK, MOSI, DC and CS all belong to the PIO state machine; DMA completion arrives on DMA_IRQ_1
+    lcd.init(DISPLAY_PIO_FREQ);
 }
 
 void UIViewService::initBacklight() {
@@ -56,65 +51,57 @@ void UIViewService::initBacklight() {
 
 void UIViewService::initDisplay() {
     init_display(); // Send ST7789 command initialization sequence
+    flushDone = xSemaphoreCreateBinary();
 
-    static lv_color_t buf1[LV_HOR_RES_MAX * 20]; // Partial buffer
+    // Two partial buffers (RGB565): LVGL draws into one while DMA streams the other
+    static uint8_t buf1[DISPLAY_WIDTH * DISPLAY_BUFFER_LINES * 2];
+    static uint8_t buf2[DISPLAY_WIDTH * DISPLAY_BUFFER_LINES * 2];
     display = lv_display_create(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    lv_display_set_buffers(display, buf1, buf2, sizeof(buf1), LV_DISPLAY_RENDER_MODE_PARTIAL);
 
-    // Configure internal LVGL buffer with partial mode
-    lv_display_set_buffers(display, buf1, nullptr, sizeof(buf1), LV_DISPLAY_RENDER_MODE_PARTIAL);
-
-    // Set flush callback for pushing pixels to ST7789 over SPI
+    // Flush only starts the DMA chain; the DMA IRQ reports completion
     lv_display_set_flush_cb(display, [](lv_display_t* disp, const lv_area_t* area, uint8_t* color_p) {
-        printf("Flush callback\n");
-        UIViewService::getInstance().setAddressWindow(area->x1, area->y1, area->x2, area->y2);
-        UIViewService::getInstance().st7789_send_command(ST7789_RAMWR);
-        gpio_put(DISPLAY_SPI_DC_GPIO, 1);  // Data mode
-        gpio_put(DISPLAY_SPI_CS_GPIO, 0);
-        size_t len = lv_area_get_width(area) * lv_area_get_height(area) * 2; // RGB565
-        spi_write_blocking(DISPLAY_SPI_PORT, color_p, len);
-        gpio_put(DISPLAY_SPI_CS_GPIO, 1);
-        if (disp) {
-            lv_display_flush_ready(disp);
-        }
+        UIViewService::getInstance().startFlush(area, color_p);
     });
 
-
-    // lv_obj_t* scr = lv_scr_act();
-    
-    // // Create a title label
-    // lv_obj_t* title = lv_label_create(scr);
-    // lv_obj_set_style_text_font(title, &lv_font_montserrat_24, 0);
-    // lv_label_set_text(title, "REFLOW OVEN");
-    // lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
+    // LVGL calls this before reusing a buffer; block instead of spinning on the flushing flag
+    lv_display_set_flush_wait_cb(display, [](lv_display_t* disp) {
+        UIViewService::getInstance().waitForFlush();
+    });
 }
 
-void UIViewService::fillDisplay(uint16_t color) {
-    // Set full address window
-    setAddressWindow(0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
-    st7789_send_command(ST7789_RAMWR);
+void UIViewService::startFlush(const lv_area_t* area, const uint8_t* pixels) {
+    size_t len = lv_area_get_width(area) * lv_area_get_height(area) * 2; // RGB565
+    flushInProgress = true;
+    lcd.startWrite(area->x1, area->y1, area->x2, area->y2, pixels, len);
+}
 
-    // Convert 16-bit RGB565 color to two bytes
-    uint8_t color_high = (color >> 8) & 0xFF;
-    uint8_t color_low = color & 0xFF;
-    uint8_t color_bytes[2] = {color_high, color_low};
+void UIViewService::waitForFlush() {
+    while (flushInProgress) {
+        if (xSemaphoreTake(flushDone, pdMS_TO_TICKS(DISPLAY_FLUSH_TIMEOUT_MS)) != pdTRUE && flushInProgress) {
+            // Transfer never completed; drop it so the UI does not hang
+            printf("Display flush timed out\n");
+            lcd.abort();
+            flushInProgress = false;
+            lv_display_flush_ready(display);
+        }
+    }
+}
 
-    gpio_put(DISPLAY_SPI_DC_GPIO, 1);  // Data mode
-    gpio_put(DISPLAY_SPI_CS_GPIO, 0);  // Select display
+void UIViewService::displayDmaISR() {
+    if (!lcd.handleDmaIrq()) return;
 
-    for (int i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++) {
-        spi_write_blocking(DISPLAY_SPI_PORT, color_bytes, 2);
-    }
+    flushInProgress = false;
+    lv_display_flush_ready(display);
 
-    gpio_put(DISPLAY_SPI_CS_GPIO, 1);  // Deselect display
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(flushDone, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
 }
 
-void UIViewService::setAddressWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
-    uint8_t caset[4] = { (uint8_t)(x0 >> 8), (uint8_t)(x0 & 0xFF), (uint8_t)(x1 >> 8), (uint8_t)(x1 & 0xFF) };
-    uint8_t raset[4] = { (uint8_t)(y0 >> 8), (uint8_t)(y0 & 0xFF), (uint8_t)(y1 >> 8), (uint8_t)(y1 & 0xFF) };
-    st7789_send_command(ST7789_CASET);
-    st7789_send_data(caset, 4);
-    st7789_send_command(ST7789_RASET);
-    st7789_send_data(raset, 4);
+void UIViewService::fillDisplay(uint16_t color) {
+    waitForFlush();
+    lcd.fill(0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1, color);
 }
 
 void UIViewService::setBacklight(float brightness) {
@@ -126,53 +113,76 @@ void UIViewService::setBacklight(float brightness) {
 
 void UIViewService::uiTask(void* param) {
     UIViewService* service = static_cast<UIViewService*>(param);
-    TickType_t lastTick = xTaskGetTickCount();
-    
-    while (true) {
-        // Update LVGL tick - this is for animations 
-        lv_tick_inc(5);
-        
-        // Handle LVGL timers and drawing
-        lv_timer_handler();
-        
-        // We no longer need to call rootView->update() periodically
-        // Instead, controllers will call invalidateView() when they need to be redrawn
-        
-        // Delay until next update (just handle LVGL core functionality)
-        vTaskDelayUntil(&lastTick, pdMS_TO_TICKS(5));  // 5ms for smooth LVGL animations
-    }
+
+    // Sleeps until an LVGL timer is due or a render is requested; controllers
+    // call invalidateView() when they need to be redrawn
+    service->renderer.run();
+}
+
+RenderStats UIViewService::getRenderStats() const {
+    return renderer.getStats();
 }
 
-void UIViewService::handleEncoderUp() { 
-    printf("Encoder up in UIViewService\n");
-    if (rootView) rootView->scheduleEncoderUpHandler(5); 
+void UIViewService::setEncoderSource(InputPipeline::StepSource source, void* context) {
+    input.setStepSource(source, context);
 }
 
-void UIViewService::handleEncoderDown() { 
-    printf("Encoder down in UIViewService\n");
-    if (rootView) rootView->scheduleEncoderDownHandler(5);
+void UIViewService::postEncoderMovedFromISR() {
+    input.markPending(time_us_32());
+
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    renderer.requestRenderFromISR(&higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+void UIViewService::postEncoderPress() {
+    input.addPress(time_us_32());
+    renderer.requestRender();
 }
 
-void UIViewService::handleEncoderPress() { 
-    if (rootView) rootView->scheduleEncoderPressHandler(5); 
+void UIViewService::postEncoderLongPress() {
+    input.addLongPress(time_us_32());
+    renderer.requestRender();
 }
 
-void UIViewService::handleEncoderLongPress() { 
-    if (rootView) rootView->scheduleEncoderLongPressHandler(5); 
+InputLatencyStats UIViewService::getInputLatency() const {
+    return inputLatencySnapshot.read();
 }
 
-void UIViewService::st7789_send_command(uint8_t cmd) {
-    gpio_put(DISPLAY_SPI_DC_GPIO, 0); // Command mode
-    gpio_put(DISPLAY_SPI_CS_GPIO, 0);
-    spi_write_blocking(DISPLAY_SPI_PORT, &cmd, 1);
-    gpio_put(DISPLAY_SPI_CS_GPIO, 1);
+void UIViewService::beforeFrame(void* context) {
+    auto* service = static_cast<UIViewService*>(context);
+
+    InputBatch batch;
+    if (!service->input.drain(batch)) return;
+
+    if (service->rootView) service->rootView->dispatchInput(batch);
+
+    InputLatencyStats& latency = service->inputLatency;
+    latency.dispatch.record(time_us_32() - batch.firstEventUs);
+    latency.batches++;
+    uint32_t detents = static_cast<uint32_t>(batch.steps < 0 ? -batch.steps : batch.steps);
+    if (detents > 1) latency.coalescedSteps += detents - 1;
+    service->inputLatencySnapshot.write(latency);
+
+    // A sample stays pending until a frame is flushed; batches that arrive before
+    // then are measured from the oldest event still waiting to reach the screen
+    if (!service->awaitingInputFrame) {
+        service->awaitingInputFrame = true;
+        service->inputEventUs = batch.firstEventUs;
+    }
+}
+
+void UIViewService::frameFlushed(void* context) {
+    auto* service = static_cast<UIViewService*>(context);
+    if (!service->awaitingInputFrame) return;
+
+    service->inputLatency.flush.record(time_us_32() - service->inputEventUs);
+    service->inputLatencySnapshot.write(service->inputLatency);
+    service->awaitingInputFrame = false;
 }
 
-void UIViewService::st7789_send_data(const uint8_t* data, size_t len) {
-    gpio_put(DISPLAY_SPI_DC_GPIO, 1); // Data mode
-    gpio_put(DISPLAY_SPI_CS_GPIO, 0);
-    spi_write_blocking(DISPLAY_SPI_PORT, data, len);
-    gpio_put(DISPLAY_SPI_CS_GPIO, 1);
+void UIViewService::st7789_send_command(uint8_t cmd, const uint8_t* data, size_t len) {
+    lcd.writeCommand(cmd, data, len);
 }
 
 bool UIViewService::init_display() {
@@ -183,46 +193,54 @@ bool UIViewService::init_display() {
     st7789_send_command(ST7789_SLPOUT);  sleep_ms(500);
 
     // Memory data access control (orientation, RGB order)
-    st7789_send_command(ST7789_MADCTL);  uint8_t madctl = ST7789_ROTATION_WORKING_OLD; st7789_send_data(&madctl, 1);
+    uint8_t madctl = ST7789_ROTATION_WORKING_OLD;
+    st7789_send_command(ST7789_MADCTL, &madctl, 1);
 
     // Set 16-bit pixel format (RGB565)
-    st7789_send_command(ST7789_COLMOD);  uint8_t color_mode = 0x05; st7789_send_data(&color_mode, 1);
+    uint8_t color_mode = 0x05;
+    st7789_send_command(ST7789_COLMOD, &color_mode, 1);
 
     // Porch control settings
     uint8_t b2data[5] = {0x0C, 0x0C, 0x00, 0x33, 0x33};
-    st7789_send_command(ST7789_PORCTRL); st7789_send_data(b2data, 5);
+    st7789_send_command(ST7789_PORCTRL, b2data, 5);
 
     // Gate control
-    st7789_send_command(ST7789_GCTRL);   uint8_t gc = 0x35; st7789_send_data(&gc, 1);
+    uint8_t gc = 0x35;
+    st7789_send_command(ST7789_GCTRL, &gc, 1);
 
     // VCOM voltage setting
-    st7789_send_command(ST7789_VCOMS);   uint8_t vcom = 0x19; st7789_send_data(&vcom, 1);
+    uint8_t vcom = 0x19;
+    st7789_send_command(ST7789_VCOMS, &vcom, 1);
 
     // LCM control
-    st7789_send_command(ST7789_LCMCTRL); uint8_t lcm = 0x2C; st7789_send_data(&lcm, 1);
+    uint8_t lcm = 0x2C;
+    st7789_send_command(ST7789_LCMCTRL, &lcm, 1);
 
     // Enable VDV and VRH commands
-    st7789_send_command(ST7789_VDVVRHEN); uint8_t enable = 0x01; st7789_send_data(&enable, 1);
+    uint8_t enable = 0x01;
+    st7789_send_command(ST7789_VDVVRHEN, &enable, 1);
 
     // VRH and VDV settings
-    st7789_send_command(ST7789_VRHS);    uint8_t vrh = 0x12; st7789_send_data(&vrh, 1);
-    st7789_send_command(ST7789_VDVS);    uint8_t vdv = 0x20; st7789_send_data(&vdv, 1);
+    uint8_t vrh = 0x12;
+    st7789_send_command(ST7789_VRHS, &vrh, 1);
+    uint8_t vdv = 0x20;
+    st7789_send_command(ST7789_VDVS, &vdv, 1);
 
     // Frame rate control
-    st7789_send_command(ST7789_FRCTRL2); uint8_t fr = 0x0F; st7789_send_data(&fr, 1);
+    uint8_t fr = 0x0F;
+    st7789_send_command(ST7789_FRCTRL2, &fr, 1);
 
     // Power control
-    st7789_send_command(ST7789_PWCTRL1); uint8_t pwr[2] = {0xA4, 0xA1}; st7789_send_data(pwr, 2);
+    uint8_t pwr[2] = {0xA4, 0xA1};
+    st7789_send_command(ST7789_PWCTRL1, pwr, 2);
 
     // Positive gamma correction
-    st7789_send_command(ST7789_POS_GAM);
     uint8_t e0data[14] = {0xD0, 0x08, 0x11, 0x08, 0x0C, 0x15, 0x39, 0x33, 0x50, 0x36, 0x13, 0x14, 0x29, 0x2D};
-    st7789_send_data(e0data, 14);
+    st7789_send_command(ST7789_POS_GAM, e0data, 14);
 
     // Negative gamma correction
-    st7789_send_command(ST7789_NEG_GAM);
     uint8_t e1data[14] = {0xD0, 0x08, 0x10, 0x08, 0x06, 0x06, 0x39, 0x44, 0x51, 0x0B, 0x16, 0x14, 0x2F, 0x31};
-    st7789_send_data(e1data, 14);
+    st7789_send_command(ST7789_NEG_GAM, e1data, 14);
 
     // Turn on inversion, normal mode, and display
     st7789_send_command(ST7789_INVON);  sleep_ms(10);
@@ -239,6 +257,7 @@ void UIViewService::resetDisplay() {
 }
 
 void UIViewService::putDisplayToSleep() {
+    waitForFlush();
     st7789_send_command(ST7789_DISPOFF); sleep_ms(10);
     st7789_send_command(ST7789_SLPIN);   sleep_ms(120);
 }
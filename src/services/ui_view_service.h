@@ -3,8 +3,13 @@
 #include "lvgl.h"
 #include "FreeRTOS.h"
 #include "task.h"
+#include "semphr.h"
 #include <memory>
 #include "ui/root_view.h"
+#include "library/st7789_pio.h"
+#include "library/render_scheduler.h"
+#include "library/input_pipeline.h"
+#include "library/seq_lock.h"
 
 // System function commands
 #define ST7789_NOP      0x00  // No Operation
@@ -93,7 +98,7 @@ public:
     static UIViewService& getInstance();
 
     void init();
-    void initSPI();
+    void initDisplayBus();
     void initBacklight();
     bool init_display();
     void setBacklight(float brightness);
@@ -102,11 +107,22 @@ public:
     void wakeDisplayFromSleep();
     void fillDisplay(uint16_t color);
 
-    // Event forwarding
-    void handleEncoderUp();
-    void handleEncoderDown();
-    void handleEncoderPress();
-    void handleEncoderLongPress();
+    // Input producers. Events are coalesced and dispatched once per frame on the
+    // LVGL thread, so a fast spin never queues one callback per detent.
+    // The encoder keeps its own count: the ISR only flags movement, and 'source'
+    // is polled for the detents on the next frame
+    void setEncoderSource(InputPipeline::StepSource source, void* context);
+    void postEncoderMovedFromISR();
+    void postEncoderPress();
+    void postEncoderLongPress();
+
+    // Called from the shared DMA_IRQ_1 dispatcher when a flush transfer completes
+    void displayDmaISR();
+
+    // Frame time and UI-task idle share over the last stats window
+    RenderStats getRenderStats() const;
+    // Input-to-dispatch and input-to-flush latency histograms since boot
+    InputLatencyStats getInputLatency() const;
 
 private:
     UIViewService();
@@ -114,15 +130,30 @@ private:
 
     
     void initDisplay();
+    static void beforeFrame(void* context);
+    static void frameFlushed(void* context);
+    void startFlush(const lv_area_t* area, const uint8_t* pixels);
+    void waitForFlush();
     void resetDisplay();
-    void setAddressWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
 
-    void st7789_send_command(uint8_t cmd);
-    void st7789_send_data(const uint8_t* data, size_t len);
+    void st7789_send_command(uint8_t cmd, const uint8_t* data = nullptr, size_t len = 0);
 
     TaskHandle_t uiTaskHandle;
     lv_display_t* display;
     std::unique_ptr<RootView> rootView;
+    RenderScheduler renderer;
+
+    // Render-task only, except the pipeline itself
+    InputPipeline input;
+    bool awaitingInputFrame = false;
+    uint32_t inputEventUs = 0;
+    InputLatencyStats inputLatency = {};
+    SeqLock<InputLatencyStats> inputLatencySnapshot;
+
+    // PIO write path - LVGL renders into one buffer while the other is clocked out
+    St7789Pio lcd;
+    SemaphoreHandle_t flushDone = nullptr;
+    volatile bool flushInProgress = false;
 
     // PWM/backlight
     int slice_num;
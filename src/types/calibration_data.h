@@ -1,9 +1,14 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <array>
 
 struct ThermalCalibrationSummary {
+    static constexpr size_t NUM_TEMP_POINTS = 3;
+    static constexpr size_t NUM_POWER_LEVELS = 10;
+    static constexpr float TEMP_POINTS[NUM_TEMP_POINTS] = {25.0f, 100.0f, 200.0f};  // °C
+
     // Rates at different temperatures [temp_point][power_level]
     float heatingRates[3][10];     // 3 temperature points, 10 power levels (10% to 100%)
     float coolingRates[3][10];     // 3 temperature points, 10 fan levels (10% to 100%)
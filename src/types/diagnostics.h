@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include "constants.h"
+#include "library/loop_tracer.h"
+
+// What TemperatureControlService does when the control loop misses its deadline
+enum class ControlOverrunAction {
+    COUNT,         // Only record it in the trace (Diagnostics.control_overruns, diagnostics screen)
+    STOP_HEATING,  // Treat a stalled loop as a fault and cut the heater
+    HALT           // Latch heater off and door open, then panic(), for bring-up under a debugger
+};
+
+struct TaskDiagnostics {
+    char name[16];              // configMAX_TASK_NAME_LEN
+    uint16_t cpuPermille;       // Share of one core over the last window
+    uint8_t coreAffinity;       // Bit n set: may run on core n
+    uint8_t priority;
+    uint32_t stackHighWater;    // Fewest bytes of stack ever left free
+};
+
+// System-wide figures over the last DIAGNOSTICS_PERIOD_MS, published by DiagnosticsService
+struct DiagnosticsSnapshot {
+    uint32_t uptimeMs;
+    uint32_t sequence;                   // Bumped on every publish
+    uint16_t coreLoadPermille[2];        // 1000 - idle task share, per core
+    uint8_t taskCount;
+    bool tasksTruncated;                 // More tasks exist than DIAGNOSTICS_MAX_TASKS
+    TaskDiagnostics tasks[DIAGNOSTICS_MAX_TASKS];
+    uint32_t heapFreeBytes;
+    uint32_t heapMinFreeBytes;           // Low-water mark since boot
+    LoopTrace controlLoop;               // Temperature control loop since boot
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+enum class ReflowRunState : uint8_t {
+    IDLE,
+    RUNNING,
+    COMPLETE,
+    ABORTED
+};
+
+struct ReflowProgress {
+    ReflowRunState runState;
+    uint8_t stepIndex;
+    uint8_t stepCount;
+
+    uint32_t elapsedMs;
+    uint32_t totalMs;
+
+    float setpoint;           // °C the controller is tracking now
+    float rampRate;           // °C/s of the current segment
+    float lookaheadSetpoint;  // °C REFLOW_FEEDFORWARD_HORIZON_S from now
+    float lookaheadRate;      // Mean °C/s between now and the lookahead point
+};
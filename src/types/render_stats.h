@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include "library/latency_histogram.h"
+
+// Render loop figures over the last RENDER_STATS_WINDOW_MS, published by the UI task
+struct RenderStats {
+    uint32_t lastFrameUs;     // Refresh start to flush done of the most recent frame
+    uint32_t maxFrameUs;      // Slowest frame in the window
+    uint32_t averageFrameUs;  // Mean over the frames in the window, 0 if none
+    uint16_t frames;          // Frames rendered in the window
+    uint16_t wakeups;         // Times the UI task woke up in the window
+    float idlePercent;        // Share of the window the UI task spent asleep
+    uint32_t totalFrames;
+};
+
+// Input responsiveness since boot, measured from the input ISR / timer callback
+struct InputLatencyStats {
+    LatencyHistogram dispatch;  // Until the controller handled the batch on the LVGL thread
+    LatencyHistogram flush;     // Until the frame showing the result was flushed to the panel
+    uint32_t batches;           // Input batches dispatched
+    uint32_t coalescedSteps;    // Detents folded into an earlier batch instead of dispatched alone
+};
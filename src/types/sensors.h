@@ -1,13 +1,40 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
 
+enum class SensorError : uint8_t {
+    NONE,
+    THERMOCOUPLE_OPEN,        // MAX31855 OC bit
+    THERMOCOUPLE_SHORT_GND,   // MAX31855 SCG bit
+    THERMOCOUPLE_SHORT_VCC,   // MAX31855 SCV bit
+    THERMOCOUPLE_FAULT,       // Summary fault bit without a specific cause
+    THERMOCOUPLE_TIMEOUT      // No frame received within THERMOCOUPLE_TIMEOUT_MS
+};
+
+inline const char* sensorErrorToString(SensorError error) {
+    switch (error) {
+        case SensorError::NONE: return "None";
+        case SensorError::THERMOCOUPLE_OPEN: return "Thermocouple open circuit";
+        case SensorError::THERMOCOUPLE_SHORT_GND: return "Thermocouple shorted to GND";
+        case SensorError::THERMOCOUPLE_SHORT_VCC: return "Thermocouple shorted to VCC";
+        case SensorError::THERMOCOUPLE_FAULT: return "Thermocouple error";
+        case SensorError::THERMOCOUPLE_TIMEOUT: return "Thermocouple timeout";
+    }
+    return "Unknown";
+}
+
+// Published as a seqlock snapshot, so it must stay trivially copyable
 struct SensorState {
     float currentTemp = 0.0f;
+    uint32_t currentTempTimestamp = 0;  // ms since boot of the thermocouple sample
     float ambientTemp = 0.0f;
     float ambientHumidity = 0.0f;
     float ssrTemp = 0.0f;
     bool hasError = false;
-    std::string lastError;
-};
\ No newline at end of file
+    SensorError lastError = SensorError::NONE;
+};
+
+struct ThermocoupleFrame {
+    uint32_t raw = 0;          // MAX31855 32-bit frame, MSB first
+    uint32_t timestampUs = 0;  // time_us_32() when the transfer started
+};
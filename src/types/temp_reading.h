@@ -6,3 +6,21 @@ struct TempReading {
     float currentTemp; 
     uint32_t timestamp; // ms since boot
 };
+
+// Sliding windows maintained over the thermocouple history
+enum class TempWindow : uint8_t {
+    DERIVATIVE,  // Short window for the control loop's rate of change
+    RATE,        // Medium window for heating / cooling rate measurements
+    TREND,       // Long window for the UI chart
+    COUNT
+};
+
+struct TempWindowStats {
+    uint32_t count;    // Samples currently in the window
+    uint32_t spanMs;   // Newest minus oldest timestamp
+    float mean;
+    float variance;    // Sample variance (n - 1)
+    float min;
+    float max;
+    float slope;       // Least-squares rate of change in °C/s
+};
@@ -2,6 +2,7 @@
 #include "root_view.h"
 #include "lvgl.h"
 #include "controllers/main_menu_controller.h"
+#include "controllers/diagnostics_controller.h"
 // #include "controllers/calibration_controller.h"
 // #include "controllers/reflow_controller.h"
 
@@ -49,6 +50,7 @@ void RootView::init(lv_display_t* display) {
     
     // Register controllers
     controllerCollection->registerController("home", &MainMenuController::getInstance());
+    controllerCollection->registerController("diagnostics", &DiagnosticsController::getInstance());
     // controllerCollection->registerController("calibration", &CalibrationController::getInstance());
     // controllerCollection->registerController("reflow", &ReflowController::getInstance());
     // Add other controllers that may be missing
@@ -69,46 +71,10 @@ void RootView::update() {
     }
 }
 
-void RootView::scheduleEncoderDownHandler(uint32_t delayMs) {
-    lv_timer_create(encoderDownCallback, delayMs, this);
-}
-
-void RootView::encoderDownCallback(struct _lv_timer_t* timer) {
-    RootView* view = static_cast<RootView*>(lv_timer_get_user_data(timer));
-    if (view && view->controllerCollection) view->controllerCollection->handleEncoderDown();
-    lv_timer_del(timer);
-}
-
-void RootView::scheduleEncoderUpHandler(uint32_t delayMs) {
-    lv_timer_create(encoderUpCallback, delayMs, this);
-}
-
-void RootView::encoderUpCallback(struct _lv_timer_t* timer) {
-    RootView* view = static_cast<RootView*>(lv_timer_get_user_data(timer));
-    if (view && view->controllerCollection) view->controllerCollection->handleEncoderUp();
-    lv_timer_del(timer);
-}
-
-void RootView::scheduleEncoderPressHandler(uint32_t delayMs) {
-    lv_timer_create(encoderPressCallback, delayMs, this);
-}
+void RootView::dispatchInput(const InputBatch& batch) {
+    if (!controllerCollection) return;
 
-void RootView::encoderPressCallback(struct _lv_timer_t* timer) {
-    RootView* view = static_cast<RootView*>(lv_timer_get_user_data(timer));
-    if (view && view->controllerCollection) view->controllerCollection->handleEncoderPress();
-    lv_timer_del(timer);
+    if (batch.steps != 0) controllerCollection->handleEncoderTurn(batch.steps);
+    for (uint8_t i = 0; i < batch.presses; ++i) controllerCollection->handleEncoderPress();
+    for (uint8_t i = 0; i < batch.longPresses; ++i) controllerCollection->handleEncoderLongPress();
 }
-
-void RootView::scheduleEncoderLongPressHandler(uint32_t delayMs) {
-    lv_timer_create(encoderLongPressCallback, delayMs, this);
-}
-
-void RootView::encoderLongPressCallback(struct _lv_timer_t* timer) {
-    RootView* view = static_cast<RootView*>(lv_timer_get_user_data(timer));
-    if (view && view->controllerCollection) view->controllerCollection->handleEncoderLongPress();
-    lv_timer_del(timer);
-}
-
-
-
-
@@ -2,6 +2,7 @@
 
 #include "lvgl.h"
 #include "core/controller_collection.h"
+#include "library/input_pipeline.h"
 #include <memory>
 
 class RootView {
@@ -10,19 +11,9 @@ public:
     void init(lv_display_t* display);
     void update();
 
-    // Input handling
-    void scheduleEncoderUpHandler(uint32_t delayMs);
-    static void encoderUpCallback(struct _lv_timer_t* timer);
-    
-    void scheduleEncoderDownHandler(uint32_t delayMs);
-    static void encoderDownCallback(struct _lv_timer_t* timer);
-    
-    void scheduleEncoderPressHandler(uint32_t delayMs);  
-    static void encoderPressCallback(struct _lv_timer_t* timer);
-    
-    void scheduleEncoderLongPressHandler(uint32_t delayMs);
-    static void encoderLongPressCallback(struct _lv_timer_t* timer);
-    
+    // Input handling - one coalesced batch per frame, on the LVGL thread
+    void dispatchInput(const InputBatch& batch);
+
     void handleTopButtonPress();
     void handleTopButtonLongPress();
     void handleBottomButtonPress();